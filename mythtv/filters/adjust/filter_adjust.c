@@ -20,6 +20,7 @@
 #include "libavutil/mem.h"
 #include "libavcodec/dsputil.h"
 #include "libavcodec/x86/mmx.h"
+#include "libavutil/x86_cpu.h"
 
 static const mmx_t mm_cpool[] = {
     { w: {1, 1, 1, 1} },
@@ -39,6 +40,11 @@ typedef struct ThisFilter
     int yfilt;
     int cfilt;
 
+    /* adjustRegionMMX or, where the CPU has it, adjustRegionSSE2 */
+    void (*region)(uint8_t *, uint8_t *, const uint8_t *, const mmx_t *,
+                   const mmx_t *, const mmx_t *, const mmx_t *,
+                   const mmx_t *);
+
     mmx_t yscale;
     mmx_t yshift;
     mmx_t ymin;
@@ -136,56 +142,131 @@ static void adjustRegionMMX(uint8_t *buf, uint8_t *end, const uint8_t *table,
 }
 #endif /* HAVE_MMX */
 
-static int adjustFilter (VideoFilter *vf, VideoFrame *frame, int field)
+#if HAVE_MMX && HAVE_SSE
+/* Same arithmetic as adjustRegionMMX on 16 pixels at a time, the output
+ * is identical. */
+static void adjustRegionSSE2(uint8_t *buf, uint8_t *end, const uint8_t *table,
+                     const mmx_t *shift, const mmx_t *scale, const mmx_t *min,
+                     const mmx_t *clamp1, const mmx_t *clamp2)
 {
-    (void)field;
-    ThisFilter *filter = (ThisFilter *) vf;
-    TF_VARS;
+    /* shift, scale, min, one, clamp1, clamp2, each twice for a full xmm */
+    mmx_t k[12];
+    uint8_t *stop = buf + ((end - buf) & ~15);
+
+    k[0]  = k[1]  = *shift;
+    k[2]  = k[3]  = *scale;
+    k[4]  = k[5]  = *min;
+    k[6]  = k[7]  = mm_cpool[0];
+    k[8]  = k[9]  = *clamp1;
+    k[10] = k[11] = *clamp2;
+
+    if (buf < stop)
+    {
+        __asm__ volatile(
+            "movdqu    (%2), %%xmm3          \n\t"
+            "movdqu  16(%2), %%xmm4          \n\t"
+            "movdqu  32(%2), %%xmm5          \n\t"
+            "movdqu  48(%2), %%xmm6          \n\t"
+            "pxor    %%xmm2, %%xmm2          \n\t"
+            "1:                              \n\t"
+            "movdqu    (%0), %%xmm0          \n\t"
+            "psubusb %%xmm5, %%xmm0          \n\t"
+            "movdqa  %%xmm0, %%xmm1          \n\t"
+            "punpcklbw %%xmm2, %%xmm0        \n\t"
+            "punpckhbw %%xmm2, %%xmm1        \n\t"
+            "psllw   %%xmm3, %%xmm0          \n\t"
+            "psllw   %%xmm3, %%xmm1          \n\t"
+            "pmulhw  %%xmm4, %%xmm0          \n\t"
+            "pmulhw  %%xmm4, %%xmm1          \n\t"
+            "paddw   %%xmm6, %%xmm0          \n\t"
+            "paddw   %%xmm6, %%xmm1          \n\t"
+            "psrlw   $1, %%xmm0              \n\t"
+            "psrlw   $1, %%xmm1              \n\t"
+            "packuswb %%xmm1, %%xmm0         \n\t"
+            "movdqu  64(%2), %%xmm7          \n\t"
+            "paddusb %%xmm7, %%xmm0          \n\t"
+            "movdqu  80(%2), %%xmm7          \n\t"
+            "psubusb %%xmm7, %%xmm0          \n\t"
+            "movdqu  %%xmm0, (%0)            \n\t"
+            "add     $16, %0                 \n\t"
+            "cmp     %1, %0                  \n\t"
+            "jb      1b                      \n\t"
+            : "+r" (buf)
+            : "r" (stop), "r" (k)
+            : XMM_CLOBBERS("%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                           "%xmm4", "%xmm5", "%xmm6", "%xmm7",)
+              "memory", "cc"
+        );
+    }
 
-    TF_START;
+    while (buf < end)
     {
-        unsigned char *ybeg = frame->buf + frame->offsets[0];
-        unsigned char *yend = ybeg + (frame->pitches[0] * frame->height);
-        int cheight = (frame->codec == FMT_YV12) ?
-            (frame->height >> 1) : frame->height;
-        unsigned char *ubeg = frame->buf + frame->offsets[1];
-        unsigned char *uend = ubeg + (frame->pitches[1] * cheight);
-        unsigned char *vbeg = frame->buf + frame->offsets[2];
-        unsigned char *vend = ubeg + (frame->pitches[2] * cheight);
+        *buf = table[*buf];
+        buf++;
+    }
+}
+#endif /* HAVE_MMX && HAVE_SSE */
 
-#if HAVE_MMX
-        if (filter->yfilt)
-            adjustRegionMMX(ybeg, yend, filter->ytable,
-                            &(filter->yshift), &(filter->yscale),
-                            &(filter->ymin), mm_cpool + 1, mm_cpool + 2);
-        else
-            adjustRegion(ybeg, yend, filter->ytable);
-
-        if (filter->cfilt)
-        {
-            adjustRegionMMX(ubeg, uend, filter->ctable,
-                            &(filter->cshift), &(filter->cscale),
-                            &(filter->cmin), mm_cpool + 3, mm_cpool + 4);
-            adjustRegionMMX(vbeg, vend, filter->ctable,
-                            &(filter->cshift), &(filter->cscale),
-                            &(filter->cmin), mm_cpool + 3, mm_cpool + 4);
-        }
-        else
-        {
-            adjustRegion(ubeg, uend, filter->ctable);
-            adjustRegion(vbeg, vend, filter->ctable);
-        }
-
-        if (filter->yfilt || filter->cfilt)
-            emms();
+static int adjustBand (VideoFilter *vf, VideoFrame *frame, int field,
+                       int top, int bottom)
+{
+    (void)field;
+    ThisFilter *filter = (ThisFilter *) vf;
+    int ctop = (frame->codec == FMT_YV12) ? (top >> 1) : top;
+    int cbottom = (frame->codec == FMT_YV12) ? ((bottom + 1) >> 1) : bottom;
+
+    unsigned char *ybeg = frame->buf + frame->offsets[0] +
+        (frame->pitches[0] * top);
+    unsigned char *yend = ybeg + (frame->pitches[0] * (bottom - top));
+    unsigned char *ubeg = frame->buf + frame->offsets[1] +
+        (frame->pitches[1] * ctop);
+    unsigned char *uend = ubeg + (frame->pitches[1] * (cbottom - ctop));
+    unsigned char *vbeg = frame->buf + frame->offsets[2] +
+        (frame->pitches[2] * ctop);
+    unsigned char *vend = vbeg + (frame->pitches[2] * (cbottom - ctop));
 
-#else /* HAVE_MMX */
+#if HAVE_MMX
+    if (filter->yfilt)
+        filter->region(ybeg, yend, filter->ytable,
+                       &(filter->yshift), &(filter->yscale),
+                       &(filter->ymin), mm_cpool + 1, mm_cpool + 2);
+    else
         adjustRegion(ybeg, yend, filter->ytable);
+
+    if (filter->cfilt)
+    {
+        filter->region(ubeg, uend, filter->ctable,
+                       &(filter->cshift), &(filter->cscale),
+                       &(filter->cmin), mm_cpool + 3, mm_cpool + 4);
+        filter->region(vbeg, vend, filter->ctable,
+                       &(filter->cshift), &(filter->cscale),
+                       &(filter->cmin), mm_cpool + 3, mm_cpool + 4);
+    }
+    else
+    {
         adjustRegion(ubeg, uend, filter->ctable);
         adjustRegion(vbeg, vend, filter->ctable);
-#endif /* HAVE_MMX */
     }
-    TF_END(filter, "Adjust: ");
+
+    if (filter->yfilt || filter->cfilt)
+        emms();
+
+#else /* HAVE_MMX */
+    adjustRegion(ybeg, yend, filter->ytable);
+    adjustRegion(ubeg, uend, filter->ctable);
+    adjustRegion(vbeg, vend, filter->ctable);
+#endif /* HAVE_MMX */
+
+    return 0;
+}
+
+static int adjustFilter (VideoFilter *vf, VideoFrame *frame, int field)
+{
+    TF_VARS;
+
+    TF_START;
+    adjustBand(vf, frame, field, 0, frame->height);
+    TF_END((ThisFilter *)vf, "Adjust: ");
     return 0;
 }
 
@@ -290,6 +371,11 @@ newAdjustFilter (VideoFrameType inpixfmt, VideoFrameType outpixfmt,
     filter->cfilt = fillTableMMX (filter->ctable, &(filter->cshift),
                                     &(filter->cscale), &(filter->cmin),
                                     cmin, cmax, 16, 240, cgamma);
+    filter->region = &adjustRegionMMX;
+#if HAVE_SSE
+    if (av_get_cpu_flags() & FF_MM_SSE2)
+        filter->region = &adjustRegionSSE2;
+#endif
 #else
     fillTable (filter->ytable, ymin, ymax, 16, 235, ygamma);
     fillTable (filter->ctable, cmin, cmax, 16, 240, cgamma);
@@ -316,7 +402,8 @@ ConstFilterInfo filter_table[] =
         name:       "adjust",
         descript:   "adjust range and gamma of video",
         formats:    FmtList,
-        libname:    NULL
+        libname:    NULL,
+        filter_band: &adjustBand
     },
     FILT_NULL
 };
@@ -15,6 +15,39 @@ typedef struct ThisFilter
     TF_STRUCT;
 } ThisFilter;
 
+static void invertRegion(unsigned char *buf, unsigned char *end)
+{
+    while (buf < end)
+    {
+        *buf = 255 - (*buf);
+        buf++;
+    }
+}
+
+static int invertBand(VideoFilter *vf, VideoFrame *frame, int field,
+                      int top, int bottom)
+{
+    (void)vf;
+    (void)field;
+    int planes = (frame->codec == FMT_RGB24) ? 1 : 3;
+    int i;
+
+    for (i = 0; i < planes; i++)
+    {
+        int ptop = top, pbottom = bottom;
+        unsigned char *beg;
+        if (i > 0 && frame->codec == FMT_YV12)
+        {
+            ptop = top >> 1;
+            pbottom = (bottom + 1) >> 1;
+        }
+        beg = frame->buf + frame->offsets[i] + (frame->pitches[i] * ptop);
+        invertRegion(beg, beg + (frame->pitches[i] * (pbottom - ptop)));
+    }
+
+    return 0;
+}
+
 int invert(VideoFilter *vf, VideoFrame *frame, int field)
 {
     (void)field;
@@ -26,12 +59,7 @@ int invert(VideoFilter *vf, VideoFrame *frame, int field)
 
     TF_START;
 
-
-    while (size--)
-    {
-        *buf = 255 - (*buf);
-        buf++;
-    }
+    invertRegion(buf, buf + size);
 
     TF_END((ThisFilter *)vf, "Invert");
 
@@ -83,7 +111,8 @@ ConstFilterInfo filter_table[] =
         name:       "invert",
         descript:   "inverts the colors of the input video",
         formats:    FmtList,
-        libname:    NULL
+        libname:    NULL,
+        filter_band: &invertBand
     },
     FILT_NULL
 };
@@ -26,6 +26,7 @@
 
 #if HAVE_MMX
 #include "libavcodec/x86/mmx.h"
+#include "libavutil/x86_cpu.h"
 #define THRESHOLD 12
 static const mmx_t mm_lthr = { w:{ -THRESHOLD, -THRESHOLD,
                                    -THRESHOLD, -THRESHOLD} };
@@ -208,6 +209,101 @@ static void line_filter_mmx(uint8_t *dst, int width, int start_width,
 }
 #endif
 
+#if HAVE_MMX && HAVE_SSE
+static const uint8_t sse_thr[16] __attribute__ ((aligned (16))) =
+    { 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11 };
+
+/* mmx_start and mmx_end on 16 pixels in a single asm statement, so no
+ * xmm register has to survive between statements.  src3 is written to
+ * save before dst, the fast filters keep it as the next src1. */
+static inline void sse2_kernel(uint8_t *dst, uint8_t *save, uint8_t *src1,
+                               uint8_t *src2, uint8_t *src3, uint8_t *src4,
+                               uint8_t *src5, int X)
+{
+    __asm__ volatile(
+        "pxor      %%xmm7, %%xmm7        \n\t"
+        "movdqu    %3, %%xmm0            \n\t" // src2
+        "movdqu    %5, %%xmm1            \n\t" // src4
+        "movdqa    %%xmm0, %%xmm2        \n\t"
+        "movdqa    %%xmm1, %%xmm3        \n\t"
+        "punpcklbw %%xmm7, %%xmm0        \n\t"
+        "punpcklbw %%xmm7, %%xmm1        \n\t"
+        "punpckhbw %%xmm7, %%xmm2        \n\t"
+        "punpckhbw %%xmm7, %%xmm3        \n\t"
+        "paddw     %%xmm1, %%xmm0        \n\t"
+        "paddw     %%xmm3, %%xmm2        \n\t"
+        "psllw     $2, %%xmm0            \n\t"
+        "psllw     $2, %%xmm2            \n\t" // 4 * (src2 + src4)
+        "movdqu    %4, %%xmm4            \n\t" // src3
+        "movdqa    %%xmm4, %%xmm1        \n\t"
+        "movdqa    %%xmm4, %%xmm3        \n\t"
+        "punpcklbw %%xmm7, %%xmm1        \n\t"
+        "punpckhbw %%xmm7, %%xmm3        \n\t"
+        "psllw     $1, %%xmm1            \n\t"
+        "psllw     $1, %%xmm3            \n\t"
+        "paddw     %%xmm1, %%xmm0        \n\t"
+        "paddw     %%xmm3, %%xmm2        \n\t" // + 2 * src3
+        "movdqu    %2, %%xmm1            \n\t" // src1
+        "movdqa    %%xmm1, %%xmm3        \n\t"
+        "punpcklbw %%xmm7, %%xmm1        \n\t"
+        "punpckhbw %%xmm7, %%xmm3        \n\t"
+        "psubusw   %%xmm1, %%xmm0        \n\t"
+        "psubusw   %%xmm3, %%xmm2        \n\t" // - src1
+        "movdqu    %6, %%xmm1            \n\t" // src5
+        "movdqa    %%xmm1, %%xmm3        \n\t"
+        "punpcklbw %%xmm7, %%xmm1        \n\t"
+        "punpckhbw %%xmm7, %%xmm3        \n\t"
+        "psubusw   %%xmm1, %%xmm0        \n\t"
+        "psubusw   %%xmm3, %%xmm2        \n\t" // - src5
+        "psrlw     $3, %%xmm0            \n\t"
+        "psrlw     $3, %%xmm2            \n\t"
+        "packuswb  %%xmm2, %%xmm0        \n\t" // filtered
+        "movdqu    %3, %%xmm5            \n\t" // src2
+        "movdqa    %%xmm4, %%xmm6        \n\t"
+        "psubusb   %%xmm5, %%xmm6        \n\t"
+        "psubusb   %%xmm4, %%xmm5        \n\t"
+        "por       %%xmm6, %%xmm5        \n\t" // |src3 - src2|
+        "movdqa    %7, %%xmm6            \n\t"
+        "psubusb   %%xmm6, %%xmm5        \n\t"
+        "pcmpeqb   %%xmm7, %%xmm5        \n\t" // 0xff where it is <= 11
+        "movdqu    %%xmm4, %1            \n\t"
+        "pand      %%xmm5, %%xmm4        \n\t"
+        "pandn     %%xmm0, %%xmm5        \n\t"
+        "por       %%xmm5, %%xmm4        \n\t"
+        "movdqu    %%xmm4, %0            \n\t"
+        : "=m" (dst[X]), "=m" (save[0])
+        : "m" (src1[X]), "m" (src2[X]), "m" (src3[X]), "m" (src4[X]),
+          "m" (src5[X]), "m" (sse_thr[0])
+        : XMM_CLOBBERS("%xmm0", "%xmm1", "%xmm2", "%xmm3",
+                       "%xmm4", "%xmm5", "%xmm6", "%xmm7",)
+          "memory"
+    );
+}
+
+static void line_filter_sse2_fast(uint8_t *dst, int width, int start_width,
+                                  uint8_t *buf, uint8_t *src2, uint8_t *src3,
+                                  uint8_t *src4, uint8_t *src5)
+{
+    int X;
+    for (X = start_width; X < width - 15; X += 16)
+        sse2_kernel(dst, buf + X, buf, src2, src3, src4, src5, X);
+
+    line_filter_c_fast(dst, width, X, buf, src2, src3, src4, src5);
+}
+
+static void line_filter_sse2(uint8_t *dst, int width, int start_width,
+                             uint8_t *src1, uint8_t *src2, uint8_t *src3,
+                             uint8_t *src4, uint8_t *src5)
+{
+    uint8_t save[16];
+    int X;
+    for (X = start_width; X < width - 15; X += 16)
+        sse2_kernel(dst, save, src1, src2, src3, src4, src5, X);
+
+    line_filter_c(dst, width, X, src1, src2, src3, src4, src5);
+}
+#endif /* HAVE_MMX && HAVE_SSE */
+
 static void store_ref(struct ThisFilter *p, uint8_t *src, int src_offsets[3],
                       int src_stride[3], int width, int height)
 {
@@ -568,6 +664,13 @@ static VideoFilter *NewKernelDeintFilter(VideoFrameType inpixfmt,
         filter->line_filter = &line_filter_mmx;
         filter->line_filter_fast = &line_filter_mmx_fast;
     }
+#if HAVE_SSE
+    if (filter->mm_flags & FF_MM_SSE2)
+    {
+        filter->line_filter = &line_filter_sse2;
+        filter->line_filter_fast = &line_filter_sse2_fast;
+    }
+#endif
 #endif
 
     filter->skipchroma   = 0;
@@ -26,11 +26,13 @@ typedef struct LBFilter
     /* functions and variables below here considered "private" */
     int mm_flags;
     void (*subfilter)(unsigned char *, int);
+    void (*subfilter16)(unsigned char *, int); /* 16 columns, or NULL */
     TF_STRUCT;
 } LBFilter;
 
 void linearBlend(unsigned char *src, int stride);
 void linearBlendMMX(unsigned char *src, int stride);
+void linearBlendSSE2(unsigned char *src, int stride);
 void linearBlend3DNow(unsigned char *src, int stride);
 int linearBlendFilterAltivec(VideoFilter *f, VideoFrame *frame, int field);
 
@@ -87,6 +89,57 @@ void linearBlendMMX(unsigned char *src, int stride)
     );
 }
 
+#if HAVE_SSE
+/* linearBlendMMX on 16 columns at a time */
+void linearBlendSSE2(unsigned char *src, int stride)
+{
+//  src += 4 * stride;
+    __asm__ volatile(
+       "lea (%0, %1), %%"REG_a"                        \n\t"
+       "lea (%%"REG_a", %1, 4), %%"REG_d"              \n\t"
+
+       "movdqu (%0), %%xmm0                               \n\t" // L0
+       "movdqu (%%"REG_a", %1), %%xmm1                    \n\t" // L2
+       PAVGB(%%xmm1, %%xmm0)                                   // L0+L2
+       "movdqu (%%"REG_a"), %%xmm2                            \n\t" // L1
+       PAVGB(%%xmm2, %%xmm0)
+       "movdqu %%xmm0, (%0)                               \n\t"
+       "movdqu (%%"REG_a", %1, 2), %%xmm0                     \n\t" // L3
+       PAVGB(%%xmm0, %%xmm2)                                   // L1+L3
+       PAVGB(%%xmm1, %%xmm2)                                   // 2L2 + L1 + L3
+       "movdqu %%xmm2, (%%"REG_a")                            \n\t"
+       "movdqu (%0, %1, 4), %%xmm2                        \n\t" // L4
+       PAVGB(%%xmm2, %%xmm1)                                   // L2+L4
+       PAVGB(%%xmm0, %%xmm1)                                   // 2L3 + L2 + L4
+       "movdqu %%xmm1, (%%"REG_a", %1)                        \n\t"
+       "movdqu (%%"REG_d"), %%xmm1                            \n\t" // L5
+       PAVGB(%%xmm1, %%xmm0)                                   // L3+L5
+       PAVGB(%%xmm2, %%xmm0)                                   // 2L4 + L3 + L5
+       "movdqu %%xmm0, (%%"REG_a", %1, 2)                     \n\t"
+       "movdqu (%%"REG_d", %1), %%xmm0                        \n\t" // L6
+       PAVGB(%%xmm0, %%xmm2)                                   // L4+L6
+       PAVGB(%%xmm1, %%xmm2)                                   // 2L5 + L4 + L6
+       "movdqu %%xmm2, (%0, %1, 4)                        \n\t"
+       "movdqu (%%"REG_d", %1, 2), %%xmm2                     \n\t" // L7
+       PAVGB(%%xmm2, %%xmm1)                                   // L5+L7
+       PAVGB(%%xmm0, %%xmm1)                                   // 2L6 + L5 + L7
+       "movdqu %%xmm1, (%%"REG_d")                            \n\t"
+       "movdqu (%0, %1, 8), %%xmm1                        \n\t" // L8
+       PAVGB(%%xmm1, %%xmm0)                                   // L6+L8
+       PAVGB(%%xmm2, %%xmm0)                                   // 2L7 + L6 + L8
+       "movdqu %%xmm0, (%%"REG_d", %1)                        \n\t"
+       "movdqu (%%"REG_d", %1, 4), %%xmm0                     \n\t" // L9
+       PAVGB(%%xmm0, %%xmm2)                                   // L7+L9
+       PAVGB(%%xmm1, %%xmm2)                                   // 2L8 + L7 + L9
+       "movdqu %%xmm2, (%%"REG_d", %1, 2)                     \n\t"
+
+       : : "r" (src), "r" ((long)stride)
+       : XMM_CLOBBERS("%xmm0", "%xmm1", "%xmm2",) "%"REG_a, "%"REG_d
+    );
+}
+
+#endif
+
 void linearBlend3DNow(unsigned char *src, int stride)
 {
 //  src += 4 * stride;
@@ -280,6 +333,21 @@ void linearBlend(unsigned char *src, int stride)
     }
 }
 
+/* blends the 8 rows starting at row, 16 columns at a time where we can */
+static void linearBlendRows(LBFilter *vf, unsigned char *row, int stride)
+{
+    int x = 0;
+
+    if (vf->subfilter16)
+    {
+        for (; x + 16 <= stride; x += 16)
+            (vf->subfilter16)(row + x, stride);
+    }
+
+    for (; x < stride; x += 8)
+        (vf->subfilter)(row + x, stride);
+}
+
 static int linearBlendFilter(VideoFilter *f, VideoFrame *frame, int  field)
 {
     (void)field;
@@ -287,8 +355,7 @@ static int linearBlendFilter(VideoFilter *f, VideoFrame *frame, int  field)
     unsigned char *yptr = frame->buf + frame->offsets[0];
     int stride = frame->pitches[0];
     int ymax = height - 8;
-    int x,y;
-    unsigned char *src;
+    int y;
     unsigned char *uoff = frame->buf + frame->offsets[1];
     unsigned char *voff = frame->buf + frame->offsets[2];
     LBFilter *vf = (LBFilter *)f;
@@ -297,27 +364,15 @@ static int linearBlendFilter(VideoFilter *f, VideoFrame *frame, int  field)
     TF_START;
 
     for (y = 0; y < ymax; y+=8)
-    {  
-        for (x = 0; x < stride; x+=8)
-        {
-            src = yptr + x + y * stride;
-            (vf->subfilter)(src, stride);  
-        }
-    }
+        linearBlendRows(vf, yptr + y * stride, stride);
  
     stride = frame->pitches[1];
     ymax = height / 2 - 8;
   
     for (y = 0; y < ymax; y += 8)
     {
-        for (x = 0; x < stride; x += 8)
-        {
-            src = uoff + x + y * stride;
-            (vf->subfilter)(src, stride);
-       
-            src = voff + x + y * stride;
-            (vf->subfilter)(src, stride);
-        }
+        linearBlendRows(vf, uoff + y * stride, stride);
+        linearBlendRows(vf, voff + y * stride, stride);
     }
 
 #if HAVE_MMX
@@ -352,9 +407,16 @@ static VideoFilter *new_filter(VideoFrameType inpixfmt,
 
     filter->vf.filter = &linearBlendFilter;
     filter->subfilter = &linearBlend;    /* Default, non accellerated */
+    filter->subfilter16 = NULL;
     filter->mm_flags = av_get_cpu_flags();
     if (HAVE_MMX && filter->mm_flags & FF_MM_MMXEXT)
+    {
         filter->subfilter = &linearBlendMMX;
+#if HAVE_MMX && HAVE_SSE
+        if (filter->mm_flags & FF_MM_SSE2)
+            filter->subfilter16 = &linearBlendSSE2;
+#endif
+    }
     else if (HAVE_AMD3DNOW && filter->mm_flags & FF_MM_3DNOW)
         filter->subfilter = &linearBlend3DNow;
     else if (HAVE_ALTIVEC && filter->mm_flags & FF_MM_ALTIVEC)
@@ -15,6 +15,7 @@ using namespace std;
 // Qt headers
 #include <QRegExp>
 #include <QMap>
+#include <QSet>
 #include <QUrl>
 #include <QFile>
 #include <QFileInfo>
@@ -73,6 +74,27 @@ const QString ProgramInfo::kFromRecordedQuery =
     "LEFT JOIN record AS rec "
     "ON (r.recordid = rec.recordid) ";
 
+/// Strings shared by all ProgramInfo instances, see ShareStrings()
+static QMutex        shared_strings_lock;
+static QSet<QString> shared_strings;
+static const int     kMaxSharedStrings = 8192;
+
+/// \brief Returns a copy of str that shares its data with every other
+///        string of the same value returned by this function.
+static QString share_string(const QString &str)
+{
+    if (str.isEmpty())
+        return str;
+
+    QMutexLocker locker(&shared_strings_lock);
+    QSet<QString>::const_iterator it = shared_strings.find(str);
+    if (it != shared_strings.end())
+        return *it;
+    if (shared_strings.size() >= kMaxSharedStrings)
+        return str;
+    return *shared_strings.insert(str);
+}
+
 static void set_flag(uint32_t &flags, int flag_to_set, bool is_set)
 {
     flags &= ~flag_to_set;
@@ -373,6 +395,7 @@ ProgramInfo::ProgramInfo(
         originalAirDate = QDate();
 
     SetPathname(_pathname);
+    ShareStrings();
 }
 
 ProgramInfo::ProgramInfo(
@@ -478,6 +501,7 @@ ProgramInfo::ProgramInfo(
     inUseForWhat(),
     positionMapDBReplacement(NULL)
 {
+    ShareStrings();
 }
 
 ProgramInfo::ProgramInfo(
@@ -625,6 +649,8 @@ ProgramInfo::ProgramInfo(
             }
         }
     }
+
+    ShareStrings();
 }
 
 ProgramInfo::ProgramInfo(
@@ -724,6 +750,7 @@ ProgramInfo::ProgramInfo(
     inUseForWhat(),
     positionMapDBReplacement(NULL)
 {
+    ShareStrings();
 }
 
 ProgramInfo::ProgramInfo(const QString &_pathname) :
@@ -1306,9 +1333,34 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
         positionMapDBReplacement = NULL;
     }
 
+    ShareStrings();
+
     return true;
 }
 
+/** \fn ProgramInfo::ShareStrings(void)
+ *  \brief Makes the fields that only take a few distinct values share
+ *         their string data with other ProgramInfo instances.
+ *
+ *   Lists of recordings or guide data hold thousands of copies of the
+ *   same channel, group and host names. Each string loaded from the
+ *   database or the backend carries its own copy of that data, unless
+ *   it is shared here.
+ */
+void ProgramInfo::ShareStrings(void)
+{
+    category            = share_string(category);
+    chanstr             = share_string(chanstr);
+    chansign            = share_string(chansign);
+    channame            = share_string(channame);
+    chanplaybackfilters = share_string(chanplaybackfilters);
+    recgroup            = share_string(recgroup);
+    playgroup           = share_string(playgroup);
+    hostname            = share_string(hostname);
+    storagegroup        = share_string(storagegroup);
+    catType             = share_string(catType);
+}
+
 /** \brief Converts ProgramInfo into QString QHash containing each field
  *         in ProgramInfo converted into localized strings.
  */
@@ -616,6 +616,8 @@ class MPUBLIC ProgramInfo
     static int InitStatics(void);
 
   protected:
+    void ShareStrings(void);
+
     QString title;
     QString subtitle;
     QString description;
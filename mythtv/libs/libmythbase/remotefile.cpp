@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 using namespace std;
 
@@ -21,7 +23,14 @@ RemoteFile::RemoteFile(const QString &_path, bool write, bool useRA,
     lock(QMutex::NonRecursive),
     controlSock(NULL),    sock(NULL),
     query("QUERY_FILETRANSFER %1"),
-    writemode(write)
+    writemode(write),
+    pipelined(false),     window(kMinWindow),
+    windowlimit(kMaxWindow),
+    blocksize(kMinBlockSize),
+    readaheadpos(0),      unread(0),
+    shortblock(false),
+    statsbytes(0),        throughput(0),
+    rtt(0),               rttsamples(0)
 {
     if (writemode)
     {
@@ -195,6 +204,7 @@ void RemoteFile::Close(void)
     strlist << "DONE";
 
     lock.lock();
+    CancelPipeline(true);
     controlSock->writeStringList(strlist);
     if (!controlSock->readStringList(strlist, true))
     {
@@ -370,6 +380,14 @@ long long RemoteFile::Seek(long long pos, int whence, long long curpos)
     if (!controlSock->isOpen() || controlSock->error())
         return 0;
 
+    // Anything read ahead is from the old position
+    CancelPipeline(true);
+
+    // Seeks tend to come in bursts while skipping, so start over with a
+    // small window and let it grow back once reads follow the seek.
+    window      = kMinWindow;
+    windowlimit = kMinWindow;
+
     QStringList strlist( QString(query).arg(recordernum) );
     strlist << "SEEK";
     strlist << QString::number(pos);
@@ -496,6 +514,9 @@ int RemoteFile::Read(void *data, int size)
     if (!controlSock->isOpen() || controlSock->error())
         return -1;
 
+    if (pipelined || readaheadpos < readahead.size())
+        return ReadPipelined(data, size);
+
     if (sock->bytesAvailable() > 0)
     {
         LOG(VB_NETWORK, LOG_ERR,
@@ -583,6 +604,248 @@ int RemoteFile::Read(void *data, int size)
     return recv;
 }
 
+/** \fn RemoteFile::ReadPipelined(void*,int)
+ *  \brief Reads from the data collected by the pipelined REQUEST_BLOCKs,
+ *         keeping the window of outstanding requests full.
+ *
+ *  Once the backend has answered a request with less data than asked
+ *  for, no more requests are sent until everything already on its way
+ *  has been handed to the caller, so a short read still signals EOF.
+ *  Must be called with lock held.
+ */
+int RemoteFile::ReadPipelined(void *data, int size)
+{
+    int waitms = 10;
+    MythTimer mtimer;
+    mtimer.start();
+
+    while ((readahead.size() - readaheadpos < size) &&
+           mtimer.elapsed() < 10000)
+    {
+        if (pipelined && !shortblock)
+            RequestBlocks(max(size, (int)kMinBlockSize));
+
+        if (pending.empty() && unread <= 0)
+            break;
+
+        int before = readahead.size();
+
+        if (!ReadData(waitms))
+            return -1;
+
+        while (!pending.empty() && controlSock->bytesAvailable() > 0)
+        {
+            if (!ReadReply(MythSocket::kShortTimeout))
+                return -1;
+        }
+
+        if (readahead.size() > before)
+        {
+            mtimer.restart();
+            waitms = 10;
+        }
+        else if (waitms < 200)
+            waitms += 20;
+    }
+
+    int avail = readahead.size() - readaheadpos;
+    if (avail < size && !pending.empty())
+    {
+        LOG(VB_GENERAL, LOG_ERR, "RemoteFile::Read(): timed out waiting "
+            "for pipelined data");
+        return -1;
+    }
+
+    int len = min(size, avail);
+    memcpy(data, readahead.constData() + readaheadpos, len);
+    readaheadpos += len;
+    readposition += len;
+
+    if (readaheadpos >= readahead.size())
+    {
+        readahead.resize(0);
+        readaheadpos = 0;
+    }
+    else if (readaheadpos > readahead.size() / 2)
+    {
+        readahead.remove(0, readaheadpos);
+        readaheadpos = 0;
+    }
+
+    // Everything sent after the short block has been used up, so ask
+    // again next time in case the file has grown.
+    if (shortblock && pending.empty() && unread <= 0 &&
+        readaheadpos >= readahead.size())
+    {
+        shortblock = false;
+    }
+
+    LOG(VB_NETWORK, LOG_DEBUG,
+        QString("ReadPipelined(): reqd=%1, rcvd=%2, window=%3, pending=%4")
+            .arg(size).arg(len).arg(window).arg(pending.size()));
+
+    return len;
+}
+
+/** \fn RemoteFile::RequestBlocks(int)
+ *  \brief Sends REQUEST_BLOCKs of size bytes until window of them are
+ *         pending, or kMaxBytesInFlight bytes are on their way.
+ *
+ *  The byte limit bounds how much a Seek() or Close() has to drain
+ *  before the control socket can be used again.
+ */
+void RemoteFile::RequestBlocks(int size)
+{
+    blocksize = size;
+
+    long long inflight = max(unread, 0LL);
+    for (int i = 0; i < pending.size(); i++)
+        inflight += pending[i].size;
+
+    while (pending.size() < window &&
+           (pending.empty() || inflight + size <= kMaxBytesInFlight))
+    {
+        QStringList strlist( QString(query).arg(recordernum) );
+        strlist << "REQUEST_BLOCK";
+        strlist << QString::number(size);
+        if (!controlSock->writeStringList(strlist))
+            break;
+
+        PendingBlock block;
+        block.size = size;
+        block.sent.start();
+        pending.push_back(block);
+        inflight += size;
+    }
+}
+
+/// Reads the reply to the oldest pending REQUEST_BLOCK.
+bool RemoteFile::ReadReply(uint timeout_ms)
+{
+    QStringList strlist;
+    if (!controlSock->readStringList(strlist, timeout_ms) || strlist.empty())
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            "RemoteFile::Read(): No response from control socket.");
+        return false;
+    }
+
+    PendingBlock block = pending.takeFirst();
+    int count = strlist[0].toInt(); // -1 on backend error
+    if (count < 0)
+        return false;
+
+    unread += count;
+    if (count < block.size)
+        shortblock = true;
+
+    UpdateWindow(block.sent.elapsed());
+
+    return true;
+}
+
+/// Appends whatever arrives on the data socket within waitms to readahead.
+bool RemoteFile::ReadData(int waitms)
+{
+    if (sock->waitForMore(waitms) <= 0)
+        return true;
+
+    int avail = sock->bytesAvailable();
+    if (avail <= 0)
+        return true;
+
+    int oldsize = readahead.size();
+    readahead.resize(oldsize + avail);
+    int ret = sock->readBlock(readahead.data() + oldsize, avail);
+    readahead.resize(oldsize + max(ret, 0));
+
+    if (ret <= 0 && sock->error() != MythSocket::NoError)
+    {
+        LOG(VB_GENERAL, LOG_ERR, "RemoteFile::Read(): socket error");
+        return false;
+    }
+
+    unread -= max(ret, 0);
+
+    QMutexLocker locker(&statslock);
+    statsbytes += max(ret, 0);
+
+    return true;
+}
+
+/** \fn RemoteFile::UpdateWindow(int)
+ *  \brief Sizes the window to cover the bandwidth-delay product.
+ *
+ *  The round trip time is the quickest reply seen recently, since later
+ *  replies in a window also wait for the blocks ahead of them.  The
+ *  window keeps two requests more than the product needs, so it can
+ *  grow until the link rather than the window limits the throughput.
+ *  After a seek the window may only double with each reply.
+ */
+void RemoteFile::UpdateWindow(int replyms)
+{
+    QMutexLocker locker(&statslock);
+
+    if (!statstimer.isRunning())
+        statstimer.start();
+
+    int elapsed = statstimer.elapsed();
+    if (elapsed >= 1000)
+    {
+        throughput = (uint64_t)statsbytes * 8 * 1000 / elapsed;
+        statsbytes = 0;
+        statstimer.restart();
+    }
+
+    if (!rttsamples || replyms < rtt)
+        rtt = replyms;
+    rttsamples = (rttsamples + 1) % 64;
+
+    long long bdp = (long long)(throughput / 8) * max(rtt, 1) / 1000;
+    window = bdp / max(blocksize, 1) + kMinWindow;
+    window = max((int)kMinWindow, min(window, windowlimit));
+    windowlimit = min(windowlimit * 2, (int)kMaxWindow);
+}
+
+/** \fn RemoteFile::CancelPipeline(bool)
+ *  \brief Waits for the replies and data of all pending REQUEST_BLOCKs
+ *         so the control socket can be used for other commands.
+ *  \param discard Throw away the data read ahead, as after a seek.
+ *  Must be called with lock held.
+ */
+void RemoteFile::CancelPipeline(bool discard)
+{
+    while (!pending.empty())
+    {
+        if (!ReadReply(MythSocket::kLongTimeout))
+        {
+            pending.clear();
+            break;
+        }
+    }
+
+    MythTimer mtimer;
+    mtimer.start();
+    while (unread > 0 && mtimer.elapsed() < 10000)
+    {
+        if (!ReadData(50))
+            break;
+    }
+
+    if (unread > 0)
+        LOG(VB_GENERAL, LOG_ERR, QString("RemoteFile: %1 bytes of pipelined "
+                                         "data never arrived").arg(unread));
+
+    unread = 0;
+    shortblock = false;
+
+    if (discard)
+    {
+        readahead.clear();
+        readaheadpos = 0;
+    }
+}
+
 bool RemoteFile::SaveAs(QByteArray &data)
 {
     if (filesize < 0)
@@ -594,6 +857,45 @@ bool RemoteFile::SaveAs(QByteArray &data)
     return true;
 }
 
+/** \fn RemoteFile::SetPipelined(bool)
+ *  \brief Keeps several REQUEST_BLOCKs outstanding while reading, so
+ *         each block doesn't pay a full round trip to the backend.
+ *
+ *  The number of outstanding requests adapts to the measured throughput
+ *  and round trip time, see GetThroughput() and GetRoundTripTime().
+ */
+void RemoteFile::SetPipelined(bool enable)
+{
+    QMutexLocker locker(&lock);
+
+    if (writemode || pipelined == enable)
+        return;
+
+    // Data already read ahead is still returned by Read()
+    if (!enable && sock && controlSock)
+        CancelPipeline(false);
+
+    pipelined = enable;
+    window    = kMinWindow;
+
+    LOG(VB_FILE, LOG_INFO, QString("RemoteFile(%1): pipelined reads %2")
+            .arg(path).arg(enable ? "enabled" : "disabled"));
+}
+
+/// Returns the throughput of pipelined reads in bits per second.
+uint64_t RemoteFile::GetThroughput(void) const
+{
+    QMutexLocker locker(&statslock);
+    return throughput;
+}
+
+/// Returns the round trip time of pipelined reads in milliseconds.
+int RemoteFile::GetRoundTripTime(void) const
+{
+    QMutexLocker locker(&statslock);
+    return rtt;
+}
+
 void RemoteFile::SetTimeout(bool fast)
 {
     if (timeoutisfast == fast)
@@ -613,6 +915,9 @@ void RemoteFile::SetTimeout(bool fast)
     if (!controlSock->isOpen() || controlSock->error())
         return;
 
+    // The replies to the outstanding requests have to be read first
+    CancelPipeline(false);
+
     QStringList strlist( QString(query).arg(recordernum) );
     strlist << "SET_TIMEOUT";
     strlist << QString::number((int)fast);
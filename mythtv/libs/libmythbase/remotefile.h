@@ -3,11 +3,15 @@
 
 #include <sys/stat.h>
 
+#include <stdint.h>
+
 #include <QDateTime>
 #include <QStringList>
 #include <QMutex>
+#include <QList>
 
 #include "mythbaseexp.h"
+#include "mythtimer.h"
 
 class MythSocket;
 
@@ -40,6 +44,10 @@ class MBASE_PUBLIC RemoteFile
 
     void SetURL(const QString &url) { path = url; }
     void SetTimeout(bool fast);
+    void SetPipelined(bool enable);
+
+    uint64_t GetThroughput(void) const;
+    int      GetRoundTripTime(void) const;
 
     bool isOpen(void) const
         { return sock && controlSock; }
@@ -57,6 +65,26 @@ class MBASE_PUBLIC RemoteFile
   private:
     MythSocket     *openSocket(bool control);
 
+    int             ReadPipelined(void *data, int size);
+    void            RequestBlocks(int size);
+    bool            ReadReply(uint timeout_ms);
+    bool            ReadData(int waitms);
+    void            CancelPipeline(bool discard);
+    void            UpdateWindow(int replyms);
+
+    /// A REQUEST_BLOCK sent in pipelined mode whose reply hasn't arrived
+    class PendingBlock
+    {
+      public:
+        int       size;
+        MythTimer sent;
+    };
+
+    static const int kMinWindow    = 2;
+    static const int kMaxWindow    = 16;
+    static const int kMinBlockSize = 32 * 1024;
+    static const int kMaxBytesInFlight = 2 * 1024 * 1024;
+
     QString         path;
     bool            usereadahead;
     int             timeout_ms;
@@ -74,6 +102,28 @@ class MBASE_PUBLIC RemoteFile
 
     QStringList     possibleauxfiles;
     QStringList     auxfiles;
+
+    // Pipelined reads keep up to window REQUEST_BLOCKs outstanding and
+    // collect the data into readahead ahead of the caller.
+    bool                pipelined;
+    int                 window;
+    int                 windowlimit; ///< kMinWindow right after a seek
+    int                 blocksize;
+    QList<PendingBlock> pending;
+    QByteArray          readahead;
+    int                 readaheadpos;
+    /// bytes the backend replied it sent less bytes read from sock,
+    /// negative while data arrives ahead of its reply
+    long long           unread;
+    bool                shortblock;  ///< backend had less than requested
+
+    // Transfer statistics for the pipeline window, protected by statslock
+    mutable QMutex      statslock;
+    MythTimer           statstimer;
+    long long           statsbytes;
+    uint64_t            throughput;  ///< bits per second
+    int                 rtt;         ///< smallest recent reply time in ms
+    int                 rttsamples;
 };
 
 #endif
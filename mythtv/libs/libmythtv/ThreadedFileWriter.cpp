@@ -3,6 +3,9 @@
 #include <cstdlib>
 #include <cerrno>
 
+// C++ headers
+#include <algorithm>
+
 // Unix C headers
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -45,6 +48,9 @@ void TFWSyncThread::run(void)
 const uint ThreadedFileWriter::kMaxBufferSize = 128 * 1024 * 1024;
 const uint ThreadedFileWriter::kMinWriteSize = 64 * 1024;
 
+QMutex                     ThreadedFileWriter::writersLock;
+QList<ThreadedFileWriter*> ThreadedFileWriter::writers;
+
 /** \class ThreadedFileWriter
  *  \brief This class supports the writing of recordings to disk.
  *
@@ -68,6 +74,7 @@ ThreadedFileWriter::ThreadedFileWriter(const QString &fname,
     // file stuff
     filename(fname),                     flags(pflags),
     mode(pmode),                         fd(-1),
+    device(0),                           writeLatency(0),
     // state
     flush(false),                        in_dtor(false),
     ignore_writes(false),                tfw_min_write_size(kMinWriteSize),
@@ -107,6 +114,14 @@ bool ThreadedFileWriter::Open(void)
 #ifdef USING_MINGW
         _setmode(fd, _O_BINARY);
 #endif
+        struct stat st;
+        if (fstat(fd, &st) == 0)
+            device = st.st_dev;
+
+        writersLock.lock();
+        writers.push_back(this);
+        writersLock.unlock();
+
         writeThread = new TFWWriteThread(this);
         writeThread->start();
         syncThread = new TFWSyncThread(this);
@@ -121,6 +136,10 @@ bool ThreadedFileWriter::Open(void)
  */
 ThreadedFileWriter::~ThreadedFileWriter()
 {
+    writersLock.lock();
+    writers.removeAll(this);
+    writersLock.unlock();
+
     Flush();
 
     {  /* tell child threads to exit */
@@ -212,6 +231,10 @@ uint ThreadedFileWriter::Write(const void *data, uint count)
         {
             buf = new TFWBuffer();
         }
+
+        // Small writes are gathered into this buffer until it holds
+        // kMinWriteSize bytes, don't let it reallocate on the way there.
+        buf->data.reserve(max(count, kMinWriteSize));
     }
 
     totalBufferUse += count;
@@ -223,8 +246,13 @@ uint ThreadedFileWriter::Write(const void *data, uint count)
 
     bufferHasData.wakeAll();
 
-    LOG(VB_FILE, LOG_DEBUG, QString("Write(*, %1) total %2 cnt %3")
-            .arg(count,4).arg(totalBufferUse).arg(writeBuffers.size()));
+    // This is called for every TS packet, only format the message
+    // when it will be logged.
+    if (VERBOSE_LEVEL_CHECK(VB_FILE) && logLevel <= LOG_DEBUG)
+    {
+        LOG(VB_FILE, LOG_DEBUG, QString("Write(*, %1) total %2 cnt %3")
+                .arg(count,4).arg(totalBufferUse).arg(writeBuffers.size()));
+    }
 
     return count;
 }
@@ -313,6 +341,38 @@ void ThreadedFileWriter::Sync(void)
     }
 }
 
+/** \fn ThreadedFileWriter::GetWriteLatency(dev_t, uint*)
+ *  \brief Returns the worst average write() latency in milliseconds of
+ *         the open writers on a device, or -1 if there are none.
+ *
+ *  This lets background I/O such as slow deletes back off when it
+ *  starts to hurt recordings on the same disk.
+ *
+ *  \param device      device as reported by stat() in st_dev
+ *  \param writerCount if not NULL, set to the number of open writers
+ */
+int ThreadedFileWriter::GetWriteLatency(dev_t device, uint *writerCount)
+{
+    QMutexLocker locker(&writersLock);
+
+    int latency = -1;
+    uint count = 0;
+
+    QList<ThreadedFileWriter*>::const_iterator it = writers.begin();
+    for (; it != writers.end(); ++it)
+    {
+        if ((*it)->device != device)
+            continue;
+        latency = max(latency, (*it)->writeLatency);
+        count++;
+    }
+
+    if (writerCount)
+        *writerCount = count;
+
+    return latency;
+}
+
 /** \fn ThreadedFileWriter::SetWriteBufferMinWriteSize(uint)
  *  \brief Sets the minumum number of bytes to write to disk in a single write.
  *         This is ignored during a Flush(void)
@@ -411,11 +471,16 @@ void ThreadedFileWriter::DiskLoop(void)
         MythTimer writeTimer;
         writeTimer.start();
 
+        MythTimer latencyTimer;
+        int latency = 0;
+
         while ((tot < sz) && !in_dtor)
         {
             locker.unlock();
 
+            latencyTimer.start();
             int ret = write(fd, (char *)data + tot, sz - tot);
+            latency += latencyTimer.elapsed();
 
             if (ret < 0)
             {
@@ -453,6 +518,10 @@ void ThreadedFileWriter::DiskLoop(void)
         buf->lastUsed = QDateTime::currentDateTime();
         emptyBuffers.push_back(buf);
 
+        writersLock.lock();
+        writeLatency = (writeLatency * 7 + latency) / 8;
+        writersLock.unlock();
+
         if (writeTimer.elapsed() > 1000)
         {
             LOG(VB_GENERAL, LOG_WARNING,
@@ -10,10 +10,14 @@ using namespace std;
 #include <QString>
 #include <QMutex>
 #include <QThread>
+#include <QList>
 
+#include <sys/types.h>
 #include <fcntl.h>
 #include <stdint.h>
 
+#include "mythtvexp.h"
+
 class ThreadedFileWriter;
 
 class TFWWriteThread : public QThread
@@ -38,7 +42,7 @@ class TFWSyncThread : public QThread
     ThreadedFileWriter *m_parent;
 };
 
-class ThreadedFileWriter
+class MTV_PUBLIC ThreadedFileWriter
 {
     friend class TFWWriteThread;
     friend class TFWSyncThread;
@@ -56,6 +60,8 @@ class ThreadedFileWriter
     void Sync(void);
     void Flush(void);
 
+    static int GetWriteLatency(dev_t device, uint *writerCount = NULL);
+
   protected:
     void DiskLoop(void);
     void SyncLoop(void);
@@ -67,6 +73,8 @@ class ThreadedFileWriter
     int             flags;
     mode_t          mode;
     int             fd;
+    dev_t           device;
+    int             writeLatency;       // protected by writersLock
 
     // state
     bool            flush;              // protected by buflock
@@ -95,6 +103,10 @@ class ThreadedFileWriter
     QWaitCondition  bufferHasData;
     QWaitCondition  bufferSyncWait;
 
+    // open writers, used to report write latency per device
+    static QMutex                     writersLock;
+    static QList<ThreadedFileWriter*> writers;
+
     // constants
     static const uint kMaxBufferSize;
     /// Minimum to write to disk in a single write, when not flushing buffer.
@@ -26,12 +26,9 @@
 #include "mythlogging.h"
 #include "mpegtables.h"
 #include "ringbuffer.h"
+#include "startcode.h"
 #include "tv_rec.h"
 
-extern "C" {
-extern const uint8_t *ff_find_start_code(const uint8_t *p, const uint8_t *end, uint32_t *state);
-}
-
 #define LOC      QString("DTVRec(%1): ").arg(tvrec->GetCaptureCardNum())
 #define LOC_WARN QString("DTVRec(%1) Warning: ").arg(tvrec->GetCaptureCardNum())
 #define LOC_ERR  QString("DTVRec(%1) Error: ").arg(tvrec->GetCaptureCardNum())
@@ -77,7 +74,8 @@ DTVRecorder::DTVRecorder(TVRec *rec) :
     // statistics
     _packet_count(0),
     _continuity_error_count(0),
-    _frames_seen_count(0),          _frames_written_count(0)
+    _frames_seen_count(0),          _frames_written_count(0),
+    _payload_bytes_copied(0)
 {
     SetPositionMapType(MARK_GOP_BYFRAME);
     _payload_buffer.reserve(TSPacket::kSize * (50 + 1));
@@ -152,6 +150,17 @@ void DTVRecorder::FinishRecording(void)
         ringBuffer->WriterFlush();
     }
 
+    if (ringBuffer && ringBuffer->GetWritePosition() > 0)
+    {
+        // The writer copies every byte once more on its way to disk
+        LOG(VB_RECORD, LOG_INFO, LOC +
+            QString("Copied %1 bytes through the keyframe buffer, "
+                    "%2 copies per recorded byte")
+                .arg(_payload_bytes_copied)
+                .arg(1.0 + (double)_payload_bytes_copied /
+                     ringBuffer->GetWritePosition(), 0, 'f', 2));
+    }
+
     if (curRecording)
     {
         if (ringBuffer)
@@ -202,6 +211,7 @@ void DTVRecorder::ResetForNewFile(void)
     positionMap.clear();
     positionMapDelta.clear();
     _payload_buffer.clear();
+    _payload_bytes_copied       = 0;
 }
 
 // documented in recorderbase.h
@@ -257,9 +267,9 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket)
     // Do we have to buffer the packet for exact keyframe detection?
     if (_buffer_packets)
     {
-        int idx = _payload_buffer.size();
-        _payload_buffer.resize(idx + TSPacket::kSize);
-        memcpy(&_payload_buffer[idx], tspacket.data(), TSPacket::kSize);
+        _payload_buffer.insert(_payload_buffer.end(), tspacket.data(),
+                               tspacket.data() + TSPacket::kSize);
+        _payload_bytes_copied += TSPacket::kSize;
         return;
     }
 
@@ -343,7 +353,7 @@ bool DTVRecorder::FindMPEG2Keyframes(const TSPacket* tspacket)
 
     while (bufptr < bufend)
     {
-        bufptr = ff_find_start_code(bufptr, bufend, &_start_code);
+        bufptr = find_start_code(bufptr, bufend, &_start_code);
         if ((_start_code & 0xffffff00) == 0x00000100)
         {
             // At this point we have seen the start code 0 0 1
@@ -754,7 +764,7 @@ void DTVRecorder::FindPSKeyFrames(const uint8_t *buffer, uint len)
         bool hasKeyFrame  = false;
 
         const uint8_t *tmp = bufptr;
-        bufptr = ff_find_start_code(bufptr + skip, bufend, &_start_code);
+        bufptr = find_start_code(bufptr + skip, bufend, &_start_code);
         _audio_bytes_remaining = 0;
         _other_bytes_remaining = 0;
         _video_bytes_remaining -= std::min(
@@ -910,13 +920,8 @@ void DTVRecorder::FindPSKeyFrames(const uint8_t *buffer, uint len)
             (uint)bytes_skipped, _other_bytes_remaining);
     }
 
-    uint64_t idx = _payload_buffer.size();
-    uint64_t rem = (bufend - bufstart);
-    _payload_buffer.resize(idx + rem);
-    memcpy(&_payload_buffer[idx], bufstart, rem);
-#if 0
-    LOG(VB_GENERAL, LOG_DEBUG, QString("idx: %1, rem: %2").arg(idx).arg(rem));
-#endif
+    _payload_buffer.insert(_payload_buffer.end(), bufstart, bufend);
+    _payload_bytes_copied += bufend - bufstart;
 }
 
 void DTVRecorder::HandlePAT(const ProgramAssociationTable *_pat)
@@ -169,6 +169,8 @@ class DTVRecorder :
     mutable unsigned long long _continuity_error_count;
     unsigned long long _frames_seen_count;
     unsigned long long _frames_written_count;
+    /// Bytes copied into _payload_buffer before being written
+    unsigned long long _payload_bytes_copied;
 
     // constants
     /// If the number of regular frames detected since the last
@@ -5,6 +5,9 @@
  * License: GPL v2
  */
 
+#include <algorithm>
+using namespace std;
+
 #include <QDateTime>
 
 #include "eitcache.h"
@@ -17,9 +20,102 @@
 // Highest version number. version is 5bits
 const uint EITCache::kVersionMax = 31;
 
+const uint64_t EITCacheTable::kEmptyKey = ~(uint64_t)0;
+
+/// Maximum fill ratio of EITCacheTable in percent before it is grown
+#define MAX_LOAD 70
+
+uint EITCacheTable::Slot(uint64_t key) const
+{
+    // Fibonacci hashing, capacity is always a power of two
+    uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+    return (uint) (h >> 32) & (keys.size() - 1);
+}
+
+uint64_t *EITCacheTable::Find(uint64_t key)
+{
+    if (keys.isEmpty())
+        return NULL;
+
+    uint mask = keys.size() - 1;
+    for (uint i = Slot(key); ; i = (i + 1) & mask)
+    {
+        if (keys[i] == key)
+            return &sigs[i];
+        if (keys[i] == kEmptyKey)
+            return NULL;
+    }
+}
+
+void EITCacheTable::Insert(uint64_t key, uint64_t sig)
+{
+    if ((used + 1) * 100 > (uint) keys.size() * MAX_LOAD)
+        Rehash(keys.isEmpty() ? 1024 : keys.size() * 2);
+
+    uint mask = keys.size() - 1;
+    uint i    = Slot(key);
+    while (keys[i] != kEmptyKey && keys[i] != key)
+        i = (i + 1) & mask;
+
+    if (keys[i] == kEmptyKey)
+        used++;
+
+    keys[i] = key;
+    sigs[i] = sig;
+}
+
+void EITCacheTable::Reserve(uint count)
+{
+    uint capacity = keys.isEmpty() ? 1024 : keys.size();
+    while (count * 100 > capacity * MAX_LOAD)
+        capacity *= 2;
+
+    if (capacity != (uint) keys.size())
+        Rehash(capacity);
+}
+
+/** \brief Removes all entries for events ending before endtime.
+ *  \return number of entries removed
+ */
+uint EITCacheTable::Prune(uint endtime)
+{
+    QVector<uint64_t> oldkeys = keys;
+    QVector<uint64_t> oldsigs = sigs;
+    uint              oldused = used;
+
+    keys.fill(kEmptyKey);
+    used = 0;
+
+    for (int i = 0; i < oldkeys.size(); i++)
+    {
+        if (oldkeys[i] != kEmptyKey &&
+            (uint) (oldsigs[i] & 0xffffffff) >= endtime)
+        {
+            Insert(oldkeys[i], oldsigs[i]);
+        }
+    }
+
+    return oldused - used;
+}
+
+void EITCacheTable::Rehash(uint capacity)
+{
+    QVector<uint64_t> oldkeys = keys;
+    QVector<uint64_t> oldsigs = sigs;
+
+    keys = QVector<uint64_t>(capacity, kEmptyKey);
+    sigs = QVector<uint64_t>(capacity, 0);
+    used = 0;
+
+    for (int i = 0; i < oldkeys.size(); i++)
+    {
+        if (oldkeys[i] != kEmptyKey)
+            Insert(oldkeys[i], oldsigs[i]);
+    }
+}
+
 EITCache::EITCache()
-    : accessCnt(0), hitCnt(0),   tblChgCnt(0),   verChgCnt(0),
-      entryCnt(0), pruneCnt(0), prunedHitCnt(0), wrongChannelHitCnt(0)
+    : accessCnt(0), prunedHitCnt(0)
 {
     // 24 hours ago
     lastPruneTime = QDateTime::currentDateTime().toUTC().toTime_t() - 86400;
@@ -32,28 +128,51 @@ EITCache::~EITCache()
 
 void EITCache::ResetStatistics(void)
 {
-    accessCnt = 0;
-    hitCnt    = 0;
-    tblChgCnt = 0;
-    verChgCnt = 0;
-    entryCnt  = 0;
-    pruneCnt  = 0;
+    accessCnt    = 0;
     prunedHitCnt = 0;
-    wrongChannelHitCnt = 0;
+
+    for (uint i = 0; i < kStripes; i++)
+    {
+        QMutexLocker locker(&stripes[i].lock);
+        stripes[i].hitCnt    = 0;
+        stripes[i].tblChgCnt = 0;
+        stripes[i].verChgCnt = 0;
+        stripes[i].entryCnt  = 0;
+        stripes[i].pruneCnt  = 0;
+        stripes[i].wrongChannelHitCnt = 0;
+    }
 }
 
 QString EITCache::GetStatistics(void) const
 {
-    QMutexLocker locker(&eventMapLock);
+    uint hitCnt = 0, tblChgCnt = 0, verChgCnt = 0, entryCnt = 0;
+    uint pruneCnt = 0, wrongChannelHitCnt = 0, cached = 0;
+
+    for (uint i = 0; i < kStripes; i++)
+    {
+        QMutexLocker locker(&stripes[i].lock);
+        hitCnt             += stripes[i].hitCnt;
+        tblChgCnt          += stripes[i].tblChgCnt;
+        verChgCnt          += stripes[i].verChgCnt;
+        entryCnt           += stripes[i].entryCnt;
+        pruneCnt           += stripes[i].pruneCnt;
+        wrongChannelHitCnt += stripes[i].wrongChannelHitCnt;
+        cached             += stripes[i].events.Size();
+    }
+
+    uint accesses = accessCnt;
+    uint prunedHits = prunedHitCnt;
+
     return QString(
         "EITCache::statistics: Accesses: %1, Hits: %2, "
         "Table Upgrades %3, New Versions: %4, Entries: %5 "
         "Pruned entries: %6, pruned Hits: %7 Discard channel Hit %8 "
-        "Hit Ratio %9.")
-        .arg(accessCnt).arg(hitCnt).arg(tblChgCnt).arg(verChgCnt)
-        .arg(entryCnt).arg(pruneCnt).arg(prunedHitCnt)
+        "Hit Ratio %9, Cached: %10.")
+        .arg(accesses).arg(hitCnt).arg(tblChgCnt).arg(verChgCnt)
+        .arg(entryCnt).arg(pruneCnt).arg(prunedHits)
         .arg(wrongChannelHitCnt)
-        .arg((hitCnt+prunedHitCnt+wrongChannelHitCnt)/(double)accessCnt);
+        .arg((hitCnt+prunedHits+wrongChannelHitCnt)/(double)accesses)
+        .arg(cached);
 }
 
 static inline uint64_t construct_sig(uint tableid, uint version,
@@ -83,27 +202,62 @@ static inline bool modified(uint64_t sig)
     return sig >> 63;
 }
 
-static void replace_in_db(int chanid, uint eventid, uint64_t sig)
+static inline uint64_t construct_key(uint chanid, uint eventid)
 {
+    return ((uint64_t) chanid << 32) | eventid;
+}
 
+static inline uint extract_chanid(uint64_t key)
+{
+    return key >> 32;
+}
+
+static inline uint extract_eventid(uint64_t key)
+{
+    return key & 0xffffffff;
+}
+
+/// Rows written per INSERT statement by write_to_db()
+#define BULK_ROWS 1000
+
+/** \brief Writes (key, sig) pairs to the database using multi-row
+ *         INSERT ... ON DUPLICATE KEY UPDATE statements.
+ *
+ *  All values are integers, so they are formatted into the statement
+ *  rather than bound.
+ */
+static void write_to_db(const QVector<uint64_t> &keys,
+                        const QVector<uint64_t> &sigs)
+{
     MSqlQuery query(MSqlQuery::InitCon());
 
-    QString qstr =
-        "REPLACE INTO eit_cache "
-        "       ( chanid,  eventid,  tableid,  version,  endtime) "
-        "VALUES (:CHANID, :EVENTID, :TABLEID, :VERSION, :ENDTIME)";
+    for (int start = 0; start < keys.size(); start += BULK_ROWS)
+    {
+        int end = min(keys.size(), start + BULK_ROWS);
 
-    query.prepare(qstr);
-    query.bindValue(":CHANID",   chanid);
-    query.bindValue(":EVENTID",  eventid);
-    query.bindValue(":TABLEID",  extract_table_id(sig));
-    query.bindValue(":VERSION",  extract_version(sig));
-    query.bindValue(":ENDTIME",  extract_endtime(sig));
+        QString qstr =
+            "INSERT INTO eit_cache "
+            "       (chanid, eventid, tableid, version, endtime, status) "
+            "VALUES ";
 
-    if (!query.exec())
-        MythDB::DBError("Error updating eitcache", query);
+        for (int i = start; i < end; i++)
+        {
+            if (i != start)
+                qstr += ',';
+            qstr += QString("(%1,%2,%3,%4,%5,0)")
+                .arg(extract_chanid(keys[i])).arg(extract_eventid(keys[i]))
+                .arg(extract_table_id(sigs[i])).arg(extract_version(sigs[i]))
+                .arg(extract_endtime(sigs[i]));
+        }
 
-    return;
+        qstr += " ON DUPLICATE KEY UPDATE "
+                "tableid = VALUES(tableid), "
+                "version = VALUES(version), "
+                "endtime = VALUES(endtime)";
+
+        if (!query.exec(qstr))
+            MythDB::DBError("Error updating eitcache", query);
+    }
 }
 
 static void delete_in_db(uint endtime)
@@ -215,10 +369,16 @@ static void unlock_channel(int chanid, uint updated)
 }
 
 
-event_map_t * EITCache::LoadChannel(uint chanid)
+/** \fn EITCache::LoadChannel(Stripe&, uint)
+ *  \brief Loads the cached entries for a channel into its stripe.
+ *
+ *  Must be called with the stripe locked.
+ *  \return false if the channel is locked by another backend
+ */
+bool EITCache::LoadChannel(Stripe &stripe, uint chanid)
 {
     if (!lock_channel(chanid, lastPruneTime))
-        return NULL;
+        return false;
 
     MSqlQuery query(MSqlQuery::InitCon());
 
@@ -234,15 +394,15 @@ event_map_t * EITCache::LoadChannel(uint chanid)
     query.bindValue(":ENDTIME",  lastPruneTime);
     query.bindValue(":STATUS",   EITDATA);
 
-
     if (!query.exec() || !query.isActive())
     {
         MythDB::DBError("Error loading eitcache", query);
-        return NULL;
+        return false;
     }
 
-    event_map_t * eventMap = new event_map_t();
+    stripe.events.Reserve(stripe.events.Size() + max(query.size(), 0));
 
+    uint count = 0;
     while (query.next())
     {
         uint eventid = query.value(0).toUInt();
@@ -250,69 +410,99 @@ event_map_t * EITCache::LoadChannel(uint chanid)
         uint version = query.value(2).toUInt();
         uint endtime = query.value(3).toUInt();
 
-        (*eventMap)[eventid] = construct_sig(tableid, version, endtime, false);
+        stripe.events.Insert(construct_key(chanid, eventid),
+                             construct_sig(tableid, version, endtime, false));
+        count++;
     }
 
-    if (eventMap->size())
+    if (count)
         LOG(VB_EIT, LOG_INFO, LOC + QString("Loaded %1 entries for channel %2")
-                .arg(eventMap->size()).arg(chanid));
+                .arg(count).arg(chanid));
 
-    entryCnt += eventMap->size();
-    return eventMap;
+    stripe.entryCnt += count;
+    return true;
 }
 
-void EITCache::WriteChannelToDB(uint chanid)
+/** \fn EITCache::WriteStripeToDB(Stripe&)
+ *  \brief Writes the modified entries of all channels in a stripe.
+ *
+ *  The entries are collected and marked as synced with the stripe locked,
+ *  the database is only accessed after it is unlocked.
+ */
+void EITCache::WriteStripeToDB(Stripe &stripe)
 {
-    event_map_t * eventMap = channelMap[chanid];
+    QVector<uint64_t> keys;
+    QVector<uint64_t> sigs;
+    QMap<uint, uint>  updated;   // chanid -> modified entries
+    QMap<uint, uint>  sizes;     // chanid -> entries
+
+    stripe.lock.lock();
 
-    if (!eventMap)
+    // Channels locked by another backend are forgotten, so IsNewEIT()
+    // tries to lock them again after this write cycle.
+    QMap<uint, bool>::iterator cit = stripe.channels.begin();
+    while (cit != stripe.channels.end())
     {
-        channelMap.remove(chanid);
-        return;
+        if (!*cit)
+        {
+            cit = stripe.channels.erase(cit);
+            continue;
+        }
+        updated[cit.key()] = 0;
+        ++cit;
     }
 
-    uint size    = eventMap->size();
-    uint updated = 0;
-
-    event_map_t::iterator it = eventMap->begin();
-    while (it != eventMap->end())
+    for (uint i = 0; i < stripe.events.Capacity(); i++)
     {
-        if (modified(*it) && extract_endtime(*it) > lastPruneTime)
+        uint64_t key = stripe.events.KeyAt(i);
+        if (key == EITCacheTable::kEmptyKey)
+            continue;
+
+        uint      chanid = extract_chanid(key);
+        uint64_t &sig    = stripe.events.SigAt(i);
+
+        sizes[chanid]++;
+
+        if (modified(sig) && extract_endtime(sig) > lastPruneTime &&
+            updated.contains(chanid))
         {
-            replace_in_db(chanid, it.key(), *it);
-            updated++;
-            *it &= ~(uint64_t)0 >> 1; // mark as synced
+            keys.push_back(key);
+            sigs.push_back(sig);
+            updated[chanid]++;
+            sig &= ~(uint64_t)0 >> 1; // mark as synced
         }
-        it++;
     }
-    unlock_channel(chanid, updated);
 
-    if (updated)
-        LOG(VB_EIT, LOG_INFO, LOC + QString("Wrote %1 modified entries of %2 "
-                                      "for channel %3 to database.")
-                .arg(updated).arg(size).arg(chanid));
-}
+    stripe.lock.unlock();
 
-void EITCache::WriteToDB(void)
-{
-    QMutexLocker locker(&eventMapLock);
+    write_to_db(keys, sigs);
 
-    key_map_t::iterator it = channelMap.begin();
-    while (it != channelMap.end())
+    QMap<uint, uint>::const_iterator it = updated.begin();
+    for (; it != updated.end(); ++it)
     {
-        WriteChannelToDB(it.key());
-        ++it;
+        unlock_channel(it.key(), *it);
+
+        if (*it)
+            LOG(VB_EIT, LOG_INFO, LOC + QString("Wrote %1 modified entries of "
+                                          "%2 for channel %3 to database.")
+                    .arg(*it).arg(sizes.value(it.key())).arg(it.key()));
     }
 }
 
+void EITCache::WriteToDB(void)
+{
+    for (uint i = 0; i < kStripes; i++)
+        WriteStripeToDB(stripes[i]);
+}
+
 
 
 bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
                         uint eventid, uint endtime)
 {
-    accessCnt++;
+    uint cnt = accessCnt.fetchAndAddRelaxed(1) + 1;
 
-    if (accessCnt % 500000 == 50000)
+    if (cnt % 500000 == 50000)
     {
         LOG(VB_EIT, LOG_INFO, GetStatistics());
         WriteToDB();
@@ -321,52 +511,59 @@ bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
     // don't readd pruned entries
     if (endtime < lastPruneTime)
     {
-        prunedHitCnt++;
+        prunedHitCnt.fetchAndAddRelaxed(1);
         return false;
     }
     // validity check, reject events with endtime over 7 weeks in the future
     if (endtime > lastPruneTime + 50 * 86400)
         return false;
 
-    QMutexLocker locker(&eventMapLock);
-    if (!channelMap.contains(chanid))
-    {
-        channelMap[chanid] = LoadChannel(chanid);
-    }
+    Stripe &stripe = GetStripe(chanid);
+    QMutexLocker locker(&stripe.lock);
 
-    if (!channelMap[chanid])
+    QMap<uint, bool>::iterator cit = stripe.channels.find(chanid);
+    if (cit == stripe.channels.end())
+        cit = stripe.channels.insert(chanid, LoadChannel(stripe, chanid));
+
+    if (!*cit)
     {
-        wrongChannelHitCnt++;
+        stripe.wrongChannelHitCnt++;
         return false;
     }
 
-    event_map_t * eventMap = channelMap[chanid];
-    event_map_t::iterator it = eventMap->find(eventid);
-    if (it != eventMap->end())
+    uint64_t  key = construct_key(chanid, eventid);
+    uint64_t *sig = stripe.events.Find(key);
+    if (sig)
     {
-        if (extract_table_id(*it) > tableid)
+        if (extract_table_id(*sig) > tableid)
         {
             // EIT from lower (ie. better) table number
-            tblChgCnt++;
+            stripe.tblChgCnt++;
         }
-        else if ((extract_table_id(*it) == tableid) &&
-                 ((extract_version(*it) < version) ||
-                  ((extract_version(*it) == kVersionMax) &&
+        else if ((extract_table_id(*sig) == tableid) &&
+                 ((extract_version(*sig) < version) ||
+                  ((extract_version(*sig) == kVersionMax) &&
                    version < kVersionMax)))
         {
             // EIT updated version on current table
-            verChgCnt++;
+            stripe.verChgCnt++;
         }
         else
         {
             // EIT data previously seen
-            hitCnt++;
+            stripe.hitCnt++;
             return false;
         }
+
+        *sig = construct_sig(tableid, version, endtime, true);
+    }
+    else
+    {
+        stripe.events.Insert(key, construct_sig(tableid, version, endtime,
+                                                true));
     }
 
-    eventMap->insert(eventid, construct_sig(tableid, version, endtime, true));
-    entryCnt++;
+    stripe.entryCnt++;
 
     return true;
 }
@@ -388,16 +585,25 @@ uint EITCache::PruneOldEntries(uint timestamp)
 
     lastPruneTime  = timestamp;
 
-    // Write all modified entries to DB and start with a clean cache
+    // Write all modified entries to DB
     WriteToDB();
 
+    // Drop the old entries from memory
+    uint pruned = 0;
+    for (uint i = 0; i < kStripes; i++)
+    {
+        QMutexLocker locker(&stripes[i].lock);
+        uint cnt = stripes[i].events.Prune(timestamp);
+        stripes[i].pruneCnt += cnt;
+        pruned += cnt;
+    }
+
     // Prune old entries in the DB
     delete_in_db(timestamp);
 
-    return 0;
+    return pruned;
 }
 
-
 /** \fn EITCache::ClearChannelLocks(void)
  *  \brief removes old channel locks, use it only at master b<ackend start
  */
@@ -10,14 +10,47 @@
 
 // Qt headers
 #include <QString>
+#include <QVector>
+#include <QAtomicInt>
 #include <QMutex>
 #include <QMap>
 
 // MythTV headers
 #include "mythtvexp.h"
 
-typedef QMap<uint, uint64_t> event_map_t;
-typedef QMap<uint, event_map_t*> key_map_t;
+/** \class EITCacheTable
+ *  \brief Open addressing hash table of (chanid,eventid) keys to packed
+ *         event signatures (table id, version, end time, modified flag).
+ *
+ *  Entries are only ever removed by Prune(), which rebuilds the table,
+ *  so no tombstones are needed.
+ */
+class EITCacheTable
+{
+  public:
+    EITCacheTable() : used(0) {}
+
+    uint64_t *Find(uint64_t key);
+    void      Insert(uint64_t key, uint64_t sig);
+    void      Reserve(uint count);
+    uint      Prune(uint endtime);
+    uint      Size(void) const { return used; }
+
+    // Raw access for iterating, empty slots have key == kEmptyKey
+    uint            Capacity(void)   const { return keys.size(); }
+    uint64_t        KeyAt(uint i)    const { return keys[i]; }
+    uint64_t       &SigAt(uint i)          { return sigs[i]; }
+
+    static const uint64_t kEmptyKey;
+
+  private:
+    uint Slot(uint64_t key) const;
+    void Rehash(uint capacity);
+
+    QVector<uint64_t> keys;
+    QVector<uint64_t> sigs;
+    uint              used;
+};
 
 class EITCache
 {
@@ -35,24 +68,41 @@ class EITCache
     QString GetStatistics(void) const;
 
   private:
-    event_map_t * LoadChannel(uint chanid);
-    void WriteChannelToDB(uint chanid);
-
-    // event key cache
-    key_map_t   channelMap;
+    /// Channels are spread over several independently locked stripes so
+    /// EIT threads on different multiplexes rarely wait on each other.
+    class Stripe
+    {
+      public:
+        Stripe() : hitCnt(0), tblChgCnt(0), verChgCnt(0), entryCnt(0),
+                   pruneCnt(0), wrongChannelHitCnt(0) {}
+
+        mutable QMutex    lock;
+        EITCacheTable     events;
+        /// true if loaded, false if locked by another backend
+        QMap<uint, bool>  channels;
+
+        // statistics
+        uint        hitCnt;
+        uint        tblChgCnt;
+        uint        verChgCnt;
+        uint        entryCnt;
+        uint        pruneCnt;
+        uint        wrongChannelHitCnt;
+    };
+
+    bool LoadChannel(Stripe &stripe, uint chanid);
+    void WriteStripeToDB(Stripe &stripe);
+
+    Stripe &GetStripe(uint chanid) { return stripes[chanid % kStripes]; }
+
+    static const uint kStripes = 16;
+    Stripe          stripes[kStripes];
 
-    mutable QMutex eventMapLock;
     uint            lastPruneTime;
 
     // statistics
-    uint        accessCnt;
-    uint        hitCnt;
-    uint        tblChgCnt;
-    uint        verChgCnt;
-    uint        entryCnt;
-    uint        pruneCnt;
-    uint        prunedHitCnt;
-    uint        wrongChannelHitCnt;
+    QAtomicInt      accessCnt;
+    QAtomicInt      prunedHitCnt;
 
     static const uint kVersionMax;
 
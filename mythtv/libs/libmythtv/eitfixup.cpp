@@ -16,24 +16,24 @@
 EITFixUp::EITFixUp()
     : m_bellYear("[\\(]{1}[0-9]{4}[\\)]{1}"),
       m_bellActors("\\set\\s|,"),
-      m_bellPPVTitleAllDayHD("\\s*\\(All Day\\, HD\\)\\s*$"),
-      m_bellPPVTitleAllDay("\\s*\\(All Day.*\\)\\s*$"),
-      m_bellPPVTitleHD("^HD\\s?-\\s?"),
-      m_bellPPVSubtitleAllDay("^All Day \\(.*\\sEastern\\)\\s*$"),
-      m_bellPPVDescriptionAllDay("^\\(.*\\sEastern\\)"),
-      m_bellPPVDescriptionAllDay2("^\\([0-9].*am-[0-9].*am\\sET\\)"),
+      m_bellPPVTitleAllDayHD("\\s*\\(All Day\\, HD\\)\\s*$", "(All Day, HD)"),
+      m_bellPPVTitleAllDay("\\s*\\(All Day.*\\)\\s*$", "(All Day"),
+      m_bellPPVTitleHD("^HD\\s?-\\s?", "HD"),
+      m_bellPPVSubtitleAllDay("^All Day \\(.*\\sEastern\\)\\s*$", "All Day ("),
+      m_bellPPVDescriptionAllDay("^\\(.*\\sEastern\\)", "Eastern)"),
+      m_bellPPVDescriptionAllDay2("^\\([0-9].*am-[0-9].*am\\sET\\)", "ET)"),
       m_bellPPVDescriptionEventId("\\([0-9]{5}\\)"),
-      m_dishPPVTitleHD("\\sHD\\s*$"),
+      m_dishPPVTitleHD("\\sHD\\s*$", "HD"),
       m_dishPPVTitleColon("\\:\\s*$"),
       m_dishPPVSpacePerenEnd("\\s\\)\\s*$"),
-      m_dishDescriptionNew("\\s*New\\.\\s*"),
-      m_dishDescriptionFinale("\\s*(Series|Season)\\sFinale\\.\\s*"),
-      m_dishDescriptionFinale2("\\s*Finale\\.\\s*"),
-      m_dishDescriptionPremiere("\\s*(Series|Season)\\s(Premier|Premiere)\\.\\s*"),
-      m_dishDescriptionPremiere2("\\s*(Premier|Premiere)\\.\\s*"),
+      m_dishDescriptionNew("\\s*New\\.\\s*", "New."),
+      m_dishDescriptionFinale("\\s*(Series|Season)\\sFinale\\.\\s*", "Finale."),
+      m_dishDescriptionFinale2("\\s*Finale\\.\\s*", "Finale."),
+      m_dishDescriptionPremiere("\\s*(Series|Season)\\s(Premier|Premiere)\\.\\s*", "Premier"),
+      m_dishDescriptionPremiere2("\\s*(Premier|Premiere)\\.\\s*", "Premier"),
       m_dishPPVCode("\\s*\\(([A-Z]|[0-9]){5}\\)\\s*$"),
-      m_ukThen("\\s*(Then|Followed by) 60 Seconds\\.", Qt::CaseInsensitive),
-      m_ukNew("(New\\.|\\s*(Brand New|New)\\s*(Series|Episode)\\s*[:\\.\\-])",Qt::CaseInsensitive),
+      m_ukThen("\\s*(Then|Followed by) 60 Seconds\\.", "60 Seconds.", Qt::CaseInsensitive),
+      m_ukNew("(New\\.|\\s*(Brand New|New)\\s*(Series|Episode)\\s*[:\\.\\-])", "New",Qt::CaseInsensitive),
       m_ukCEPQ("[:\\!\\.\\?]"),
       m_ukColonPeriod("[:\\.]"),
       m_ukDotSpaceStart("^\\. "),
@@ -41,17 +41,17 @@ EITFixUp::EITFixUp()
       m_ukSpaceColonStart("^[ |:]*"),
       m_ukSpaceStart("^ "),
       m_ukSeries("\\s*\\(?\\s*(?:Episode|Part|Pt)?\\s*(\\d{1,2})\\s*(?:of|/)\\s*(\\d{1,2})\\s*\\)?\\s*(?:\\.|:)?", Qt::CaseInsensitive),
-      m_ukCC("\\[(?:(AD|SL|S|W),?)+\\]"),
+      m_ukCC("\\[(?:(AD|SL|S|W),?)+\\]", "["),
       m_ukYear("[\\[\\(]([\\d]{4})[\\)\\]]"),
-      m_uk24ep("^\\d{1,2}:00[ap]m to \\d{1,2}:00[ap]m: "),
-      m_ukStarring("(?:Western\\s)?[Ss]tarring ([\\w\\s\\-']+)[Aa]nd\\s([\\w\\s\\-']+)[\\.|,](?:\\s)*(\\d{4})?(?:\\.\\s)?"),
-      m_ukBBC7rpt("\\[Rptd?[^]]+\\d{1,2}\\.\\d{1,2}[ap]m\\]\\."),
+      m_uk24ep("^\\d{1,2}:00[ap]m to \\d{1,2}:00[ap]m: ", "m to "),
+      m_ukStarring("(?:Western\\s)?[Ss]tarring ([\\w\\s\\-']+)[Aa]nd\\s([\\w\\s\\-']+)[\\.|,](?:\\s)*(\\d{4})?(?:\\.\\s)?", "tarring "),
+      m_ukBBC7rpt("\\[Rptd?[^]]+\\d{1,2}\\.\\d{1,2}[ap]m\\]\\.", "[Rpt"),
       m_ukDescriptionRemove("^(?:CBBC\\s*\\.|CBeebies\\s*\\.|Class TV\\s*:|BBC Switch\\.)"),
-      m_ukTitleRemove("^(?:[tT]4:|Schools\\s*:)"),
+      m_ukTitleRemove("^(?:[tT]4:|Schools\\s*:)", ":"),
       m_ukDoubleDotEnd("\\.\\.+$"),
       m_ukDoubleDotStart("^\\.\\.+"),
       m_ukTime("\\d{1,2}[\\.:]\\d{1,2}\\s*(am|pm|)"),
-      m_ukBBC34("BBC (?:THREE|FOUR) on BBC (?:ONE|TWO)\\.",Qt::CaseInsensitive),
+      m_ukBBC34("BBC (?:THREE|FOUR) on BBC (?:ONE|TWO)\\.", "BBC",Qt::CaseInsensitive),
       m_ukYearColon("^[\\d]{4}:"),
       m_ukExclusionFromSubtitle("(starring|stars\\s|drama|series|sitcom)",Qt::CaseInsensitive),
       m_ukCompleteDots("^\\.\\.+$"),
@@ -61,9 +61,9 @@ EITFixUp::EITFixUp()
       m_comHemActor("[Ss]kdespelare|[Ii] rollerna"),
       m_comHemHost("[Pp]rogramledare"),
       m_comHemSub("[.\\?\\!] "),
-      m_comHemRerun1("[Rr]epris\\sfrn\\s([^\\.]+)(?:\\.|$)"),
+      m_comHemRerun1("[Rr]epris\\sfrn\\s([^\\.]+)(?:\\.|$)", "epris"),
       m_comHemRerun2("([0-9]+)/([0-9]+)(?:\\s-\\s([0-9]{4}))?"),
-      m_comHemTT("[Tt]ext-[Tt][Vv]"),
+      m_comHemTT("[Tt]ext-[Tt][Vv]", "ext-"),
       m_comHemPersSeparator("(, |\\soch\\s)"),
       m_comHemPersons("\\s?([Rr]egi|[Ss]kdespelare|[Pp]rogramledare|"
                       "[Ii] rollerna):\\s([^\\.]+)\\."),
@@ -78,48 +78,48 @@ EITFixUp::EITFixUp()
       m_mcaSubtitle("^'([^\\.]+)'\\.\\s+(.+)"),
       m_mcaSeries("^S?(\\d+)\\/E?(\\d+)\\s-\\s(.*)$"),
       m_mcaCredits("(.*)\\s\\((\\d{4})\\)\\s*([^\\.]+)\\.?\\s*$"),
-      m_mcaAvail("\\s(Only available on [^\\.]*bouquet|Not available in RSA [^\\.]*)\\.?"),
+      m_mcaAvail("\\s(Only available on [^\\.]*bouquet|Not available in RSA [^\\.]*)\\.?", "vailable"),
       m_mcaActors("(.*\\.)\\s+([^\\.]+\\s[A-Z][^\\.]+)\\.\\s*"),
       m_mcaActorsSeparator("(,\\s+)"),
       m_mcaYear("(.*)\\s\\((\\d{4})\\)\\s*$"),
-      m_mcaCC(",?\\s(HI|English) Subtitles\\.?"),
-      m_mcaDD(",?\\sDD\\.?"),
-      m_RTLrepeat("(\\(|\\s)?Wiederholung.+vo[m|n].+((?:\\d{2}\\.\\d{2}\\.\\d{4})|(?:\\d{2}[:\\.]\\d{2}\\sUhr))\\)?"),
+      m_mcaCC(",?\\s(HI|English) Subtitles\\.?", " Subtitles"),
+      m_mcaDD(",?\\sDD\\.?", "DD"),
+      m_RTLrepeat("(\\(|\\s)?Wiederholung.+vo[m|n].+((?:\\d{2}\\.\\d{2}\\.\\d{4})|(?:\\d{2}[:\\.]\\d{2}\\sUhr))\\)?", "Wiederholung"),
       m_RTLSubtitle("^([^\\.]{3,})\\.\\s+(.+)"),
-      m_RTLSubtitle1("^Folge\\s(\\d{1,4})\\s*:\\s+'(.*)'(?:\\.\\s*|$)"),
-      m_RTLSubtitle2("^Folge\\s(\\d{1,4})\\s+(.{,5}[^\\.]{,120})[\\?!\\.]\\s*"),
+      m_RTLSubtitle1("^Folge\\s(\\d{1,4})\\s*:\\s+'(.*)'(?:\\.\\s*|$)", "Folge"),
+      m_RTLSubtitle2("^Folge\\s(\\d{1,4})\\s+(.{,5}[^\\.]{,120})[\\?!\\.]\\s*", "Folge"),
       m_RTLSubtitle3("^(?:Folge\\s)?(\\d{1,4}(?:\\/[IVX]+)?)\\s+(.{,5}[^\\.]{,120})[\\?!\\.]\\s*"),
-      m_RTLSubtitle4("^Thema.{0,5}:\\s([^\\.]+)\\.\\s*"),
-      m_RTLSubtitle5("^'(.+)'\\.\\s*"),
-      m_RTLEpisodeNo1("^(Folge\\s\\d{1,4})\\.*\\s*"),
-      m_RTLEpisodeNo2("^(\\d{1,2}\\/[IVX]+)\\.*\\s*"),
-      m_fiRerun("\\ ?Uusinta[a-zA-Z\\ ]*\\.?"),
+      m_RTLSubtitle4("^Thema.{0,5}:\\s([^\\.]+)\\.\\s*", "Thema"),
+      m_RTLSubtitle5("^'(.+)'\\.\\s*", "'"),
+      m_RTLEpisodeNo1("^(Folge\\s\\d{1,4})\\.*\\s*", "Folge"),
+      m_RTLEpisodeNo2("^(\\d{1,2}\\/[IVX]+)\\.*\\s*", "/"),
+      m_fiRerun("\\ ?Uusinta[a-zA-Z\\ ]*\\.?", "Uusinta"),
       m_fiRerun2("\\([Uu]\\)"),
       m_dePremiereInfos("([^.]+)?\\s?([0-9]{4})\\.\\s[0-9]+\\sMin\\.(?:\\sVon"
-                        "\\s([^,]+)(?:,|\\su\\.\\sa\\.)\\smit\\s(.+)\\.)?"),
+                        "\\s([^,]+)(?:,|\\su\\.\\sa\\.)\\smit\\s(.+)\\.)?", "Min."),
       m_dePremiereOTitle("\\s*\\(([^\\)]*)\\)$"),
       m_nlTxt("txt"),
       m_nlWide("breedbeeld"),
       m_nlRepeat("herh."),
-      m_nlHD("\\sHD$"),
-      m_nlSub("\\sAfl\\.:\\s([^\\.]+)\\."),
-      m_nlActors("\\sMet:\\s.+e\\.a\\."),
-      m_nlPres("\\sPresentatie:\\s([^\\.]+)\\."),
+      m_nlHD("\\sHD$", "HD"),
+      m_nlSub("\\sAfl\\.:\\s([^\\.]+)\\.", "Afl.:"),
+      m_nlActors("\\sMet:\\s.+e\\.a\\.", "Met:"),
+      m_nlPres("\\sPresentatie:\\s([^\\.]+)\\.", "Presentatie:"),
       m_nlPersSeparator("(, |\\sen\\s)"),
       m_nlRub("\\s?\\({1}\\W+\\){1}\\s?"),
-      m_nlYear1("(?=\\suit\\s)([1-2]{2}[0-9]{2})"),
+      m_nlYear1("(?=\\suit\\s)([1-2]{2}[0-9]{2})", "uit"),
       m_nlYear2("([\\s]{1}[\\(]{1}[A-Z]{0,3}/?)([1-2]{2}[0-9]{2})([\\)]{1})"),
-      m_nlDirector("(?=\\svan\\s)(([A-Z]{1}[a-z]+\\s)|([A-Z]{1}\\.\\s))"),
+      m_nlDirector("(?=\\svan\\s)(([A-Z]{1}[a-z]+\\s)|([A-Z]{1}\\.\\s))", "van"),
       m_nlCat("^(Amusement|Muziek|Informatief|Nieuws/actualiteiten|Jeugd|Animatie|Sport|Serie/soap|Kunst/Cultuur|Documentaire|Film|Natuur|Erotiek|Comedy|Misdaad|Religieus)\\.\\s"),
       m_nlOmroep ("\\s\\(([A-Z]+/?)+\\)$"),
-      m_noRerun("\\(R\\)"),
+      m_noRerun("\\(R\\)", "(R)"),
       m_noColonSubtitle("^([^:]+): (.+)"),
       m_noNRKCategories("^(Superstrek[ea]r|Supersomm[ea]r|Superjul|Barne-tv|Fantorangen|Kuraffen|Supermorg[eo]n|Julemorg[eo]n|Sommermorg[eo]n|"
                         "Kuraffen-TV|Sport i dag|NRKs sportsl.rdag|NRKs sportss.ndag|Dagens dokumentar|"
                         "NRK2s historiekveld|Detektimen|Nattkino|Filmklassiker|Film|Kortfilm|P.skemorg[eo]n|"
                         "Radioteatret|Opera|P2-Akademiet|Nyhetsmorg[eo]n i P2 og Alltid Nyheter:): (.+)"),
-      m_noPremiere("\\s+-\\s+(Sesongpremiere|Premiere|premiere)!?$"),
-      m_Stereo("\\b\\(?[sS]tereo\\)?\\b")
+      m_noPremiere("\\s+-\\s+(Sesongpremiere|Premiere|premiere)!?$", "remiere"),
+      m_Stereo("\\b\\(?[sS]tereo\\)?\\b", "tereo")
 
 {
 }
@@ -141,47 +141,35 @@ void EITFixUp::Fix(DBEventEIT &event) const
     if (kFixHDTV & event.fixup)
         event.videoProps |= VID_HDTV;
 
-    if (kFixBell & event.fixup)
-        FixBellExpressVu(event);
-
-    if (kFixDish & event.fixup)
-        FixBellExpressVu(event);
-
-    if (kFixUK & event.fixup)
-        FixUK(event);
-
-    if (kFixPBS & event.fixup)
-        FixPBS(event);
-
-    if (kFixComHem & event.fixup)
-        FixComHem(event, kFixSubtitle & event.fixup);
-
-    if (kFixAUStar & event.fixup)
-        FixAUStar(event);
-
-    if (kFixMCA & event.fixup)
-        FixMCA(event);
-
-    if (kFixRTL & event.fixup)
-        FixRTL(event);
-
-    if (kFixFI & event.fixup)
-        FixFI(event);
-
-    if (kFixPremiere & event.fixup)
-        FixPremiere(event);
-
-    if (kFixNL & event.fixup)
-        FixNL(event);
-
-    if (kFixNO & event.fixup)
-        FixNO(event);
-
-    if (kFixNRK_DVBT & event.fixup)
-        FixNRK_DVBT(event);
+    // Provider fixups, in the order they have to be applied.
+    static const struct
+    {
+        uint flag;
+        void (EITFixUp::*fix)(DBEventEIT&) const;
+    } fixups[] =
+    {
+        { kFixBell,     &EITFixUp::FixBellExpressVu },
+        { kFixDish,     &EITFixUp::FixBellExpressVu },
+        { kFixUK,       &EITFixUp::FixUK            },
+        { kFixPBS,      &EITFixUp::FixPBS           },
+        { kFixComHem,   &EITFixUp::FixComHem        },
+        { kFixAUStar,   &EITFixUp::FixAUStar        },
+        { kFixMCA,      &EITFixUp::FixMCA           },
+        { kFixRTL,      &EITFixUp::FixRTL           },
+        { kFixFI,       &EITFixUp::FixFI            },
+        { kFixPremiere, &EITFixUp::FixPremiere      },
+        { kFixNL,       &EITFixUp::FixNL            },
+        { kFixNO,       &EITFixUp::FixNO            },
+        { kFixNRK_DVBT, &EITFixUp::FixNRK_DVBT      },
+        { kFixCategory, &EITFixUp::FixCategory      },
+    };
+    static const uint num_fixups = sizeof(fixups) / sizeof(fixups[0]);
 
-    if (kFixCategory & event.fixup)
-        FixCategory(event);
+    for (uint i = 0; i < num_fixups; ++i)
+    {
+        if (fixups[i].flag & event.fixup)
+            (this->*fixups[i].fix)(event);
+    }
 
     if (event.fixup)
     {
@@ -370,31 +358,31 @@ void EITFixUp::FixBellExpressVu(DBEventEIT &event) const
     }
 
     // Check for (Stereo) in the decription and set the <audio> tags
-    position = event.description.indexOf(m_Stereo);
-    if (position != -1)
+    if (m_Stereo.MayMatch(event.description) &&
+        event.description.indexOf(m_Stereo) != -1)
     {
         event.audioProps |= AUD_STEREO;
         event.description = event.description.replace(m_Stereo, "");
     }
 
     // Check for "title (All Day, HD)" in the title
-    position = event.title.indexOf(m_bellPPVTitleAllDayHD);
-    if (position != -1)
+    if (m_bellPPVTitleAllDayHD.MayMatch(event.title) &&
+        event.title.indexOf(m_bellPPVTitleAllDayHD) != -1)
     {
         event.title = event.title.replace(m_bellPPVTitleAllDayHD, "");
         event.videoProps |= VID_HDTV;
      }
 
     // Check for "title (All Day)" in the title
-    position = event.title.indexOf(m_bellPPVTitleAllDay);
-    if (position != -1)
+    if (m_bellPPVTitleAllDay.MayMatch(event.title) &&
+        event.title.indexOf(m_bellPPVTitleAllDay) != -1)
     {
         event.title = event.title.replace(m_bellPPVTitleAllDay, "");
     }
 
     // Check for "HD - title" in the title
-    position = event.title.indexOf(m_bellPPVTitleHD);
-    if (position != -1)
+    if (m_bellPPVTitleHD.MayMatch(event.title) &&
+        event.title.indexOf(m_bellPPVTitleHD) != -1)
     {
         event.title = event.title.replace(m_bellPPVTitleHD, "");
         event.videoProps |= VID_HDTV;
@@ -417,8 +405,8 @@ void EITFixUp::FixBellExpressVu(DBEventEIT &event) const
     }
 
     // Check for HD at the end of the title
-    position = event.title.indexOf(m_dishPPVTitleHD);
-    if (position != -1)
+    if (m_dishPPVTitleHD.MayMatch(event.title) &&
+        event.title.indexOf(m_dishPPVTitleHD) != -1)
     {
         event.title = event.title.replace(m_dishPPVTitleHD, "");
         event.videoProps |= VID_HDTV;
@@ -449,40 +437,40 @@ void EITFixUp::FixBellExpressVu(DBEventEIT &event) const
     }
 
     // Remove New at the end of the description
-    position = event.description.indexOf(m_dishDescriptionNew);
-    if (position != -1)
+    if (m_dishDescriptionNew.MayMatch(event.description) &&
+        event.description.indexOf(m_dishDescriptionNew) != -1)
     {
         event.previouslyshown = false;
         event.description = event.description.replace(m_dishDescriptionNew, "");
     }
 
     // Remove Series Finale at the end of the desciption
-    position = event.description.indexOf(m_dishDescriptionFinale);
-    if (position != -1)
+    if (m_dishDescriptionFinale.MayMatch(event.description) &&
+        event.description.indexOf(m_dishDescriptionFinale) != -1)
     {
         event.previouslyshown = false;
         event.description = event.description.replace(m_dishDescriptionFinale, "");
     }
 
     // Remove Series Finale at the end of the desciption
-    position = event.description.indexOf(m_dishDescriptionFinale2);
-    if (position != -1)
+    if (m_dishDescriptionFinale2.MayMatch(event.description) &&
+        event.description.indexOf(m_dishDescriptionFinale2) != -1)
     {
         event.previouslyshown = false;
         event.description = event.description.replace(m_dishDescriptionFinale2, "");
     }
 
     // Remove Series Premiere at the end of the description
-    position = event.description.indexOf(m_dishDescriptionPremiere);
-    if (position != -1)
+    if (m_dishDescriptionPremiere.MayMatch(event.description) &&
+        event.description.indexOf(m_dishDescriptionPremiere) != -1)
     {
         event.previouslyshown = false;
         event.description = event.description.replace(m_dishDescriptionPremiere, "");
     }
 
     // Remove Series Premiere at the end of the description
-    position = event.description.indexOf(m_dishDescriptionPremiere2);
-    if (position != -1)
+    if (m_dishDescriptionPremiere2.MayMatch(event.description) &&
+        event.description.indexOf(m_dishDescriptionPremiere2) != -1)
     {
         event.previouslyshown = false;
         event.description = event.description.replace(m_dishDescriptionPremiere2, "");
@@ -505,22 +493,22 @@ void EITFixUp::FixBellExpressVu(DBEventEIT &event) const
     }
 
     // Check for subtitle "All Day (... Eastern)" in the subtitle
-    position = event.subtitle.indexOf(m_bellPPVSubtitleAllDay);
-    if (position != -1)
+    if (m_bellPPVSubtitleAllDay.MayMatch(event.subtitle) &&
+        event.subtitle.indexOf(m_bellPPVSubtitleAllDay) != -1)
     {
         event.subtitle = event.subtitle.replace(m_bellPPVSubtitleAllDay, "");
     }
 
     // Check for description "(... Eastern)" in the description
-    position = event.description.indexOf(m_bellPPVDescriptionAllDay);
-    if (position != -1)
+    if (m_bellPPVDescriptionAllDay.MayMatch(event.description) &&
+        event.description.indexOf(m_bellPPVDescriptionAllDay) != -1)
     {
         event.description = event.description.replace(m_bellPPVDescriptionAllDay, "");
     }
 
     // Check for description "(... ET)" in the description
-    position = event.description.indexOf(m_bellPPVDescriptionAllDay2);
-    if (position != -1)
+    if (m_bellPPVDescriptionAllDay2.MayMatch(event.description) &&
+        event.description.indexOf(m_bellPPVDescriptionAllDay2) != -1)
     {
         event.description = event.description.replace(m_bellPPVDescriptionAllDay2, "");
     }
@@ -667,22 +655,28 @@ void EITFixUp::FixUK(DBEventEIT &event) const
 
     bool isMovie = event.category.startsWith("Movie",Qt::CaseInsensitive);
     // BBC three case (could add another record here ?)
-    event.description = event.description.remove(m_ukThen);
-    event.description = event.description.remove(m_ukNew);
+    if (m_ukThen.MayMatch(event.description))
+        event.description = event.description.remove(m_ukThen);
+    if (m_ukNew.MayMatch(event.description))
+        event.description = event.description.remove(m_ukNew);
 
     // Removal of Class TV, CBBC and CBeebies etc..
-    event.title = event.title.remove(m_ukTitleRemove);
+    if (m_ukTitleRemove.MayMatch(event.title))
+        event.title = event.title.remove(m_ukTitleRemove);
     event.description = event.description.remove(m_ukDescriptionRemove);
 
     // Removal of BBC FOUR and BBC THREE
-    event.description = event.description.remove(m_ukBBC34);
+    if (m_ukBBC34.MayMatch(event.description))
+        event.description = event.description.remove(m_ukBBC34);
 
     // BBC 7 [Rpt of ...] case.
-    event.description = event.description.remove(m_ukBBC7rpt);
+    if (m_ukBBC7rpt.MayMatch(event.description))
+        event.description = event.description.remove(m_ukBBC7rpt);
 
     // Remove [AD,S] etc.
     QRegExp tmpCC = m_ukCC;
-    if ((position1 = tmpCC.indexIn(event.description)) != -1)
+    if (m_ukCC.MayMatch(event.description) &&
+        (position1 = tmpCC.indexIn(event.description)) != -1)
     {
         QStringList tmpCCitems = tmpCC.cap(0).remove("[").remove("]").split(",");
         if (tmpCCitems.contains("AD"))
@@ -732,7 +726,8 @@ void EITFixUp::FixUK(DBEventEIT &event) const
         event.categoryType = kCategorySeries;
 
     QRegExp tmpStarring = m_ukStarring;
-    if (tmpStarring.indexIn(event.description) != -1)
+    if (m_ukStarring.MayMatch(event.description) &&
+        tmpStarring.indexIn(event.description) != -1)
     {
         // if we match this we've captured 2 actors and an (optional) airdate
         event.AddPerson(DBPerson::kActor, tmpStarring.cap(1));
@@ -785,7 +780,8 @@ void EITFixUp::FixUK(DBEventEIT &event) const
                 }
             }
         }
-        else if ((position1 = tmp24ep.indexIn(event.description)) != -1)
+        else if (m_uk24ep.MayMatch(event.description) &&
+                 (position1 = tmp24ep.indexIn(event.description)) != -1)
         {
             // Special case for episodes of 24.
             // -2 from the length cause we don't want ": " on the end
@@ -887,8 +883,10 @@ void EITFixUp::FixPBS(DBEventEIT &event) const
 /**
  *  \brief Use this to standardize ComHem DVB-C service in Sweden.
  */
-void EITFixUp::FixComHem(DBEventEIT &event, bool process_subtitle) const
+void EITFixUp::FixComHem(DBEventEIT &event) const
 {
+    bool process_subtitle = kFixSubtitle & event.fixup;
+
     // Reverse what EITFixUp::Fix() did
     if (event.subtitle.isEmpty() && !event.description.isEmpty())
     {
@@ -1074,13 +1072,16 @@ void EITFixUp::FixComHem(DBEventEIT &event, bool process_subtitle) const
     }
 
     // Teletext subtitles?
-    int position = event.description.indexOf(m_comHemTT);
-    if (position != -1)
+    if (m_comHemTT.MayMatch(event.description) &&
+        event.description.indexOf(m_comHemTT) != -1)
     {
         event.subtitleType |= SUB_NORMAL;
     }
 
     // Try to findout if this is a rerun and if so the date.
+    if (!m_comHemRerun1.MayMatch(event.description))
+        return;
+
     QRegExp tmpRerun1 = m_comHemRerun1;
     if (tmpRerun1.indexIn(event.description) == -1)
         return;
@@ -1203,7 +1204,8 @@ void EITFixUp::FixMCA(DBEventEIT &event) const
     }
 
     // Close captioned?
-    position = event.description.indexOf(m_mcaCC);
+    position = m_mcaCC.MayMatch(event.description) ?
+        event.description.indexOf(m_mcaCC) : -1;
     if (position > 0)
     {
         event.subtitleType |= SUB_HARDHEAR;
@@ -1211,7 +1213,8 @@ void EITFixUp::FixMCA(DBEventEIT &event) const
     }
 
     // Dolby Digital 5.1?
-    position = event.description.indexOf(m_mcaDD);
+    position = m_mcaDD.MayMatch(event.description) ?
+        event.description.indexOf(m_mcaDD) : -1;
     if ((position > 0) && (position > (int) (event.description.length() - 7)))
     {
         event.audioProps |= AUD_DOLBY;
@@ -1220,7 +1223,8 @@ void EITFixUp::FixMCA(DBEventEIT &event) const
     }
 
     // Remove bouquet tags
-    event.description.replace(m_mcaAvail, "");
+    if (m_mcaAvail.MayMatch(event.description))
+        event.description.replace(m_mcaAvail, "");
 
     // Try to find year and director from the end of the description
     bool isMovie = false;
@@ -1283,7 +1287,8 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
 
     // Repeat
     QRegExp tmpExpRepeat = m_RTLrepeat;
-    if ((pos = tmpExpRepeat.indexIn(event.description)) != -1)
+    if (m_RTLrepeat.MayMatch(event.description) &&
+        (pos = tmpExpRepeat.indexIn(event.description)) != -1)
     {
         // remove '.' if it matches at the beginning of the description
         int length = tmpExpRepeat.cap(0).length() + (pos ? 0 : 1);
@@ -1303,7 +1308,8 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
     QRegExp tmpExpEpisodeNo2 = m_RTLEpisodeNo2;
 
     // subtitle with episode number: "Folge *: 'subtitle'. description
-    if (tmpExpSubtitle1.indexIn(event.description) != -1)
+    if (m_RTLSubtitle1.MayMatch(event.description) &&
+        tmpExpSubtitle1.indexIn(event.description) != -1)
     {
         event.syndicatedepisodenumber = tmpExpSubtitle1.cap(1);
         event.subtitle    = tmpExpSubtitle1.cap(2);
@@ -1311,7 +1317,8 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
             event.description.remove(0, tmpExpSubtitle1.matchedLength());
     }
     // episode number subtitle
-    else if (tmpExpSubtitle2.indexIn(event.description) != -1)
+    else if (m_RTLSubtitle2.MayMatch(event.description) &&
+             tmpExpSubtitle2.indexIn(event.description) != -1)
     {
         event.syndicatedepisodenumber = tmpExpSubtitle2.cap(1);
         event.subtitle    = tmpExpSubtitle2.cap(2);
@@ -1327,21 +1334,24 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
             event.description.remove(0, tmpExpSubtitle3.matchedLength());
     }
     // "Thema..."
-    else if (tmpExpSubtitle4.indexIn(event.description) != -1)
+    else if (m_RTLSubtitle4.MayMatch(event.description) &&
+             tmpExpSubtitle4.indexIn(event.description) != -1)
     {
         event.subtitle    = tmpExpSubtitle4.cap(1);
         event.description =
             event.description.remove(0, tmpExpSubtitle4.matchedLength());
     }
     // "'...'"
-    else if (tmpExpSubtitle5.indexIn(event.description) != -1)
+    else if (m_RTLSubtitle5.MayMatch(event.description) &&
+             tmpExpSubtitle5.indexIn(event.description) != -1)
     {
         event.subtitle    = tmpExpSubtitle5.cap(1);
         event.description =
             event.description.remove(0, tmpExpSubtitle5.matchedLength());
     }
     // episode number
-    else if (tmpExpEpisodeNo1.indexIn(event.description) != -1)
+    else if (m_RTLEpisodeNo1.MayMatch(event.description) &&
+             tmpExpEpisodeNo1.indexIn(event.description) != -1)
     {
         event.syndicatedepisodenumber = tmpExpEpisodeNo1.cap(2);
         event.subtitle    = tmpExpEpisodeNo1.cap(1);
@@ -1349,7 +1359,8 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
             event.description.remove(0, tmpExpEpisodeNo1.matchedLength());
     }
     // episode number
-    else if (tmpExpEpisodeNo2.indexIn(event.description) != -1)
+    else if (m_RTLEpisodeNo2.MayMatch(event.description) &&
+             tmpExpEpisodeNo2.indexIn(event.description) != -1)
     {
         event.syndicatedepisodenumber = tmpExpEpisodeNo2.cap(2);
         event.subtitle    = tmpExpEpisodeNo2.cap(1);
@@ -1380,23 +1391,22 @@ void EITFixUp::FixRTL(DBEventEIT &event) const
  */
 void EITFixUp::FixFI(DBEventEIT &event) const
 {
-    int position = event.description.indexOf(m_fiRerun);
-    if (position != -1)
+    if (m_fiRerun.MayMatch(event.description) &&
+        event.description.indexOf(m_fiRerun) != -1)
     {
         event.previouslyshown = true;
         event.description = event.description.replace(m_fiRerun, "");
     }
 
-    position = event.description.indexOf(m_fiRerun2);
-    if (position != -1)
+    if (event.description.indexOf(m_fiRerun2) != -1)
     {
         event.previouslyshown = true;
         event.description = event.description.replace(m_fiRerun2, "");
     }
 
     // Check for (Stereo) in the decription and set the <audio> tags
-    position = event.description.indexOf(m_Stereo);
-    if (position != -1)
+    if (m_Stereo.MayMatch(event.description) &&
+        event.description.indexOf(m_Stereo) != -1)
     {
         event.audioProps |= AUD_STEREO;
         event.description = event.description.replace(m_Stereo, "");
@@ -1413,7 +1423,8 @@ void EITFixUp::FixPremiere(DBEventEIT &event) const
 
     // Find infos about country and year, regisseur and actors
     QRegExp tmpInfos =  m_dePremiereInfos;
-    if (tmpInfos.indexIn(event.description) != -1)
+    if (m_dePremiereInfos.MayMatch(event.description) &&
+        tmpInfos.indexIn(event.description) != -1)
     {
         country = tmpInfos.cap(1).trimmed();
         bool ok;
@@ -1534,7 +1545,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
 
     // Get stereo info
     int position;
-    if ((position = fullinfo.indexOf(m_Stereo)) != -1)
+    if (m_Stereo.MayMatch(fullinfo) &&
+        (position = fullinfo.indexOf(m_Stereo)) != -1)
     {
         event.audioProps |= AUD_STEREO;
         fullinfo = fullinfo.replace(m_Stereo, ".");
@@ -1560,7 +1572,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
     }
 
     // Get HDTV information
-    if ((position = event.title.indexOf(m_nlHD)) != -1)
+    if (m_nlHD.MayMatch(event.title) &&
+        (position = event.title.indexOf(m_nlHD)) != -1)
     {
         event.videoProps |= VID_HDTV;
         event.title = event.title.replace(m_nlHD, "");
@@ -1569,7 +1582,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
     // Try to make subtitle
     QRegExp tmpSub = m_nlSub;
     QString tmpSubString;
-    if (tmpSub.indexIn(fullinfo) != -1)
+    if (m_nlSub.MayMatch(fullinfo) &&
+        tmpSub.indexIn(fullinfo) != -1)
     {
         tmpSubString = tmpSub.cap(0);
         tmpSubString = tmpSubString.right(tmpSubString.length() - 7);
@@ -1590,7 +1604,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
 
     // Get the actors
     QRegExp tmpActors = m_nlActors;
-    if (tmpActors.indexIn(fullinfo) != -1)
+    if (m_nlActors.MayMatch(fullinfo) &&
+        tmpActors.indexIn(fullinfo) != -1)
     {
         QString tmpActorsString = tmpActors.cap(0);
         tmpActorsString = tmpActorsString.right(tmpActorsString.length() - 6);
@@ -1605,7 +1620,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
 
     // Try to find presenter
     QRegExp tmpPres = m_nlPres;
-    if (tmpPres.indexIn(fullinfo) != -1)
+    if (m_nlPres.MayMatch(fullinfo) &&
+        tmpPres.indexIn(fullinfo) != -1)
     {
         QString tmpPresString = tmpPres.cap(0);
         tmpPresString = tmpPresString.right(tmpPresString.length() - 14);
@@ -1621,7 +1637,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
     // Try to find year
     QRegExp tmpYear1 = m_nlYear1;
     QRegExp tmpYear2 = m_nlYear2;
-    if ((position = tmpYear1.indexIn(fullinfo)) != -1)
+    if (m_nlYear1.MayMatch(fullinfo) &&
+        (position = tmpYear1.indexIn(fullinfo)) != -1)
     {
         bool ok;
         uint y = tmpYear1.cap(0).toUInt(&ok);
@@ -1640,7 +1657,8 @@ void EITFixUp::FixNL(DBEventEIT &event) const
     // Try to find director
     QRegExp tmpDirector = m_nlDirector;
     QString tmpDirectorString;
-    if ((position = fullinfo.indexOf(m_nlDirector)) != -1)
+    if (m_nlDirector.MayMatch(fullinfo) &&
+        (position = fullinfo.indexOf(m_nlDirector)) != -1)
     {
         tmpDirectorString = tmpDirector.cap(0);
         event.AddPerson(DBPerson::kDirector, tmpDirectorString);
@@ -1690,8 +1708,8 @@ void EITFixUp::FixCategory(DBEventEIT &event) const
 void EITFixUp::FixNO(DBEventEIT &event) const
 {
     // Check for "title (R)" in the title
-    int position = event.title.indexOf(m_noRerun);
-    if (position != -1)
+    if (m_noRerun.MayMatch(event.title) &&
+        event.title.indexOf(m_noRerun) != -1)
     {
       event.previouslyshown = true;
       event.title = event.title.replace(m_noRerun, "");
@@ -1706,15 +1724,15 @@ void EITFixUp::FixNRK_DVBT(DBEventEIT &event) const
     int        position;
     QRegExp    tmpExp1;
     // Check for "title (R)" in the title
-    position = event.title.indexOf(m_noRerun);
-    if (position != -1)
+    if (m_noRerun.MayMatch(event.title) &&
+        event.title.indexOf(m_noRerun) != -1)
     {
       event.previouslyshown = true;
       event.title = event.title.replace(m_noRerun, "");
     }
     // Check for "(R)" in the description
-    position = event.description.indexOf(m_noRerun);
-    if (position != -1)
+    if (m_noRerun.MayMatch(event.description) &&
+        event.description.indexOf(m_noRerun) != -1)
     {
       event.previouslyshown = true;
     }
@@ -1727,7 +1745,8 @@ void EITFixUp::FixNRK_DVBT(DBEventEIT &event) const
     }
     // Remove season premiere markings
     tmpExp1 = m_noPremiere;
-    if ((position = tmpExp1.indexIn(event.title)) >=3){
+    if (m_noPremiere.MayMatch(event.title) &&
+        (position = tmpExp1.indexIn(event.title)) >=3){
         event.title.remove(m_noPremiere);
     }
     // Try to find colon-delimited subtitle in title, only tested for NRK channels
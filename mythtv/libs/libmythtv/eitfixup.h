@@ -11,6 +11,28 @@
 
 typedef QMap<uint,uint> QMap_uint_t;
 
+/** \class EITFixUpRegExp
+ *  \brief QRegExp with a literal string that every match must contain.
+ *
+ *  Most events match none of a provider's patterns, so looking for the
+ *  literal with QString::contains() first lets the common case skip
+ *  copying the QRegExp and running the regular expression engine.
+ */
+class EITFixUpRegExp : public QRegExp
+{
+  public:
+    EITFixUpRegExp(const QString &pattern, const QString &_literal,
+                   Qt::CaseSensitivity cs = Qt::CaseSensitive)
+        : QRegExp(pattern, cs), literal(_literal) { }
+
+    /// Returns false if str can not match, true if it might.
+    bool MayMatch(const QString &str) const
+        { return str.contains(literal, caseSensitivity()); }
+
+  private:
+    QString literal;
+};
+
 /// EIT Fix Up Functions
 class EITFixUp
 {
@@ -79,8 +101,7 @@ class EITFixUp
     void SetUKSubtitle(DBEventEIT &event) const;
     void FixUK(DBEventEIT &event) const;            // UK DVB-T
     void FixPBS(DBEventEIT &event) const;           // USA ATSC
-    void FixComHem(DBEventEIT &event,
-                   bool parse_subtitle) const;      // Sweden DVB-C
+    void FixComHem(DBEventEIT &event) const;        // Sweden DVB-C
     void FixAUStar(DBEventEIT &event) const;        // Australia DVB-S
     void FixMCA(DBEventEIT &event) const;           // MultiChoice Africa DVB-S
     void FixRTL(DBEventEIT &event) const;           // RTL group DVB
@@ -95,24 +116,24 @@ class EITFixUp
 
     const QRegExp m_bellYear;
     const QRegExp m_bellActors;
-    const QRegExp m_bellPPVTitleAllDayHD;
-    const QRegExp m_bellPPVTitleAllDay;
-    const QRegExp m_bellPPVTitleHD;
-    const QRegExp m_bellPPVSubtitleAllDay;
-    const QRegExp m_bellPPVDescriptionAllDay;
-    const QRegExp m_bellPPVDescriptionAllDay2;
+    const EITFixUpRegExp m_bellPPVTitleAllDayHD;
+    const EITFixUpRegExp m_bellPPVTitleAllDay;
+    const EITFixUpRegExp m_bellPPVTitleHD;
+    const EITFixUpRegExp m_bellPPVSubtitleAllDay;
+    const EITFixUpRegExp m_bellPPVDescriptionAllDay;
+    const EITFixUpRegExp m_bellPPVDescriptionAllDay2;
     const QRegExp m_bellPPVDescriptionEventId;
-    const QRegExp m_dishPPVTitleHD;
+    const EITFixUpRegExp m_dishPPVTitleHD;
     const QRegExp m_dishPPVTitleColon;
     const QRegExp m_dishPPVSpacePerenEnd;
-    const QRegExp m_dishDescriptionNew;
-    const QRegExp m_dishDescriptionFinale;
-    const QRegExp m_dishDescriptionFinale2;
-    const QRegExp m_dishDescriptionPremiere;
-    const QRegExp m_dishDescriptionPremiere2;
+    const EITFixUpRegExp m_dishDescriptionNew;
+    const EITFixUpRegExp m_dishDescriptionFinale;
+    const EITFixUpRegExp m_dishDescriptionFinale2;
+    const EITFixUpRegExp m_dishDescriptionPremiere;
+    const EITFixUpRegExp m_dishDescriptionPremiere2;
     const QRegExp m_dishPPVCode;
-    const QRegExp m_ukThen;
-    const QRegExp m_ukNew;
+    const EITFixUpRegExp m_ukThen;
+    const EITFixUpRegExp m_ukNew;
     const QRegExp m_ukCEPQ;
     const QRegExp m_ukColonPeriod;
     const QRegExp m_ukDotSpaceStart;
@@ -120,17 +141,17 @@ class EITFixUp
     const QRegExp m_ukSpaceColonStart;
     const QRegExp m_ukSpaceStart;
     const QRegExp m_ukSeries;
-    const QRegExp m_ukCC;
+    const EITFixUpRegExp m_ukCC;
     const QRegExp m_ukYear;
-    const QRegExp m_uk24ep;
-    const QRegExp m_ukStarring;
-    const QRegExp m_ukBBC7rpt;
+    const EITFixUpRegExp m_uk24ep;
+    const EITFixUpRegExp m_ukStarring;
+    const EITFixUpRegExp m_ukBBC7rpt;
     const QRegExp m_ukDescriptionRemove;
-    const QRegExp m_ukTitleRemove;
+    const EITFixUpRegExp m_ukTitleRemove;
     const QRegExp m_ukDoubleDotEnd;
     const QRegExp m_ukDoubleDotStart;
     const QRegExp m_ukTime;
-    const QRegExp m_ukBBC34;
+    const EITFixUpRegExp m_ukBBC34;
     const QRegExp m_ukYearColon;
     const QRegExp m_ukExclusionFromSubtitle;
     const QRegExp m_ukCompleteDots;
@@ -139,9 +160,9 @@ class EITFixUp
     const QRegExp m_comHemActor;
     const QRegExp m_comHemHost;
     const QRegExp m_comHemSub;
-    const QRegExp m_comHemRerun1;
+    const EITFixUpRegExp m_comHemRerun1;
     const QRegExp m_comHemRerun2;
-    const QRegExp m_comHemTT;
+    const EITFixUpRegExp m_comHemTT;
     const QRegExp m_comHemPersSeparator;
     const QRegExp m_comHemPersons;
     const QRegExp m_comHemSubEnd;
@@ -154,44 +175,44 @@ class EITFixUp
     const QRegExp m_mcaSubtitle;
     const QRegExp m_mcaSeries;
     const QRegExp m_mcaCredits;
-    const QRegExp m_mcaAvail;
+    const EITFixUpRegExp m_mcaAvail;
     const QRegExp m_mcaActors;
     const QRegExp m_mcaActorsSeparator;
     const QRegExp m_mcaYear;
-    const QRegExp m_mcaCC;
-    const QRegExp m_mcaDD;
-    const QRegExp m_RTLrepeat;
+    const EITFixUpRegExp m_mcaCC;
+    const EITFixUpRegExp m_mcaDD;
+    const EITFixUpRegExp m_RTLrepeat;
     const QRegExp m_RTLSubtitle;
-    const QRegExp m_RTLSubtitle1;
-    const QRegExp m_RTLSubtitle2;
+    const EITFixUpRegExp m_RTLSubtitle1;
+    const EITFixUpRegExp m_RTLSubtitle2;
     const QRegExp m_RTLSubtitle3;
-    const QRegExp m_RTLSubtitle4;
-    const QRegExp m_RTLSubtitle5;
-    const QRegExp m_RTLEpisodeNo1;
-    const QRegExp m_RTLEpisodeNo2;
-    const QRegExp m_fiRerun;
+    const EITFixUpRegExp m_RTLSubtitle4;
+    const EITFixUpRegExp m_RTLSubtitle5;
+    const EITFixUpRegExp m_RTLEpisodeNo1;
+    const EITFixUpRegExp m_RTLEpisodeNo2;
+    const EITFixUpRegExp m_fiRerun;
     const QRegExp m_fiRerun2;
-    const QRegExp m_dePremiereInfos;
+    const EITFixUpRegExp m_dePremiereInfos;
     const QRegExp m_dePremiereOTitle;
     const QRegExp m_nlTxt;
     const QRegExp m_nlWide;
     const QRegExp m_nlRepeat;
-    const QRegExp m_nlHD;
-    const QRegExp m_nlSub;
-    const QRegExp m_nlActors;
-    const QRegExp m_nlPres;
+    const EITFixUpRegExp m_nlHD;
+    const EITFixUpRegExp m_nlSub;
+    const EITFixUpRegExp m_nlActors;
+    const EITFixUpRegExp m_nlPres;
     const QRegExp m_nlPersSeparator;
     const QRegExp m_nlRub;
-    const QRegExp m_nlYear1;
+    const EITFixUpRegExp m_nlYear1;
     const QRegExp m_nlYear2;
-    const QRegExp m_nlDirector;
+    const EITFixUpRegExp m_nlDirector;
     const QRegExp m_nlCat;
     const QRegExp m_nlOmroep;
-    const QRegExp m_noRerun;
+    const EITFixUpRegExp m_noRerun;
     const QRegExp m_noColonSubtitle;
     const QRegExp m_noNRKCategories;
-    const QRegExp m_noPremiere;
-    const QRegExp m_Stereo;
+    const EITFixUpRegExp m_noPremiere;
+    const EITFixUpRegExp m_Stereo;
 };
 
 #endif // EITFIXUP_H
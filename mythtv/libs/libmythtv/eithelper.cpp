@@ -7,6 +7,11 @@
 #include <algorithm>
 using namespace std;
 
+// Qt headers
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+
 // MythTV includes
 #include "eithelper.h"
 #include "eitfixup.h"
@@ -20,6 +25,7 @@ using namespace std;
 #include "util.h"
 #include "programdata.h"
 #include "programinfo.h" // for subtitle types and audio and video properties
+#include "mythtimer.h"
 
 #ifdef USING_MINGW
     #define gmtime_r( _clock, _result ) \
@@ -27,7 +33,9 @@ using namespace std;
               (_result) )
 #endif
 
-const uint EITHelper::kChunkSize = 20;
+const uint EITHelper::kChunkSize         = 1000;
+const uint EITHelper::kMinParallelFixups = 50;
+const uint EITHelper::kWindowSecs        = 24 * 60 * 60;
 EITCache *EITHelper::eitcache = new EITCache();
 
 static uint get_chan_id_from_db(uint sourceid,
@@ -40,13 +48,45 @@ static int calc_eit_utc_offset(void);
 #define LOC QString("EITHelper: ")
 #define LOC_ERR QString("EITHelper, Error: ")
 
+/** \class EITFixUpRunnable
+ *  \brief Runs EITFixUp::Fix() on a slice of the events being processed.
+ */
+class EITFixUpRunnable : public QRunnable
+{
+  public:
+    EITFixUpRunnable(const EITFixUp *fixup, DBEventEIT **events, uint count,
+                     QSemaphore *done)
+        : m_fixup(fixup), m_events(events), m_count(count), m_done(done) {}
+
+    virtual void run(void)
+    {
+        threadRegister("EITFixUp");
+        for (uint i = 0; i < m_count; i++)
+            m_fixup->Fix(*m_events[i]);
+        threadDeregister();
+        m_done->release();
+    }
+
+  private:
+    const EITFixUp *m_fixup;
+    DBEventEIT    **m_events;
+    uint            m_count;
+    QSemaphore     *m_done;
+};
+
 EITHelper::EITHelper() :
-    eitfixup(new EITFixUp()),
     gps_offset(-1 * GPS_LEAP_SECONDS),          utc_offset(0),
-    sourceid(0)
+    sourceid(0),
+    statEvents(0), statUpdated(0), statWindows(0),
+    statFixupTime(0), statDBTime(0)
 {
     init_fixup(fixup);
 
+    int threads = max(1, min(QThread::idealThreadCount(), 4));
+    fixupPool.setMaxThreadCount(threads);
+    for (int i = 0; i < threads; i++)
+        eitfixups.push_back(new EITFixUp());
+
     utc_offset = calc_eit_utc_offset();
 
     int sign    = utc_offset < 0 ? -1 : +1;
@@ -66,7 +106,9 @@ EITHelper::~EITHelper()
     for (uint i = 0; i < db_events.size(); i++)
         delete db_events.dequeue();
 
-    delete eitfixup;
+    fixupPool.waitForDone();
+    for (uint i = 0; i < eitfixups.size(); i++)
+        delete eitfixups[i];
 }
 
 uint EITHelper::GetListSize(void) const
@@ -78,29 +120,44 @@ uint EITHelper::GetListSize(void) const
 /** \fn EITHelper::ProcessEvents(void)
  *  \brief Inserts events in EIT list.
  *
+ *  Takes up to kChunkSize events off the list, fixes them up in parallel
+ *  and writes them to the DB per channel and time window.
+ *
  *  \return Returns number of events inserted into DB.
  */
 uint EITHelper::ProcessEvents(void)
 {
     QMutexLocker locker(&eitList_lock);
-    uint insertCount = 0;
 
     if (!db_events.size())
         return 0;
 
-    MSqlQuery query(MSqlQuery::InitCon());
-    for (uint i = 0; (i < kChunkSize) && (i < db_events.size()); i++)
-    {
-        DBEventEIT *event = db_events.dequeue();
-        eitList_lock.unlock();
+    vector<DBEventEIT*> events;
+    while (events.size() < kChunkSize && db_events.size())
+        events.push_back(db_events.dequeue());
 
-        eitfixup->Fix(*event);
+    eitList_lock.unlock();
 
-        insertCount += event->UpdateDB(query, 1000);
+    MythTimer t;
+    t.start();
 
-        delete event;
-        eitList_lock.lock();
-    }
+    FixUpEvents(events);
+    uint fixupTime = t.restart();
+
+    uint windows     = 0;
+    uint insertCount = UpdateEvents(events, windows);
+    uint dbTime      = t.elapsed();
+
+    for (uint i = 0; i < events.size(); i++)
+        delete events[i];
+
+    eitList_lock.lock();
+
+    statEvents    += events.size();
+    statUpdated   += insertCount;
+    statWindows   += windows;
+    statFixupTime += fixupTime;
+    statDBTime    += dbTime;
 
     if (!insertCount)
         return 0;
@@ -122,6 +179,105 @@ uint EITHelper::ProcessEvents(void)
     return insertCount;
 }
 
+/** \fn EITHelper::FixUpEvents(vector<DBEventEIT*>&)
+ *  \brief Runs the fixups on the events, split over the fixup pool when
+ *         there are enough of them to be worth it.
+ */
+void EITHelper::FixUpEvents(vector<DBEventEIT*> &events)
+{
+    if (events.size() < kMinParallelFixups || eitfixups.size() < 2)
+    {
+        for (uint i = 0; i < events.size(); i++)
+            eitfixups[0]->Fix(*events[i]);
+        return;
+    }
+
+    uint slices = eitfixups.size();
+    uint size   = (events.size() + slices - 1) / slices;
+    uint queued = 0;
+
+    for (uint i = 0; i < slices; i++)
+    {
+        uint first = i * size;
+        if (first >= events.size())
+            break;
+
+        uint count = min(size, (uint) events.size() - first);
+        fixupPool.start(new EITFixUpRunnable(
+                            eitfixups[i], &events[first], count, &fixupsDone));
+        queued++;
+    }
+
+    // Not QThreadPool::waitForDone(), in Qt 4.6 to 4.8 that also stops
+    // the pool's threads, so every batch would start new ones.
+    fixupsDone.acquire(queued);
+}
+
+static bool event_less_than(const DBEventEIT *a, const DBEventEIT *b)
+{
+    if (a->chanid != b->chanid)
+        return a->chanid < b->chanid;
+    return a->starttime < b->starttime;
+}
+
+/** \fn EITHelper::UpdateEvents(vector<DBEventEIT*>&, uint&)
+ *  \brief Writes the events to the DB, grouped by channel and in windows
+ *         of at most kWindowSecs, so the existing programs are read once
+ *         per window instead of once per event.
+ *
+ *  \return number of events inserted or updated
+ */
+uint EITHelper::UpdateEvents(vector<DBEventEIT*> &events, uint &windows)
+{
+    stable_sort(events.begin(), events.end(), event_less_than);
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    uint updated = 0;
+
+    uint i = 0;
+    while (i < events.size())
+    {
+        uint      chanid = events[i]->chanid;
+        QDateTime limit  = events[i]->starttime.addSecs(kWindowSecs);
+
+        vector<const DBEvent*> window;
+        for (; i < events.size() && events[i]->chanid == chanid &&
+                 events[i]->starttime < limit; i++)
+        {
+            window.push_back(events[i]);
+        }
+
+        updated += DBEvent::UpdateDB(query, chanid, window, 1000);
+        windows++;
+    }
+
+    return updated;
+}
+
+QString EITHelper::GetStatistics(void) const
+{
+    QMutexLocker locker(&eitList_lock);
+
+    uint total = statFixupTime + statDBTime;
+
+    return QString("%1 events processed, %2 added in %3 channel windows. "
+                   "Fixup %4 ms (%5 threads), DB %6 ms, %7 events/s.")
+        .arg(statEvents).arg(statUpdated).arg(statWindows)
+        .arg(statFixupTime).arg(eitfixups.size()).arg(statDBTime)
+        .arg(total ? statEvents * 1000.0 / total : 0.0, 0, 'f', 1);
+}
+
+void EITHelper::ResetStatistics(void)
+{
+    QMutexLocker locker(&eitList_lock);
+
+    statEvents    = 0;
+    statUpdated   = 0;
+    statWindows   = 0;
+    statFixupTime = 0;
+    statDBTime    = 0;
+}
+
 void EITHelper::SetFixup(uint atsc_major, uint atsc_minor, uint eitfixup)
 {
     QMutexLocker locker(&eitList_lock);
@@ -5,11 +5,17 @@
 
 #include <stdint.h>
 
+// C++ includes
+#include <vector>
+using namespace std;
+
 // Qt includes
 #include <QMap>
 #include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
+#include <QSemaphore>
 
 // MythTV includes
 #include "mythdeque.h"
@@ -64,6 +70,9 @@ class EITHelper
     uint GetListSize(void) const;
     uint ProcessEvents(void);
 
+    QString GetStatistics(void) const;
+    void ResetStatistics(void);
+
     uint GetGPSOffset(void) const { return (uint) (0 - gps_offset); }
 
     void SetGPSOffset(uint _gps_offset) { gps_offset = 0 - _gps_offset; }
@@ -97,11 +106,17 @@ class EITHelper
                        const ATSCEvent &event,
                        const QString   &ett);
 
+    void FixUpEvents(vector<DBEventEIT*> &events);
+    uint UpdateEvents(vector<DBEventEIT*> &events, uint &windows);
+
         //QListList_Events  eitList;      ///< Event Information Tables List
     mutable QMutex    eitList_lock; ///< EIT List lock
     mutable ServiceToChanID srv_to_chanid;
 
-    EITFixUp               *eitfixup;
+    /// One per fixup thread, EITFixUp isn't reentrant
+    vector<EITFixUp*>       eitfixups;
+    QThreadPool             fixupPool;
+    QSemaphore              fixupsDone;   ///< released as each slice is done
     static EITCache        *eitcache;
 
     int                     gps_offset;
@@ -115,8 +130,19 @@ class EITHelper
 
     QMap<uint,uint>         languagePreferences;
 
-    /// Maximum number of DB inserts per ProcessEvents call.
+    // statistics, protected by eitList_lock
+    uint                    statEvents;
+    uint                    statUpdated;
+    uint                    statWindows;
+    uint                    statFixupTime;  ///< ms
+    uint                    statDBTime;     ///< ms
+
+    /// Maximum number of events handled per ProcessEvents call.
     static const uint kChunkSize;
+    /// Events below this many are fixed up without the thread pool.
+    static const uint kMinParallelFixups;
+    /// Longest time span of events written with one DBEvent::UpdateDB call.
+    static const uint kWindowSecs;
 };
 
 #endif // EIT_HELPER_H
@@ -122,6 +122,8 @@ void EITScanner::RunEventLoop(void)
         {
             LOG(VB_EIT, LOG_INFO,
                 LOC_ID + QString("Added %1 EIT Events").arg(eitCount));
+            LOG(VB_EIT, LOG_INFO, LOC_ID + eitHelper->GetStatistics());
+            eitHelper->ResetStatistics();
             eitCount = 0;
             RescheduleRecordings();
         }
@@ -133,6 +135,8 @@ void EITScanner::RunEventLoop(void)
             {
                 LOG(VB_EIT, LOG_INFO,
                     LOC_ID + QString("Added %1 EIT Events").arg(eitCount));
+                LOG(VB_EIT, LOG_INFO, LOC_ID + eitHelper->GetStatistics());
+                eitHelper->ResetStatistics();
                 eitCount = 0;
                 RescheduleRecordings();
             }
@@ -350,6 +350,9 @@ bool FileRingBuffer::OpenFile(const QString &lfilename, uint retry_ms)
             QStringList aux = remotefile->GetAuxiliaryFiles();
             if (aux.size())
                 subtitlefilename = dirName + "/" + aux[0];
+
+            remotefile->SetPipelined(
+                gCoreContext->GetNumSetting("RemoteFilePipelining", 1));
         }
     }
 
@@ -23,6 +23,14 @@ typedef struct VideoFilter_ VideoFilter;
 
 typedef VideoFilter*(*init_filter)(int, int, int *, int *, char *, int);
 
+/* Optional entry point that filters the luma rows [top, bottom) of the
+ * frame and the chroma rows belonging to them. Filters that provide it
+ * must work in place on a single format, must not look at rows outside
+ * the band and must not keep state between frames, as bands of one frame
+ * may be filtered concurrently. top is always even, bottom is even or
+ * the frame height. */
+typedef int(*band_filter)(VideoFilter *, VideoFrame *, int, int, int);
+
 typedef struct FilterInfo_
 {
     init_filter filter_init;
@@ -30,6 +38,7 @@ typedef struct FilterInfo_
     char *descript;
     FmtConv *formats;
     char *libname;
+    band_filter filter_band;
 } FilterInfo;
 
 typedef struct ConstFilterInfo_
@@ -39,12 +48,14 @@ typedef struct ConstFilterInfo_
     const char *descript;
     const FmtConv *formats;
     const char *libname;
+    const band_filter filter_band;
 } ConstFilterInfo;
 
 struct VideoFilter_
 {
     int (*filter)(struct VideoFilter_ *, VideoFrame *, int);
     void (*cleanup)(struct VideoFilter_ *);
+    band_filter filter_band; /* set by the filter manager, may be NULL */
 
     void *handle; /* Library handle */
     VideoFrameType inpixfmt;
@@ -53,7 +64,7 @@ struct VideoFilter_
     FilterInfo *info;
 };
 
-#define FILT_NULL {NULL,NULL,NULL,NULL,NULL}
+#define FILT_NULL {NULL,NULL,NULL,NULL,NULL,NULL}
 
 #ifdef TIME_FILTER
 
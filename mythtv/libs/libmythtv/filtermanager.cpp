@@ -7,9 +7,15 @@
 #include "compat.h"
 #endif
 
+// C++ headers
+#include <algorithm>
+
 // Qt headers
 #include <QDir>
 #include <QStringList>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
 
 // MythTV headers
 #include "mythcontext.h"
@@ -39,8 +45,75 @@ static const char *FmtToString(VideoFrameType ft)
     }
 }
 
+const int FilterChain::kBandHeight = 32;
+
+/** \brief Runs filters [first, last] over luma rows [top, bottom),
+ *         kBandHeight rows at a time.
+ */
+static void filter_bands(const vector<VideoFilter*> &filters,
+                         uint first, uint last, VideoFrame *frame,
+                         int field, int top, int bottom, int band_height)
+{
+    for (int band = top; band < bottom; band += band_height)
+    {
+        int end = min(band + band_height, bottom);
+        for (uint i = first; i <= last; i++)
+            filters[i]->filter_band(filters[i], frame, field, band, end);
+    }
+}
+
+class FilterSlice : public QRunnable
+{
+  public:
+    FilterSlice(const vector<VideoFilter*> &f, uint first, uint last,
+                VideoFrame *frame, int field, int top, int bottom,
+                int band_height, QSemaphore *done) :
+        m_filters(f), m_first(first), m_last(last), m_frame(frame),
+        m_field(field), m_top(top), m_bottom(bottom),
+        m_bandHeight(band_height), m_done(done)
+    {
+    }
+
+    virtual void run(void)
+    {
+        filter_bands(m_filters, m_first, m_last, m_frame, m_field,
+                     m_top, m_bottom, m_bandHeight);
+        m_done->release();
+    }
+
+  private:
+    const vector<VideoFilter*> &m_filters;
+    uint        m_first;
+    uint        m_last;
+    VideoFrame *m_frame;
+    int         m_field;
+    int         m_top;
+    int         m_bottom;
+    int         m_bandHeight;
+    QSemaphore *m_done;
+};
+
+FilterChain::FilterChain(int max_threads) :
+    threads(max(max_threads, 1)), pool(NULL), slicesDone(NULL)
+{
+    if (threads > 1)
+    {
+        // the calling thread filters a slice too
+        pool = new QThreadPool();
+        pool->setMaxThreadCount(threads - 1);
+        // filtering a frame is too short to pay for starting threads
+        pool->setExpiryTimeout(-1);
+        slicesDone = new QSemaphore();
+    }
+}
+
 FilterChain::~FilterChain()
 {
+    delete pool;
+    pool = NULL;
+    delete slicesDone;
+    slicesDone = NULL;
+
     vector<VideoFilter*>::iterator it = filters.begin();
     for (; it != filters.end(); ++it)
     {
@@ -60,9 +133,61 @@ void FilterChain::ProcessFrame(VideoFrame *frame, FrameScanType scan)
     if (!frame)
         return;
 
-    vector<VideoFilter*>::iterator it = filters.begin();
-    for (; it != filters.end(); ++it)
-        (*it)->filter(*it, frame, kScan_Intr2ndField == scan);
+    int field = kScan_Intr2ndField == scan;
+
+    // Filters without a band entry point see the whole frame, the runs
+    // of band filters between them are fused.
+    uint i = 0;
+    while (i < filters.size())
+    {
+        if (!filters[i]->filter_band)
+        {
+            filters[i]->filter(filters[i], frame, field);
+            i++;
+            continue;
+        }
+
+        uint last = i;
+        while (last + 1 < filters.size() && filters[last + 1]->filter_band)
+            last++;
+
+        ProcessBands(frame, field, i, last);
+        i = last + 1;
+    }
+}
+
+/** \fn FilterChain::ProcessBands(VideoFrame*,int,uint,uint)
+ *  \brief Runs the band filters [first, last] over the frame, splitting
+ *         it into one slice per thread.
+ */
+void FilterChain::ProcessBands(VideoFrame *frame, int field,
+                               uint first, uint last)
+{
+    int height = frame->height;
+    int slice  = (height + threads - 1) / threads;
+    slice = (slice + kBandHeight - 1) / kBandHeight * kBandHeight;
+
+    if (!pool || slice >= height)
+    {
+        filter_bands(filters, first, last, frame, field,
+                     0, height, kBandHeight);
+        return;
+    }
+
+    int top    = 0;
+    int queued = 0;
+    for (; top + slice < height; top += slice, queued++)
+    {
+        pool->start(new FilterSlice(filters, first, last, frame, field,
+                                    top, top + slice, kBandHeight,
+                                    slicesDone));
+    }
+    filter_bands(filters, first, last, frame, field,
+                 top, height, kBandHeight);
+
+    // Not QThreadPool::waitForDone(), in Qt 4.6 to 4.8 that also stops
+    // the pool's threads, so they would be started again for every frame.
+    slicesDone->acquire(queued);
 }
 
 FilterManager::FilterManager()
@@ -174,6 +299,7 @@ bool FilterManager::LoadFilterLib(const QString &path)
 
         QByteArray libname = path.toAscii();
         newFilter->libname = strdup(libname.constData());
+        newFilter->filter_band = NULL;
         filters[newFilter->name] = newFilter;
         LOG(VB_PLAYBACK, LOG_DEBUG, LOC + QString("filters[%1] = 0x%2")
                 .arg(newFilter->name).arg((uint64_t)newFilter,0,16));
@@ -204,7 +330,7 @@ FilterChain *FilterManager::LoadFilters(QString Filters,
         return NULL;
 
     vector<const FilterInfo*> FiltInfoChain;
-    FilterChain *FiltChain = new FilterChain;
+    FilterChain *FiltChain = new FilterChain(max_threads);
     vector<FmtConv*> FmtList;
     const FilterInfo *FI;
     const FilterInfo *FI2;
@@ -549,6 +675,7 @@ VideoFilter * FilterManager::LoadFilter(const FilterInfo *FiltInfo,
     }
 
     Filter->handle = handle;
+    Filter->filter_band = filtInfo->filter_band;
     Filter->inpixfmt = inpixfmt;
     Filter->outpixfmt = outpixfmt;
     if (opts)
@@ -14,15 +14,26 @@ using namespace std;
 // Qt headers
 #include <QString>
 
+class QThreadPool;
+class QSemaphore;
+
 typedef map<QString,void*>       library_map_t;
 typedef map<QString,FilterInfo*> filter_map_t;
 
 #include "videoouttypes.h"
 
+/** \class FilterChain
+ *  \brief Runs a list of filters over each frame.
+ *
+ *   Consecutive filters that can filter a band of rows are run together
+ *   one band at a time, so a band is still in the cache when the next
+ *   filter gets to it. With more than one thread the frame is also split
+ *   into horizontal slices that are filtered concurrently.
+ */
 class FilterChain
 {
   public:
-    FilterChain() { }
+    FilterChain(int max_threads = 1);
     virtual ~FilterChain();
 
     void ProcessFrame(VideoFrame *Frame, FrameScanType scan = kScan_Ignore);
@@ -30,7 +41,16 @@ class FilterChain
     void Append(VideoFilter *f) { filters.push_back(f); }
 
   private:
+    void ProcessBands(VideoFrame *frame, int field,
+                      uint first, uint last);
+
     vector<VideoFilter*> filters;
+    int                  threads;
+    QThreadPool         *pool;
+    QSemaphore          *slicesDone;  ///< released as each slice finishes
+
+    /// Luma rows each fused filter run works on at a time
+    static const int kBandHeight;
 };
 
 class FilterManager
@@ -3,6 +3,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <iostream>
+#include <algorithm>
 #include <cstdlib>
 #include <fcntl.h>
 using namespace std;
@@ -23,6 +24,7 @@ using namespace std;
 #include "compat.h"
 #include "recordingprofile.h"
 #include "recordinginfo.h"
+#include "remoteutil.h"
 
 #include "mythdb.h"
 #include "mythdirs.h"
@@ -46,6 +48,32 @@ void QueueProcessorThread::run(void)
 #define LOC     QString("JobQueue: ")
 #define LOC_ERR QString("JobQueue Error: ")
 
+/// Approximate resources used by each job type, charged against the
+/// per-host JobQueueCPUSlots and JobQueueIOSlots budgets.
+static void GetJobSlotCost(int jobType, int &cpu, int &io)
+{
+    switch (jobType)
+    {
+        case JOB_TRANSCODE:
+            cpu = 2;
+            io  = 1;
+            break;
+        case JOB_COMMFLAG:
+            cpu = 1;
+            io  = 1;
+            break;
+        case JOB_METADATA:
+            cpu = 0;
+            io  = 0;
+            break;
+        default:
+            // user jobs are opaque, assume they behave like a commflag run
+            cpu = 1;
+            io  = 1;
+            break;
+    }
+}
+
 JobQueue::JobQueue(bool master) :
     m_hostname(gCoreContext->GetHostName()),
     jobsRunning(0),
@@ -54,7 +82,8 @@ JobQueue::JobQueue(bool master) :
     runningJobsLock(new QMutex(QMutex::Recursive)),
     isMaster(master),
     queueThread(new QueueProcessorThread(this)),
-    processQueue(false)
+    processQueue(false),
+    queueCheckPending(false)
 {
     jobQueueCPU = gCoreContext->GetNumSetting("JobQueueCPU", 0);
 
@@ -148,9 +177,24 @@ void JobQueue::customEvent(QEvent *e)
                 runningJobsLock->unlock();
             }
         }
+        else if (message == "JOBQUEUE_CHECK")
+        {
+            WakeQueueProcessor();
+        }
     }
 }
 
+/** \fn JobQueue::WakeQueueProcessor(void)
+ *  \brief Makes the queue processor run another pass right away instead
+ *         of waiting for JobQueueCheckFrequency to expire.
+ */
+void JobQueue::WakeQueueProcessor(void)
+{
+    QMutexLocker locker(&queueThreadCondLock);
+    queueCheckPending = true;
+    queueThreadCond.wakeAll();
+}
+
 void JobQueue::RunQueueProcessor(void)
 {
     queueThreadCondLock.lock();
@@ -180,33 +224,48 @@ void JobQueue::ProcessQueue(void)
 
     QMap<int, int> jobStatus;
     int maxJobs;
+    int cpuSlots;
+    int ioSlots;
+    int cpuUsed;
+    int ioUsed;
+    int cpuCost;
+    int ioCost;
     QString message;
     QMap<int, JobQueueEntry> jobs;
     bool atMax = false;
     bool inTimeWindow = true;
-    bool startedJobAlready = false;
     QMap<int, RunningJobInfo>::Iterator rjiter;
 
     QMutexLocker locker(&queueThreadCondLock);
     while (processQueue)
     {
+        queueCheckPending = false;
         locker.unlock();
 
-        startedJobAlready = false;
         sleepTime = gCoreContext->GetNumSetting("JobQueueCheckFrequency", 30);
         maxJobs = gCoreContext->GetNumSetting("JobQueueMaxSimultaneousJobs", 3);
+        cpuSlots = gCoreContext->GetNumSetting("JobQueueCPUSlots", 0);
+        ioSlots = gCoreContext->GetNumSetting("JobQueueIOSlots", 0);
         LOG(VB_JOBQUEUE, LOG_INFO, LOC +
-            QString("Currently set to run up to %1 job(s) max.")
-                        .arg(maxJobs));
+            QString("Currently set to run up to %1 job(s) max, "
+                    "%2 CPU slot(s), %3 IO slot(s).")
+                        .arg(maxJobs).arg(cpuSlots).arg(ioSlots));
 
         jobStatus.clear();
 
+        cpuUsed = 0;
+        ioUsed = 0;
+
         runningJobsLock->lock();
         for (rjiter = runningJobs.begin(); rjiter != runningJobs.end();
             ++rjiter)
         {
             if ((*rjiter).pginfo)
                 (*rjiter).pginfo->UpdateInUseMark();
+
+            GetJobSlotCost((*rjiter).type, cpuCost, ioCost);
+            cpuUsed += cpuCost;
+            ioUsed += ioCost;
         }
         runningJobsLock->unlock();
 
@@ -434,9 +493,24 @@ void JobQueue::ProcessQueue(void)
                     continue;
                 }
 
-                // never start or claim more than one job in a single run
-                if (startedJobAlready)
+                // Leave the job for a later pass (or another backend) if
+                // starting it would exceed this host's resource budgets.
+                GetJobSlotCost(jobs[x].type, cpuCost, ioCost);
+                if ((inTimeWindow) &&
+                    (((cpuSlots > 0) && (cpuCost > 0) &&
+                      (cpuUsed + cpuCost > cpuSlots)) ||
+                     ((ioSlots > 0) && (ioCost > 0) &&
+                      (ioUsed + ioCost > ioSlots))))
+                {
+                    message = QString("Skipping '%1' job for %2, "
+                                      "not enough free slots "
+                                      "(CPU %3/%4, IO %5/%6)")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo)
+                                      .arg(cpuUsed).arg(cpuSlots)
+                                      .arg(ioUsed).arg(ioSlots);
+                    LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
                     continue;
+                }
 
                 if ((inTimeWindow) &&
                     (hostname.isEmpty()) &&
@@ -464,19 +538,21 @@ void JobQueue::ProcessQueue(void)
                                   .arg(StatusText(status));
                 LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
 
+                RecordJobWait(jobs[x]);
                 ProcessJob(jobs[x]);
 
-                startedJobAlready = true;
+                jobsRunning++;
+                cpuUsed += cpuCost;
+                ioUsed += ioCost;
             }
         }
 
+        // QueueJob() and finished jobs wake us up through
+        // WakeQueueProcessor(), the timeout only catches changes made
+        // directly in the database.
         locker.relock();
-        if (processQueue)
-        {
-            int st = (startedJobAlready) ? (5 * 1000) : (sleepTime * 1000);
-            if (st > 0)
-                queueThreadCond.wait(locker.mutex(), st);
-        }
+        if (processQueue && !queueCheckPending && (sleepTime > 0))
+            queueThreadCond.wait(locker.mutex(), sleepTime * 1000);
     }
 }
 
@@ -586,6 +662,8 @@ bool JobQueue::QueueJob(int jobType, uint chanid, const QDateTime &recstartts,
         return false;
     }
 
+    RemoteSendMessage("JOBQUEUE_CHECK");
+
     return true;
 }
 
@@ -1805,6 +1883,74 @@ void JobQueue::RemoveRunningJob(int id)
     }
 
     runningJobsLock->unlock();
+
+    // Our slots are free again, and jobs on other backends may have been
+    // waiting for this one to finish.
+    WakeQueueProcessor();
+    RemoteSendMessage("JOBQUEUE_CHECK");
+}
+
+/** \fn JobQueue::RecordJobWait(const JobQueueEntry&)
+ *  \brief Adds the time a job spent waiting in the queue to the per
+ *         job type statistics shown on the status page.
+ */
+void JobQueue::RecordJobWait(const JobQueueEntry &job)
+{
+    QDateTime queued = job.inserttime;
+    if (job.schedruntime.isValid() && (job.schedruntime > queued))
+        queued = job.schedruntime;
+
+    int wait = max(queued.secsTo(QDateTime::currentDateTime()), 0);
+
+    QMutexLocker locker(&statsLock);
+
+    if (!waitStats.contains(job.type))
+    {
+        JobQueueWaitStats stats;
+        stats.started   = 0;
+        stats.totalWait = 0;
+        stats.maxWait   = 0;
+        stats.lastWait  = 0;
+        waitStats[job.type] = stats;
+    }
+
+    JobQueueWaitStats &stats = waitStats[job.type];
+    stats.started++;
+    stats.totalWait += wait;
+    stats.maxWait    = max(stats.maxWait, wait);
+    stats.lastWait   = wait;
+}
+
+/** \fn JobQueue::GetSlotStatus(JobQueueSlotStatus&)
+ *  \brief Returns the current slot occupancy of this host and the queue
+ *         wait statistics of the jobs it has started.
+ */
+void JobQueue::GetSlotStatus(JobQueueSlotStatus &status)
+{
+    int cpuCost;
+    int ioCost;
+
+    status.jobsRunning = 0;
+    status.cpuUsed     = 0;
+    status.ioUsed      = 0;
+    status.maxJobs     =
+        gCoreContext->GetNumSetting("JobQueueMaxSimultaneousJobs", 3);
+    status.cpuSlots    = gCoreContext->GetNumSetting("JobQueueCPUSlots", 0);
+    status.ioSlots     = gCoreContext->GetNumSetting("JobQueueIOSlots", 0);
+
+    runningJobsLock->lock();
+    QMap<int, RunningJobInfo>::const_iterator it = runningJobs.begin();
+    for (; it != runningJobs.end(); ++it)
+    {
+        GetJobSlotCost((*it).type, cpuCost, ioCost);
+        status.jobsRunning++;
+        status.cpuUsed += cpuCost;
+        status.ioUsed  += ioCost;
+    }
+    runningJobsLock->unlock();
+
+    QMutexLocker locker(&statsLock);
+    status.waitStats = waitStats;
 }
 
 QString JobQueue::PrettyPrint(off_t bytes)
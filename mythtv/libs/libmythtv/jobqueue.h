@@ -111,6 +111,23 @@ typedef struct runningjobinfo {
     ProgramInfo *pginfo;
 } RunningJobInfo;
 
+typedef struct jobqueuewaitstats {
+    int          started;
+    qint64       totalWait;     // seconds
+    int          maxWait;
+    int          lastWait;
+} JobQueueWaitStats;
+
+typedef struct jobqueueslotstatus {
+    int          jobsRunning;
+    int          maxJobs;
+    int          cpuUsed;
+    int          cpuSlots;      // 0 means no limit
+    int          ioUsed;
+    int          ioSlots;       // 0 means no limit
+    QMap<int, JobQueueWaitStats> waitStats;   // keyed by job type
+} JobQueueSlotStatus;
+
 class JobQueue;
 
 class QueueProcessorThread : public QThread
@@ -208,6 +225,8 @@ class MTV_PUBLIC JobQueue : public QObject
                                       { RecoverQueue(true); }
     static void CleanupOldJobsInQueue();
 
+    void GetSlotStatus(JobQueueSlotStatus &status);
+
   private:
     typedef struct jobthreadstruct
     {
@@ -217,6 +236,7 @@ class MTV_PUBLIC JobQueue : public QObject
 
     void RunQueueProcessor(void);
     void ProcessQueue(void);
+    void WakeQueueProcessor(void);
 
     void ProcessJob(JobQueueEntry job);
 
@@ -229,6 +249,7 @@ class MTV_PUBLIC JobQueue : public QObject
     QString GetJobDescription(int jobType);
     QString GetJobCommand(int id, int jobType, ProgramInfo *tmpInfo);
     void RemoveRunningJob(int id);
+    void RecordJobWait(const JobQueueEntry &job);
 
     static QString PrettyPrint(off_t bytes);
 
@@ -263,6 +284,10 @@ class MTV_PUBLIC JobQueue : public QObject
     QWaitCondition queueThreadCond;
     QMutex queueThreadCondLock;
     bool processQueue;
+    bool queueCheckPending;
+
+    QMutex statsLock;
+    QMap<int, JobQueueWaitStats> waitStats;
 };
 
 #endif
@@ -2,13 +2,9 @@
 #include "H264Parser.h"
 #include <iostream>
 #include "mythlogging.h"
+#include "startcode.h"
 
 extern "C" {
-// from libavcodec
-    extern const uint8_t *ff_find_start_code(const uint8_t * p,
-                                             const uint8_t *end,
-                                             uint32_t * state);
-    
 #include "libavcodec/avcodec.h"
 #include "libavutil/internal.h"
 #include "libavcodec/golomb.h"
@@ -351,8 +347,13 @@ bool H264Parser::fillRBSP(const uint8_t *byteP, uint32_t byte_count,
         rbsp_buffer_size = required_size;
     }
 
+    /* Only the slice header is parsed from slices, don't unescape the
+     * slice data behind it. */
+    const uint32_t max_index = NALisSlice(nal_unit_type) ?
+        (uint32_t)MAX_SLICE_HEADER_SIZE : rbsp_index + byte_count;
+
     /* Fill rbsp while we have data */
-    while (byte_count)
+    while (byte_count && rbsp_index < max_index)
     {
         /* Copy the byte into the rbsp, unless it
          * is the 0x03 in a 0x000003 */
@@ -371,8 +372,9 @@ bool H264Parser::fillRBSP(const uint8_t *byteP, uint32_t byte_count,
     /* If we've found the next start code then that, plus the first byte of
      * the next NAL, plus the preceding zero bytes will all be in the rbsp
      * buffer. Move rbsp_index++ back to the end of the actual rbsp data. We
-     * need to know the correct size of the rbsp to decode some NALs. */
-    if (found_start_code)
+     * need to know the correct size of the rbsp to decode some NALs.
+     * If we stopped short of it the start code isn't in the buffer. */
+    if (found_start_code && !byte_count)
     {
         if (rbsp_index >= 4)
         {
@@ -409,8 +411,8 @@ uint32_t H264Parser::addBytes(const uint8_t  *bytes,
 
     while (startP < bytes + byte_count && !on_frame)
     {
-        endP = ff_find_start_code(startP,
-                                  bytes + byte_count, &sync_accumulator);
+        endP = find_start_code(startP,
+                               bytes + byte_count, &sync_accumulator);
 
         found_start_code = ((sync_accumulator & 0xffffff00) == 0x00000100);
 
@@ -1,4 +1,7 @@
 
+// Qt header
+#include <QMutex>
+
 #include "atsc_huffman.h"
 
 /*------------------------------------------------------------------------
@@ -26,6 +29,33 @@ extern struct huffman_table Table255[];
 extern unsigned char Huff2Lookup128[];
 extern unsigned char Huff2Lookup256[];
 
+/* The decoders below first try to resolve a whole code with one lookup in
+ * tables built from the ones above by huffman_init_lookup(), and only walk
+ * the code bit by bit where a lookup can't, e.g. at the end of the input.
+ *
+ * huffman1_lookup[table][previous character][next 8 bits] holds either
+ * HUFF1_LEAF | bits << 8 | character, the tree node reached after 8 bits,
+ * or HUFF1_SLOW.
+ *
+ * huffman2_lookup128/256[next max_size bits] holds the character and the
+ * length of the code, or a length of 0 if there is no code. */
+#define HUFF1_LOOKUP_BITS  8
+#define HUFF1_LOOKUP_SIZE  (1 << HUFF1_LOOKUP_BITS)
+#define HUFF1_LEAF         0x8000
+#define HUFF1_SLOW         0x4000
+
+struct huffman2_lookup_entry {
+    unsigned char character;
+    unsigned char number_of_bits;
+};
+
+static unsigned short huffman1_lookup[2][128][HUFF1_LOOKUP_SIZE];
+static struct huffman2_lookup_entry huffman2_lookup128[1 << 12];
+static struct huffman2_lookup_entry huffman2_lookup256[1 << 14];
+static QMutex        huffman_lookup_lock;
+static volatile bool huffman_lookup_exists = false;
+static void huffman_init_lookup(void);
+
 /* returns the root for character input from table Table[] */
 static inline int huffman1_get_root(uint input, const unsigned char *table)
 {
@@ -40,23 +70,56 @@ static inline bool huffman1_get_bit(const unsigned char *src, uint bit)
     return (src[(bit - (bit & 0x7)) >> 3] >> (7 - (bit & 0x7))) & 0x01;
 }
 
+/* Returns the 8 bits starting at bit number bit from src[] */
+static inline uint huffman1_get_byte(const unsigned char *src, uint bit)
+{
+    uint i = bit >> 3, s = bit & 0x7;
+    return s ? ((src[i] << s) | (src[i + 1] >> (8 - s))) & 0xff : src[i];
+}
+
 QString atsc_huffman1_to_string(const unsigned char *compressed,
                                 uint size, uint table_index)
 {
     QString retval = "";
 
+    if (!huffman_lookup_exists)
+        huffman_init_lookup();
+
     const unsigned char *table = atsc_tables[table_index];
+    const unsigned short (*lookup)[HUFF1_LOOKUP_SIZE] =
+        huffman1_lookup[table_index - 1];
     int totalbits = size * 8;
     int bit = 0;
     int root = huffman1_get_root(0, table);
+    uint prev = 0;
     int node = 0;
     bool thebit;
     unsigned char val;
 
     while (bit < totalbits)
     {
-        thebit = huffman1_get_bit(compressed, bit);
-        val = (thebit) ? table[root + (node*2) + 1] : table[root + (node*2)];
+        uint entry = HUFF1_SLOW;
+        if (!node && (bit + HUFF1_LOOKUP_BITS <= totalbits))
+            entry = lookup[prev][huffman1_get_byte(compressed, bit)];
+
+        if (entry & HUFF1_LEAF)
+        {
+            /* Whole code resolved, continue at its last bit */
+            bit += ((entry >> 8) & 0xf) - 1;
+            val = 0x80 | (entry & 0x7f);
+        }
+        else if (!(entry & HUFF1_SLOW))
+        {
+            /* No code is complete after 8 bits, continue from that node */
+            node = entry;
+            bit += HUFF1_LOOKUP_BITS;
+            continue;
+        }
+        else
+        {
+            thebit = huffman1_get_bit(compressed, bit);
+            val = (thebit) ? table[root + (node*2) + 1] : table[root + (node*2)];
+        }
 
         if (val & 0x80)
         {
@@ -77,11 +140,13 @@ QString atsc_huffman1_to_string(const unsigned char *compressed,
                 retval += QChar(val2);
                 bit += 8;
                 root = huffman1_get_root(val2, table);
+                prev = val2;
             }
             /* Standard Character */
             else
             {
                 root = huffman1_get_root(val & 0x7F, table);
+                prev = val & 0x7F;
                 retval += QChar(val & 0x7F);
             }
             node = 0;
@@ -116,11 +181,26 @@ static inline void huffman2_set_pos(unsigned char &bitpos,
     bitpos  = 0x80 >> (pos & 0x7);
 }
 
+/* Returns the count bits starting at bit number pos from buffer */
+static inline uint huffman2_get_bits(const unsigned char *buffer,
+                                     uint pos, uint count)
+{
+    uint first = pos >> 3;
+    uint last  = (pos + count - 1) >> 3;
+    uint bits  = 0;
+    for (uint i = first; i <= last; i++)
+        bits = (bits << 8) | buffer[i];
+    return (bits >> (((last + 1) << 3) - pos - count)) & ((1 << count) - 1);
+}
+
 QString atsc_huffman2_to_string(const unsigned char *compressed,
                                 uint length, uint table)
 {
     QString decompressed = "";
 
+    if (!huffman_lookup_exists)
+        huffman_init_lookup();
+
     unsigned char        bitpos;
     const unsigned char *bufptr;
     huffman2_set_pos(bitpos, &bufptr, compressed, 0);
@@ -128,12 +208,14 @@ QString atsc_huffman2_to_string(const unsigned char *compressed,
     // Determine which huffman table to use
     struct huffman_table *ptrTable;
     const unsigned char  *lookup;
+    const struct huffman2_lookup_entry *fast;
     uint                  min_size;
     uint                  max_size;
     if (table == 1)
     {
         ptrTable = Table128;
         lookup   = Huff2Lookup128;
+        fast     = huffman2_lookup128;
         min_size = 3;
         max_size = 12;
     }
@@ -141,6 +223,7 @@ QString atsc_huffman2_to_string(const unsigned char *compressed,
     {
         ptrTable = Table255;
         lookup   = Huff2Lookup256;
+        fast     = huffman2_lookup256;
         min_size = 2;
         max_size = 14;
     }
@@ -152,6 +235,23 @@ QString atsc_huffman2_to_string(const unsigned char *compressed,
 
     while (current_bit + 3 < total_bits)
     {
+        // Decode with a single lookup while max_size bits are left
+        if (current_bit + max_size <= total_bits)
+        {
+            const struct huffman2_lookup_entry &entry =
+                fast[huffman2_get_bits(compressed, current_bit, max_size)];
+            if (entry.number_of_bits)
+            {
+                decompressed += entry.character;
+                current_bit += entry.number_of_bits;
+            }
+            else
+                current_bit++;
+            continue;
+        }
+
+        huffman2_set_pos(bitpos, &bufptr, compressed, current_bit);
+
         uint cur_size = 0;
         uint bits     = 0;
 
@@ -2333,3 +2433,72 @@ unsigned char Huff2Lookup256[] =
     0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
     0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff,
 };
+
+static void huffman1_build_lookup(unsigned short lookup[][HUFF1_LOOKUP_SIZE],
+                                  const unsigned char *table, uint table_size)
+{
+    for (uint prev = 0; prev < 128; prev++)
+    {
+        int root = huffman1_get_root(prev, table);
+        for (uint slot = 0; slot < HUFF1_LOOKUP_SIZE; slot++)
+        {
+            uint entry = HUFF1_SLOW;
+            uint node  = 0;
+            uint i     = 0;
+            for (; i < HUFF1_LOOKUP_BITS; i++)
+            {
+                uint thebit = (slot >> (HUFF1_LOOKUP_BITS - 1 - i)) & 0x1;
+                uint index  = root + (node*2) + thebit;
+                if (index >= table_size)
+                    break;
+                unsigned char val = table[index];
+                if (val & 0x80)
+                {
+                    entry = HUFF1_LEAF | ((i + 1) << 8) | (val & 0x7F);
+                    break;
+                }
+                node = val;
+            }
+            if (i == HUFF1_LOOKUP_BITS)
+                entry = node;
+            lookup[prev][slot] = entry;
+        }
+    }
+}
+
+static void huffman2_build_lookup(struct huffman2_lookup_entry *fast,
+                                  const struct huffman_table *ptrTable,
+                                  const unsigned char *lookup,
+                                  uint min_size, uint max_size)
+{
+    for (uint slot = 0; slot < (1U << max_size); slot++)
+    {
+        fast[slot].character      = 0;
+        fast[slot].number_of_bits = 0;
+        for (uint cur_size = min_size; cur_size < max_size; cur_size++)
+        {
+            uint key = lookup[slot >> (max_size - cur_size)];
+            if (key && (ptrTable[key].number_of_bits == cur_size))
+            {
+                fast[slot].character      = ptrTable[key].character;
+                fast[slot].number_of_bits = cur_size;
+                break;
+            }
+        }
+    }
+}
+
+static void huffman_init_lookup(void)
+{
+    QMutexLocker locker(&huffman_lookup_lock);
+
+    if (huffman_lookup_exists)
+        return;
+
+    huffman1_build_lookup(huffman1_lookup[0], ATSC_C5, sizeof(ATSC_C5));
+    huffman1_build_lookup(huffman1_lookup[1], ATSC_C7, sizeof(ATSC_C7));
+    huffman2_build_lookup(huffman2_lookup128, Table128, Huff2Lookup128, 3, 12);
+    huffman2_build_lookup(huffman2_lookup256, Table255, Huff2Lookup256, 2, 14);
+
+    huffman_lookup_exists = true;
+}
@@ -1,3 +1,6 @@
+// Qt header
+#include <QMutex>
+
 #include "freesat_huffman.h"
 
 struct fsattab {
@@ -12,6 +15,87 @@ struct fsattab {
 
 #include "freesat_tables.h"
 
+/* Codes of up to FSAT_LOOKUP_BITS bits are decoded with one lookup in a
+ * table indexed by the previous character and the next FSAT_LOOKUP_BITS
+ * bits of input.  For longer codes the lookup gives the fsat_table entry
+ * to start searching from. */
+#define FSAT_LOOKUP_BITS  8
+#define FSAT_LOOKUP_SIZE  (1 << FSAT_LOOKUP_BITS)
+#define FSAT_CONTEXTS     128
+#define FSAT_DIRECT       0x8000
+
+static unsigned short fsat_lookup[2][FSAT_CONTEXTS][FSAT_LOOKUP_SIZE];
+static QMutex         fsat_lookup_lock;
+static volatile bool  fsat_lookup_exists = false;
+
+static void fsat_build_lookup(unsigned short lookup[][FSAT_LOOKUP_SIZE],
+                              const struct fsattab *table,
+                              const unsigned int *index)
+{
+    for (unsigned ctx = 0; ctx < FSAT_CONTEXTS; ctx++)
+    {
+        for (unsigned slot = 0; slot < FSAT_LOOKUP_SIZE; slot++)
+        {
+            unsigned value = slot << (32 - FSAT_LOOKUP_BITS);
+            unsigned short entry = index[ctx+1];
+
+            // Same search order as the bit by bit decoder, so the first
+            // entry that matches, or may match, wins.
+            for (unsigned j = index[ctx]; j < index[ctx+1]; j++)
+            {
+                if (table[j].bits > FSAT_LOOKUP_BITS)
+                {
+                    if ((table[j].value >> (32 - FSAT_LOOKUP_BITS)) == slot)
+                    {
+                        entry = j;
+                        break;
+                    }
+                    continue;
+                }
+
+                unsigned mask = 0, maskbit = 0x80000000;
+                for (short kk = 0; kk < table[j].bits; kk++)
+                {
+                    mask |= maskbit;
+                    maskbit >>= 1;
+                }
+                if ((value & mask) == table[j].value)
+                {
+                    entry = FSAT_DIRECT | (table[j].bits << 8) |
+                        (unsigned char)table[j].next;
+                    break;
+                }
+            }
+
+            lookup[ctx][slot] = entry;
+        }
+    }
+}
+
+static void fsat_init_lookup(void)
+{
+    QMutexLocker locker(&fsat_lookup_lock);
+
+    if (fsat_lookup_exists)
+        return;
+
+    fsat_build_lookup(fsat_lookup[0], fsat_table_1, fsat_index_1);
+    fsat_build_lookup(fsat_lookup[1], fsat_table_2, fsat_index_2);
+
+    fsat_lookup_exists = true;
+}
+
+/* Returns the 32 bits of src starting at bit pos, zero past size bytes */
+static inline unsigned fsat_get_bits(const unsigned char *src, uint size,
+                                     unsigned pos)
+{
+    unsigned byte = pos >> 3;
+    unsigned long long bits = 0;
+    for (unsigned i = 0; i < 5; i++)
+        bits = (bits << 8) | ((byte + i < size) ? src[byte + i] : 0);
+    return (unsigned)(bits >> (8 - (pos & 7)));
+}
+
 QString freesat_huffman_to_string(const unsigned char *src, uint size)
 {
     struct fsattab *fsat_table;
@@ -19,6 +103,9 @@ QString freesat_huffman_to_string(const unsigned char *src, uint size)
 
     if (src[1] == 1 || src[1] == 2)
     {
+        if (!fsat_lookup_exists)
+            fsat_init_lookup();
+
         if (src[1] == 1)
         {
             fsat_table = fsat_table_1;
@@ -27,6 +114,8 @@ QString freesat_huffman_to_string(const unsigned char *src, uint size)
             fsat_table = fsat_table_2;
             fsat_index = fsat_index_2;
         }
+        const unsigned short (*lookup)[FSAT_LOOKUP_SIZE] =
+            fsat_lookup[src[1] - 1];
         QByteArray uncompressed(size * 3, '\0');
         int p = 0;
         unsigned value = 0, byte = 2, bit = 0;
@@ -59,7 +148,17 @@ QString freesat_huffman_to_string(const unsigned char *src, uint size)
             else
             {
                 unsigned indx = (unsigned)lastch;
-                for (unsigned j = fsat_index[indx]; j < fsat_index[indx+1]; j++)
+                unsigned short entry =
+                    lookup[indx][value >> (32 - FSAT_LOOKUP_BITS)];
+                if (entry & FSAT_DIRECT)
+                {
+                    nextCh = (char)(entry & 0xff);
+                    bitShift = (entry >> 8) & 0x7f;
+                    found = true;
+                    lastch = nextCh;
+                }
+                // Longer code, search the table from the given entry
+                for (unsigned j = entry; !found && j < fsat_index[indx+1]; j++)
                 {
                     unsigned mask = 0, maskbit = 0x80000000;
                     for (short kk = 0; kk < fsat_table[j].bits; kk++)
@@ -86,17 +185,15 @@ QString freesat_huffman_to_string(const unsigned char *src, uint size)
                     uncompressed[p++] = nextCh;
                 }
                 // Shift up by the number of bits.
-                for (unsigned b = 0; b < bitShift; b++)
+                if (bitShift)
                 {
-                    value = (value << 1) & 0xfffffffe;
-                    if (byte < size)
-                        value |= (src[byte] >> (7-bit)) & 1;
-                    if (bit == 7)
-                    {
-                        bit = 0;
-                        byte++;
-                    }
-                    else bit++;
+                    unsigned pos  = byte * 8 + bit;
+                    unsigned next = fsat_get_bits(src, size, pos);
+                    value = (bitShift < 32) ?
+                        (value << bitShift) | (next >> (32 - bitShift)) : next;
+                    pos  += bitShift;
+                    byte  = pos >> 3;
+                    bit   = pos & 7;
                 }
             }
             else
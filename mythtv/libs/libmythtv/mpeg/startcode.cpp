@@ -0,0 +1,61 @@
+// -*- Mode: c++ -*-
+#include <cstring>
+
+#include "startcode.h"
+
+/// Returns non-zero if any of the eight bytes in x is zero
+static inline uint64_t has_zero_byte(uint64_t x)
+{
+    return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+
+const uint8_t *find_start_code(const uint8_t *p, const uint8_t *end,
+                               uint32_t *state)
+{
+    if (p >= end)
+        return end;
+
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t tmp = *state << 8;
+        *state = tmp + *(p++);
+        if (tmp == 0x100 || p == end)
+            return p;
+    }
+
+    // p is the candidate for the byte after 00 00 01, so p[-3] >= start
+    while (p < end)
+    {
+        // A start code ending at any of p .. p+7 needs a zero byte
+        // in p[-2] .. p[5].
+        while (p + 6 <= end)
+        {
+            uint64_t x;
+            memcpy(&x, p - 2, sizeof(x));
+            if (has_zero_byte(x))
+                break;
+            p += 8;
+        }
+
+        if (p >= end)
+            break;
+
+        if (p[-1] > 1)
+            p += 3;
+        else if (p[-2])
+            p += 2;
+        else if (p[-3] | (p[-1] - 1))
+            p++;
+        else
+        {
+            p++;
+            break;
+        }
+    }
+
+    p = ((p < end) ? p : end) - 4;
+    *state = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+             ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+
+    return p + 4;
+}
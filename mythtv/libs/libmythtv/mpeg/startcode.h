@@ -0,0 +1,22 @@
+// -*- Mode: c++ -*-
+#ifndef _START_CODE_H_
+#define _START_CODE_H_
+
+#include <stdint.h>
+
+/** \fn find_start_code(const uint8_t*,const uint8_t*,uint32_t*)
+ *  \brief Finds the next 0x000001 start code, a drop-in replacement
+ *         for libavcodec's ff_find_start_code().
+ *
+ *   On return state holds the last four bytes scanned, so when a start
+ *   code was found it is 0x000001XX with XX the byte following it and
+ *   the returned pointer points just past that byte. state carries
+ *   partial start codes over from one call to the next.
+ *
+ *   Runs of bytes that can not hold a start code are skipped eight bytes
+ *   at a time, which covers nearly all of the coded picture data.
+ */
+const uint8_t *find_start_code(const uint8_t *p, const uint8_t *end,
+                               uint32_t *state);
+
+#endif // _START_CODE_H_
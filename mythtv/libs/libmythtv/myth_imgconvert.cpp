@@ -55,3 +55,26 @@ int myth_sws_img_convert(AVPicture *dst, PixelFormat dst_pix_fmt, AVPicture *src
 
     return 0;
 }
+
+int myth_sws_img_scale(AVPicture *dst, PixelFormat dst_pix_fmt,
+                       int dst_width, int dst_height,
+                       AVPicture *src, PixelFormat pix_fmt,
+                       int width, int height)
+{
+    struct SwsContext *scale_ctx =
+        sws_getContext(width, height, pix_fmt,
+                       dst_width, dst_height, dst_pix_fmt,
+                       SWS_AREA, NULL, NULL, NULL);
+    if (scale_ctx == NULL) {
+        LOG(VB_GENERAL, LOG_ERR, "myth_sws_img_scale: Cannot initialize "
+                                 "the image scaling context");
+        return -1;
+    }
+
+    sws_scale(scale_ctx, src->data, src->linesize,
+              0, height, dst->data, dst->linesize);
+
+    sws_freeContext(scale_ctx);
+
+    return 0;
+}
@@ -41,4 +41,14 @@ MTV_PUBLIC int myth_sws_img_convert(AVPicture *dst, PixelFormat dst_pix_fmt,
                                  AVPicture *src, PixelFormat pix_fmt,
                                  int width, int height);
 
+/**
+ * convert and scale in one pass, for one-off scaling such as preview
+ * generation. Uses its own context so callers don't serialize on the
+ * one shared by myth_sws_img_convert().
+ */
+MTV_PUBLIC int myth_sws_img_scale(AVPicture *dst, PixelFormat dst_pix_fmt,
+                                  int dst_width, int dst_height,
+                                  AVPicture *src, PixelFormat pix_fmt,
+                                  int width, int height);
+
 #endif /* MYTH_IMGCONVERT_H */
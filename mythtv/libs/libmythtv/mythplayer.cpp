@@ -1063,11 +1063,13 @@ void MythPlayer::InitFilters(void)
         VideoFrameType itmp = FMT_YV12;
         VideoFrameType otmp = FMT_YV12;
         int btmp;
+        int threads = max(1, min(QThread::idealThreadCount(), 4));
         postfilt_width = video_dim.width();
         postfilt_height = video_dim.height();
 
         videoFilters = FiltMan->LoadFilters(
-            filters, itmp, otmp, postfilt_width, postfilt_height, btmp);
+            filters, itmp, otmp, postfilt_width, postfilt_height, btmp,
+            threads);
     }
 
     videofiltersLock.unlock();
@@ -4128,11 +4130,13 @@ void MythPlayer::SeekForScreenGrab(uint64_t &number, uint64_t frameNum,
         }
     }
 
-    // Only do seek if we have position map
+    // Only do seek if we have position map. A preview doesn't need the
+    // exact frame, so land on the nearest keyframe from the position map
+    // and decode just that instead of every frame up to the one asked for.
     if (hasFullPositionMap)
     {
         DiscardVideoFrame(videoOutput->GetLastDecodedFrame());
-        DoFastForward(number);
+        DoFastForward(number, true, false);
     }
 }
 
@@ -4359,6 +4363,8 @@ void MythPlayer::GetPlaybackData(InfoMap &infoMap)
     infoMap.insert("decoderrate", player_ctx->buffer->GetDecoderRate());
     infoMap.insert("storagerate", player_ctx->buffer->GetStorageRate());
     infoMap.insert("bufferavail", player_ctx->buffer->GetAvailableBuffer());
+    infoMap.insert("remoterate",  player_ctx->buffer->GetRemoteRate());
+    infoMap.insert("remotertt",   player_ctx->buffer->GetRemoteRTT());
     infoMap.insert("buffersize",
         QString::number(player_ctx->buffer->GetBufferSize() >> 20));
     infoMap.insert("avsync",
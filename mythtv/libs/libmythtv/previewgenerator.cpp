@@ -34,6 +34,7 @@
 #include "mythsystem.h"
 #include "exitcodes.h"
 #include "mythlogging.h"
+#include "myth_imgconvert.h"
 
 #define LOC QString("Preview: ")
 #define LOC_ERR QString("Preview Error: ")
@@ -575,8 +576,20 @@ bool PreviewGenerator::SavePreview(QString filename,
     ppw = max(1.0f, ppw);
     pph = max(1.0f, pph);;
 
-    QImage small_img = img.scaled((int) ppw, (int) pph,
-        Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    // swscale has SIMD paths for this, QImage::scaled() does not
+    QImage small_img((int) ppw, (int) pph, QImage::Format_RGB32);
+    AVPicture orig, scaled;
+    avpicture_fill(&orig, (uint8_t*) data, PIX_FMT_RGB32, width, height);
+    avpicture_fill(&scaled, small_img.bits(), PIX_FMT_RGB32,
+                   small_img.width(), small_img.height());
+
+    if (myth_sws_img_scale(&scaled, PIX_FMT_RGB32,
+                           small_img.width(), small_img.height(),
+                           &orig, PIX_FMT_RGB32, width, height) < 0)
+    {
+        small_img = img.scaled((int) ppw, (int) pph,
+            Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
 
     QTemporaryFile f(QFileInfo(filename).absoluteFilePath()+".XXXXXX");
     f.setAutoRemove(false);
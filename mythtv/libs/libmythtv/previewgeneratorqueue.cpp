@@ -449,11 +449,14 @@ void PreviewGeneratorQueue::IncPreviewGeneratorPriority(
     }
 }
 
+/** \brief Starts queued PreviewGenerators, newest request first,
+ *         until all m_maxThreads are busy.
+ */
 void PreviewGeneratorQueue::UpdatePreviewGeneratorThreads(void)
 {
     QMutexLocker locker(&m_lock);
     QStringList &q = m_queue;
-    if (!q.empty() && (m_running < m_maxThreads))
+    while (!q.empty() && (m_running < m_maxThreads))
     {
         QString fn = q.back();
         q.pop_back();
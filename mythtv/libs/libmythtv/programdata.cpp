@@ -246,8 +246,174 @@ uint DBEvent::UpdateDB(
     }
 }
 
+/** \fn DBEvent::UpdateDB(MSqlQuery&,uint,const vector<const DBEvent*>&,int)
+ *  \brief Does the same as calling UpdateDB() for each of the events in
+ *         turn, with fewer queries.
+ *
+ *  The programs overlapping any of the events are read with one query for
+ *  the whole time span and kept up to date in memory, and events without
+ *  any overlap are inserted with multi-row statements.  The events must
+ *  all be on chanid and sorted by start time.  They are inserted with the
+ *  DBEvent columns, so this is not for subclasses overriding InsertDB().
+ *
+ *  \return number of events inserted or updated
+ */
+uint DBEvent::UpdateDB(MSqlQuery &query, uint chanid,
+                       const vector<const DBEvent*> &events,
+                       int match_threshold)
+{
+    if (events.empty())
+        return 0;
+
+    QDateTime start = events[0]->starttime;
+    QDateTime end   = events[0]->endtime;
+    for (uint i = 1; i < events.size(); i++)
+    {
+        start = min(start, events[i]->starttime);
+        end   = max(end,   events[i]->endtime);
+    }
+
+    vector<DBEvent>        existing;
+    vector<const DBEvent*> pending;
+    uint                   count = 0;
+
+    GetOverlappingPrograms(query, chanid, start, end, existing);
+
+    for (uint e = 0; e < events.size(); e++)
+    {
+        const DBEvent &event = *events[e];
+
+        // Events waiting to be inserted must be in the DB before they
+        // can be moved out of the way.
+        for (uint i = 0; i < pending.size(); i++)
+        {
+            if (!event.IsOverlapping(*pending[i]))
+                continue;
+
+            count += InsertDB(query, chanid, pending);
+            for (uint j = 0; j < pending.size(); j++)
+            {
+                const DBEvent &p = *pending[j];
+                existing.push_back(DBEvent(
+                    p.title, p.subtitle, p.description, p.category,
+                    p.categoryType, p.starttime, p.endtime, p.subtitleType,
+                    p.audioProps, p.videoProps, p.stars, p.seriesId,
+                    p.programId, p.listingsource));
+            }
+            pending.clear();
+            break;
+        }
+
+        vector<DBEvent> programs;
+        vector<uint>    index;
+        for (uint i = 0; i < existing.size(); i++)
+        {
+            if (event.IsOverlapping(existing[i]))
+            {
+                programs.push_back(existing[i]);
+                index.push_back(i);
+            }
+        }
+
+        if (programs.empty())
+        {
+            pending.push_back(&event);
+            continue;
+        }
+
+        int i     = -1;
+        int match = event.GetMatch(programs, i);
+
+        if (match < match_threshold)
+        {
+            if (i >= 0)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: reject match[%1]: %2 '%3' vs. '%4'")
+                        .arg(i).arg(match).arg(event.title)
+                        .arg(programs[i].title));
+            }
+            i = -1;
+        }
+        else
+        {
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: accept match[%1]: %2 '%3' vs. '%4'")
+                    .arg(i).arg(match).arg(event.title)
+                    .arg(programs[i].title));
+        }
+
+        uint updated = event.UpdateDB(query, chanid, programs, i);
+        count += updated;
+
+        if (!updated)
+        {
+            // Don't know what made it to the DB, start over from there.
+            existing.clear();
+            GetOverlappingPrograms(query, chanid, start, end, existing);
+            continue;
+        }
+
+        // Mirror what UpdateDB() and MoveOutOfTheWayDB() did.
+        for (int j = programs.size() - 1; j >= 0; j--)
+        {
+            DBEvent &prog = existing[index[j]];
+
+            if (j == i)
+            {
+                event.Merge(programs[j], prog);
+            }
+            else if (prog.starttime >= event.starttime &&
+                     prog.endtime   <= event.endtime)
+            {
+                existing.erase(existing.begin() + index[j]);
+            }
+            else if (prog.starttime < event.starttime &&
+                     prog.endtime   > event.starttime)
+            {
+                prog.endtime = event.starttime;
+            }
+            else if (prog.starttime < event.endtime &&
+                     prog.endtime   > event.endtime)
+            {
+                prog.starttime = event.endtime;
+            }
+        }
+
+        if (i < 0)
+        {
+            existing.push_back(DBEvent(
+                event.title, event.subtitle, event.description,
+                event.category, event.categoryType,
+                event.starttime, event.endtime, event.subtitleType,
+                event.audioProps, event.videoProps, event.stars,
+                event.seriesId, event.programId, event.listingsource));
+        }
+    }
+
+    count += InsertDB(query, chanid, pending);
+
+    return count;
+}
+
+/// Same test as the query in GetOverlappingPrograms()
+bool DBEvent::IsOverlapping(const DBEvent &prog) const
+{
+    return ((prog.starttime >= starttime && prog.starttime <  endtime) ||
+            (prog.endtime   >  starttime && prog.endtime   <= endtime));
+}
+
 uint DBEvent::GetOverlappingPrograms(
     MSqlQuery &query, uint chanid, vector<DBEvent> &programs) const
+{
+    return GetOverlappingPrograms(query, chanid, starttime, endtime,
+                                  programs);
+}
+
+uint DBEvent::GetOverlappingPrograms(
+    MSqlQuery &query, uint chanid,
+    const QDateTime &starttime, const QDateTime &endtime,
+    vector<DBEvent> &programs)
 {
     uint count = 0;
     query.prepare(
@@ -471,65 +637,78 @@ uint DBEvent::UpdateDB(
     return UpdateDB(q, chanid, p[match]);
 }
 
-uint DBEvent::UpdateDB(
-    MSqlQuery &query, uint chanid, const DBEvent &match) const
+/** \fn DBEvent::Merge(const DBEvent&,DBEvent&) const
+ *  \brief Fills in \a merged with the program UpdateDB() leaves in the DB
+ *         when this event updates \a match.
+ */
+void DBEvent::Merge(const DBEvent &match, DBEvent &merged) const
 {
-    QString  ltitle     = title;
-    QString  lsubtitle  = subtitle;
-    QString  ldesc      = description;
-    QString  lcategory  = category;
-    uint16_t lairdate   = airdate;
-    QString  lprogramId = programId;
-    QString  lseriesId  = seriesId;
-    QDate loriginalairdate = originalairdate;
+    merged.title       = title;
+    merged.subtitle    = subtitle;
+    merged.description = description;
+    merged.category    = category;
+    merged.starttime   = starttime;
+    merged.endtime     = endtime;
+    merged.airdate     = airdate;
+    merged.programId   = programId;
+    merged.seriesId    = seriesId;
+    merged.stars       = match.stars;
+    merged.originalairdate = originalairdate;
 
-    if (match.title.length() >= ltitle.length())
-        ltitle = match.title;
+    if (match.title.length() >= merged.title.length())
+        merged.title = match.title;
 
-    if (match.subtitle.length() >= lsubtitle.length())
-        lsubtitle = match.subtitle;
+    if (match.subtitle.length() >= merged.subtitle.length())
+        merged.subtitle = match.subtitle;
 
-    if (match.description.length() >= ldesc.length())
-        ldesc = match.description;
+    if (match.description.length() >= merged.description.length())
+        merged.description = match.description;
 
-    if (lcategory.isEmpty() && !match.category.isEmpty())
-        lcategory = match.category;
+    if (merged.category.isEmpty() && !match.category.isEmpty())
+        merged.category = match.category;
 
-    if (!lairdate && !match.airdate)
-        lairdate = match.airdate;
+    if (!merged.airdate && !match.airdate)
+        merged.airdate = match.airdate;
 
-    if (!loriginalairdate.isValid() && match.originalairdate.isValid())
-        loriginalairdate = match.originalairdate;
+    if (!merged.originalairdate.isValid() && match.originalairdate.isValid())
+        merged.originalairdate = match.originalairdate;
 
-    if (lprogramId.isEmpty() && !match.programId.isEmpty())
-        lprogramId = match.programId;
+    if (merged.programId.isEmpty() && !match.programId.isEmpty())
+        merged.programId = match.programId;
 
-    if (lseriesId.isEmpty() && !match.seriesId.isEmpty())
-        lseriesId = match.seriesId;
+    if (merged.seriesId.isEmpty() && !match.seriesId.isEmpty())
+        merged.seriesId = match.seriesId;
 
-    uint tmp = categoryType;
+    merged.categoryType = categoryType;
     if (!categoryType && match.categoryType)
-        tmp = match.categoryType;
+        merged.categoryType = match.categoryType;
 
-    QString lcattype = myth_category_type_to_string(tmp);
+    merged.subtitleType = subtitleType | match.subtitleType;
+    merged.audioProps   = audioProps   | match.audioProps;
+    merged.videoProps   = videoProps   | match.videoProps;
 
-    unsigned char lsubtype = subtitleType | match.subtitleType;
-    unsigned char laudio   = audioProps   | match.audioProps;
-    unsigned char lvideo   = videoProps   | match.videoProps;
-
-    uint lpartnumber =
+    merged.partnumber =
         (!partnumber && match.partnumber) ? match.partnumber : partnumber;
-    uint lparttotal =
+    merged.parttotal =
         (!parttotal  && match.parttotal ) ? match.parttotal  : parttotal;
 
-    bool lpreviouslyshown = previouslyshown | match.previouslyshown;
+    merged.previouslyshown = previouslyshown | match.previouslyshown;
 
-    uint32_t llistingsource = listingsource | match.listingsource;
+    merged.listingsource = listingsource | match.listingsource;
 
-    QString lsyndicatedepisodenumber = syndicatedepisodenumber;
-    if (lsyndicatedepisodenumber.isEmpty() &&
+    merged.syndicatedepisodenumber = syndicatedepisodenumber;
+    if (merged.syndicatedepisodenumber.isEmpty() &&
         !match.syndicatedepisodenumber.isEmpty())
-        lsyndicatedepisodenumber = match.syndicatedepisodenumber;
+        merged.syndicatedepisodenumber = match.syndicatedepisodenumber;
+}
+
+uint DBEvent::UpdateDB(
+    MSqlQuery &query, uint chanid, const DBEvent &match) const
+{
+    DBEvent m(listingsource);
+    Merge(match, m);
+
+    QString lcattype = myth_category_type_to_string(m.categoryType);
 
     query.prepare(
         "UPDATE program "
@@ -552,29 +731,30 @@ uint DBEvent::UpdateDB(
 
     query.bindValue(":CHANID",      chanid);
     query.bindValue(":OLDSTART",    match.starttime);
-    query.bindValue(":TITLE",       ltitle);
-    query.bindValue(":SUBTITLE",    lsubtitle);
-    query.bindValue(":DESC",        ldesc);
-    query.bindValue(":CATEGORY",    lcategory);
+    query.bindValue(":TITLE",       m.title);
+    query.bindValue(":SUBTITLE",    m.subtitle);
+    query.bindValue(":DESC",        m.description);
+    query.bindValue(":CATEGORY",    m.category);
     query.bindValue(":CATTYPE",     lcattype);
-    query.bindValue(":STARTTIME",   starttime);
-    query.bindValue(":ENDTIME",     endtime);
-    query.bindValue(":CC",          lsubtype & SUB_HARDHEAR ? true : false);
-    query.bindValue(":HASSUBTITLES",lsubtype & SUB_NORMAL   ? true : false);
-    query.bindValue(":STEREO",      laudio   & AUD_STEREO   ? true : false);
-    query.bindValue(":HDTV",        lvideo   & VID_HDTV     ? true : false);
-    query.bindValue(":SUBTYPE",     lsubtype);
-    query.bindValue(":AUDIOPROP",   laudio);
-    query.bindValue(":VIDEOPROP",   lvideo);
-    query.bindValue(":PARTNO",      lpartnumber);
-    query.bindValue(":PARTTOTAL",   lparttotal);
-    query.bindValue(":SYNDICATENO", lsyndicatedepisodenumber);
-    query.bindValue(":AIRDATE",     lairdate?QString::number(lairdate):"0000");
-    query.bindValue(":ORIGAIRDATE", loriginalairdate);
-    query.bindValue(":LSOURCE",     llistingsource);
-    query.bindValue(":SERIESID",    lseriesId);
-    query.bindValue(":PROGRAMID",   lprogramId);
-    query.bindValue(":PREVSHOWN",   lpreviouslyshown);
+    query.bindValue(":STARTTIME",   m.starttime);
+    query.bindValue(":ENDTIME",     m.endtime);
+    query.bindValue(":CC",        m.subtitleType & SUB_HARDHEAR ? true : false);
+    query.bindValue(":HASSUBTITLES",m.subtitleType & SUB_NORMAL ? true : false);
+    query.bindValue(":STEREO",      m.audioProps & AUD_STEREO   ? true : false);
+    query.bindValue(":HDTV",        m.videoProps & VID_HDTV     ? true : false);
+    query.bindValue(":SUBTYPE",     m.subtitleType);
+    query.bindValue(":AUDIOPROP",   m.audioProps);
+    query.bindValue(":VIDEOPROP",   m.videoProps);
+    query.bindValue(":PARTNO",      m.partnumber);
+    query.bindValue(":PARTTOTAL",   m.parttotal);
+    query.bindValue(":SYNDICATENO", m.syndicatedepisodenumber);
+    query.bindValue(":AIRDATE",
+                    m.airdate ? QString::number(m.airdate) : "0000");
+    query.bindValue(":ORIGAIRDATE", m.originalairdate);
+    query.bindValue(":LSOURCE",     m.listingsource);
+    query.bindValue(":SERIESID",    m.seriesId);
+    query.bindValue(":PROGRAMID",   m.programId);
+    query.bindValue(":PREVSHOWN",   m.previouslyshown);
 
     if (!query.exec())
     {
@@ -755,6 +935,124 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid) const
     return 1;
 }
 
+/// Rows per statement in DBEvent::InsertDB(MSqlQuery&,uint,const vector&)
+#define INSERT_ROWS 50
+
+/** \fn DBEvent::InsertDB(MSqlQuery&,uint,const vector<const DBEvent*>&)
+ *  \brief Inserts several events with multi-row REPLACE statements.
+ *
+ *  Falls back to inserting the events of a statement one by one if it
+ *  fails, so one bad row doesn't lose its neighbours.
+ *  \return number of events inserted
+ */
+uint DBEvent::InsertDB(MSqlQuery &query, uint chanid,
+                       const vector<const DBEvent*> &events)
+{
+    uint count = 0;
+
+    for (uint start = 0; start < events.size(); start += INSERT_ROWS)
+    {
+        uint end = min((uint) events.size(), start + INSERT_ROWS);
+
+        if (end - start == 1)
+        {
+            count += events[start]->InsertDB(query, chanid);
+            continue;
+        }
+
+        QString qstr =
+            "REPLACE INTO program ("
+            "  chanid,         title,          subtitle,        description, "
+            "  category,       category_type, "
+            "  starttime,      endtime, "
+            "  closecaptioned, stereo,         hdtv,            subtitled, "
+            "  subtitletypes,  audioprop,      videoprop, "
+            "  stars,          partnumber,     parttotal, "
+            "  syndicatedepisodenumber, "
+            "  airdate,        originalairdate,listingsource, "
+            "  seriesid,       programid,      previouslyshown ) "
+            "VALUES ";
+
+        for (uint i = start; i < end; i++)
+        {
+            QString n = QString::number(i - start);
+            if (i != start)
+                qstr += ", ";
+            qstr += QString(
+                "(:CHANID%1, :TITLE%1, :SUBTITLE%1, :DESCRIPTION%1, "
+                " :CATEGORY%1, :CATTYPE%1, :STARTTIME%1, :ENDTIME%1, "
+                " :CC%1, :STEREO%1, :HDTV%1, :HASSUBTITLES%1, "
+                " :SUBTYPES%1, :AUDIOPROP%1, :VIDEOPROP%1, "
+                " :STARS%1, :PARTNUMBER%1, :PARTTOTAL%1, :SYNDICATENO%1, "
+                " :AIRDATE%1, :ORIGAIRDATE%1, :LSOURCE%1, "
+                " :SERIESID%1, :PROGRAMID%1, :PREVSHOWN%1)").arg(n);
+        }
+
+        query.prepare(qstr);
+
+        for (uint i = start; i < end; i++)
+        {
+            const DBEvent &e = *events[i];
+            QString n = QString::number(i - start);
+
+            query.bindValue(":CHANID"      + n, chanid);
+            query.bindValue(":TITLE"       + n, e.title);
+            query.bindValue(":SUBTITLE"    + n, e.subtitle);
+            query.bindValue(":DESCRIPTION" + n, e.description);
+            query.bindValue(":CATEGORY"    + n, e.category);
+            query.bindValue(":CATTYPE"     + n,
+                            myth_category_type_to_string(e.categoryType));
+            query.bindValue(":STARTTIME"   + n, e.starttime);
+            query.bindValue(":ENDTIME"     + n, e.endtime);
+            query.bindValue(":CC"          + n,
+                            e.subtitleType & SUB_HARDHEAR ? true : false);
+            query.bindValue(":STEREO"      + n,
+                            e.audioProps   & AUD_STEREO   ? true : false);
+            query.bindValue(":HDTV"        + n,
+                            e.videoProps   & VID_HDTV     ? true : false);
+            query.bindValue(":HASSUBTITLES"+ n,
+                            e.subtitleType & SUB_NORMAL   ? true : false);
+            query.bindValue(":SUBTYPES"    + n, e.subtitleType);
+            query.bindValue(":AUDIOPROP"   + n, e.audioProps);
+            query.bindValue(":VIDEOPROP"   + n, e.videoProps);
+            query.bindValue(":STARS"       + n, e.stars);
+            query.bindValue(":PARTNUMBER"  + n, e.partnumber);
+            query.bindValue(":PARTTOTAL"   + n, e.parttotal);
+            query.bindValue(":SYNDICATENO" + n, e.syndicatedepisodenumber);
+            query.bindValue(":AIRDATE"     + n,
+                            e.airdate ? QString::number(e.airdate) : "0000");
+            query.bindValue(":ORIGAIRDATE" + n, e.originalairdate);
+            query.bindValue(":LSOURCE"     + n, e.listingsource);
+            query.bindValue(":SERIESID"    + n, e.seriesId);
+            query.bindValue(":PROGRAMID"   + n, e.programId);
+            query.bindValue(":PREVSHOWN"   + n, e.previouslyshown);
+        }
+
+        if (!query.exec())
+        {
+            MythDB::DBError("InsertDB (multi-row)", query);
+
+            for (uint i = start; i < end; i++)
+                count += events[i]->InsertDB(query, chanid);
+            continue;
+        }
+
+        for (uint i = start; i < end; i++)
+        {
+            const DBEvent &e = *events[i];
+            if (e.credits)
+            {
+                for (uint j = 0; j < e.credits->size(); j++)
+                    (*e.credits)[j].InsertDB(query, chanid, e.starttime);
+            }
+        }
+
+        count += end - start;
+    }
+
+    return count;
+}
+
 ProgInfo::ProgInfo(const ProgInfo &other) :
     DBEvent(other.listingsource)
 {
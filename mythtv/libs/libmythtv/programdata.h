@@ -126,6 +126,9 @@ class MTV_PUBLIC DBEvent
     void AddPerson(const QString &role, const QString &name);
 
     uint UpdateDB(MSqlQuery &query, uint chanid, int match_threshold) const;
+    static uint UpdateDB(MSqlQuery &query, uint chanid,
+                         const vector<const DBEvent*> &events,
+                         int match_threshold);
 
     bool HasCredits(void) const { return credits; }
     bool HasTimeConflict(const DBEvent &other) const;
@@ -135,12 +138,20 @@ class MTV_PUBLIC DBEvent
   protected:
     uint GetOverlappingPrograms(
         MSqlQuery&, uint chanid, vector<DBEvent> &programs) const;
+    static uint GetOverlappingPrograms(
+        MSqlQuery&, uint chanid,
+        const QDateTime &start, const QDateTime &end,
+        vector<DBEvent> &programs);
+    static uint InsertDB(
+        MSqlQuery&, uint chanid, const vector<const DBEvent*> &events);
+    bool IsOverlapping(const DBEvent &prog) const;
     int  GetMatch(
         const vector<DBEvent> &programs, int &bestmatch) const;
     uint UpdateDB(
         MSqlQuery&, uint chanid, const vector<DBEvent> &p, int match) const;
     uint UpdateDB(
         MSqlQuery&, uint chanid, const DBEvent &match) const;
+    void Merge(const DBEvent &match, DBEvent &merged) const;
     bool MoveOutOfTheWayDB(
         MSqlQuery&, uint chanid, const DBEvent &nonmatch) const;
     virtual uint InsertDB(MSqlQuery&, uint chanid) const;
@@ -1326,6 +1326,28 @@ QString RingBuffer::GetAvailableBuffer(void)
     return QString("%1%").arg((int)(((float)avail / (float)bufferSize) * 100.0));
 }
 
+/// Returns the throughput of pipelined RemoteFile reads, if remote.
+QString RingBuffer::GetRemoteRate(void) const
+{
+    QString ret;
+    rwlock.lockForRead();
+    if (remotefile)
+        ret = BitrateToString(remotefile->GetThroughput());
+    rwlock.unlock();
+    return ret;
+}
+
+/// Returns the backend round trip time of RemoteFile reads, if remote.
+QString RingBuffer::GetRemoteRTT(void) const
+{
+    QString ret;
+    rwlock.lockForRead();
+    if (remotefile)
+        ret = QObject::tr("%1ms").arg(remotefile->GetRoundTripTime());
+    rwlock.unlock();
+    return ret;
+}
+
 uint64_t RingBuffer::UpdateDecoderRate(uint64_t latest)
 {
     if (!bitrateMonitorEnabled)
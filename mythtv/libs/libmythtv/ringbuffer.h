@@ -71,6 +71,8 @@ class MTV_PUBLIC RingBuffer : protected QThread
     QString GetDecoderRate(void);
     QString GetStorageRate(void);
     QString GetAvailableBuffer(void);
+    QString GetRemoteRate(void) const;
+    QString GetRemoteRTT(void) const;
     uint    GetBufferSize(void) { return bufferSize; }
     long long GetWritePosition(void) const;
     /// \brief Returns the size of the file we are reading/writing,
@@ -269,11 +269,11 @@ bool MythImage::Load(MythImageReader &reader)
 }
 
 // FIXME: Get rid of LoadScaleImage
-bool MythImage::Load(const QString &filename, bool scale)
+bool MythImage::Load(const QString &filename, bool scale, const QSize &minSize)
 {
     QImage *im = NULL;
     if (scale)
-        im = GetMythUI()->LoadScaleImage(filename);
+        im = GetMythUI()->LoadScaleImage(filename, true, minSize);
     else
     {
         if (filename.startsWith("myth://"))
@@ -52,7 +52,8 @@ class MUI_PUBLIC MythImage : public QImage
     void Assign(const QPixmap &pix);
 
     bool Load(MythImageReader &reader);
-    bool Load(const QString &filename, bool scale = true);
+    bool Load(const QString &filename, bool scale = true,
+              const QSize &minSize = QSize());
 
     void Resize(const QSize &newSize, bool preserveAspect = false);
     void Reflect(ReflectAxis axis, int shear, int scale, int length,
@@ -42,6 +42,7 @@ using namespace std;
 #include "mythdirs.h"
 #include "compat.h"
 #include "mythsignalingtimer.h"
+#include "mythtimer.h"
 #include "mythcorecontext.h"
 #include "mythmedia.h"
 
@@ -77,6 +78,11 @@ using namespace std;
 
 #define GESTURE_TIMEOUT 1000
 
+// Dirty regions of more rectangles than this are redrawn as one
+#define MAX_REPAINT_RECTS 8
+// Redraws between logging of the redraw statistics
+#define DRAW_STATS_INTERVAL 500
+
 #define LOC      QString("MythMainWindow: ")
 #define LOC_WARN QString("MythMainWindow, Warning: ")
 #define LOC_ERR  QString("MythMainWindow, Error: ")
@@ -174,7 +180,11 @@ class MythMainWindowPrivate
 
         m_udpListener(NULL),
 
-        m_pendingUpdate(false)
+        m_pendingUpdate(false),
+
+        m_drawCount(0),
+        m_drawTime(0),
+        m_drawArea(0)
     {
     }
 
@@ -257,6 +267,12 @@ class MythMainWindowPrivate
     MythUDPListener *m_udpListener;
 
     bool m_pendingUpdate;
+
+    // redraw statistics
+    MythTimer m_drawStatsTimer;
+    uint      m_drawCount;
+    int       m_drawTime;   ///< milliseconds spent in draw()
+    uint64_t  m_drawArea;   ///< pixels redrawn
 };
 
 // Make keynum in QKeyEvent be equivalent to what's in QKeySequence
@@ -712,6 +728,20 @@ void MythMainWindow::drawScreen(void)
                 }
             }
         }
+
+        // Every rectangle costs a pass over all the screens, so a region
+        // of many is drawn as its bounding rectangle, and one covering
+        // most of the screen as the whole screen, without any clipping.
+        QRect bounds = d->repaintRegion.boundingRect();
+        if ((qint64)bounds.width() * bounds.height() * 4 >=
+            (qint64)d->uiScreenRect.width() * d->uiScreenRect.height() * 3)
+        {
+            d->repaintRegion = QRegion(d->uiScreenRect);
+        }
+        else if (d->repaintRegion.rects().size() > MAX_REPAINT_RECTS)
+        {
+            d->repaintRegion = QRegion(bounds);
+        }
     }
 
     if (!(d->render && d->render->IsShared()))
@@ -725,6 +755,10 @@ void MythMainWindow::draw(void)
     if (!d->painter)
         return;
 
+    MythTimer drawTimer;
+    drawTimer.start();
+    uint64_t area = 0;
+
     d->painter->Begin(d->paintwin);
 
     QVector<QRect> rects = d->repaintRegion.rects();
@@ -734,6 +768,8 @@ void MythMainWindow::draw(void)
         if (rects[i].width() == 0 || rects[i].height() == 0)
             continue;
 
+        area += (uint64_t)rects[i].width() * rects[i].height();
+
         if (rects[i] != d->uiScreenRect)
             d->painter->SetClipRect(rects[i]);
 
@@ -753,6 +789,39 @@ void MythMainWindow::draw(void)
     }
 
     d->painter->End();
+
+    UpdateDrawStats(drawTimer.elapsed(), area);
+}
+
+/** \fn MythMainWindow::UpdateDrawStats(int, uint64_t)
+ *  \brief Adds a redraw to the statistics, logging how long redraws take
+ *         and how much of the screen they cover every DRAW_STATS_INTERVAL.
+ */
+void MythMainWindow::UpdateDrawStats(int msecs, uint64_t area)
+{
+    if (!d->m_drawCount)
+        d->m_drawStatsTimer.start();
+
+    d->m_drawCount++;
+    d->m_drawTime += msecs;
+    d->m_drawArea += area;
+
+    if (d->m_drawCount < DRAW_STATS_INTERVAL)
+        return;
+
+    uint64_t screen = (uint64_t)d->uiScreenRect.width() *
+                      d->uiScreenRect.height();
+    int period = d->m_drawStatsTimer.elapsed();
+
+    LOG(VB_GUI, LOG_DEBUG, LOC +
+        QString("%1 redraws in %2 s, %3 ms and %4% of the screen each")
+            .arg(d->m_drawCount).arg(period / 1000.0, 0, 'f', 1)
+            .arg((double)d->m_drawTime / d->m_drawCount, 0, 'f', 1)
+            .arg(screen ? 100 * d->m_drawArea / (screen * d->m_drawCount) : 0));
+
+    d->m_drawCount = 0;
+    d->m_drawTime  = 0;
+    d->m_drawArea  = 0;
 }
 
 void MythMainWindow::closeEvent(QCloseEvent *e)
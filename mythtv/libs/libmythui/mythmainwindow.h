@@ -1,6 +1,8 @@
 #ifndef MYTHMAINWINDOW_H_
 #define MYTHMAINWINDOW_H_
 
+#include <stdint.h>
+
 #include <QWidget>
 
 #include "mythuiactions.h"
@@ -159,6 +161,7 @@ class MUI_PUBLIC MythMainWindow : public QWidget
     void LockInputDevices(bool locked);
 
     void ShowMouseCursor(bool show);
+    void UpdateDrawStats(int msecs, uint64_t area);
 
     MythMainWindowPrivate *d;
 };
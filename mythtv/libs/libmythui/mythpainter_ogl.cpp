@@ -1,6 +1,10 @@
 // Config header generated in base directory by configure
 #include "config.h"
 
+// C++ headers
+#include <algorithm>
+#include <stdint.h>
+
 // QT headers
 #include <QCoreApplication>
 #include <QPainter>
@@ -10,6 +14,7 @@
 #include "mythlogging.h"
 
 // Mythui headers
+#include "mythfontproperties.h"
 #include "mythrender_opengl.h"
 
 // Own header
@@ -17,6 +22,75 @@
 
 using namespace std;
 
+const int MythOpenGLPainter::kAtlasMaxImage = 128;
+const int MythOpenGLPainter::kAtlasSize     = 1024;
+
+/// \brief Finds room for an image of the given size, false when full.
+bool MythGLAtlas::Allocate(MythImage *im, const QSize &size, QRect &area)
+{
+    // The image keeps the whole slot, so the slot can be reused by a
+    // larger image again once this one is dropped.
+    for (int i = 0; i < m_free.size(); i++)
+    {
+        if (m_free[i].width()  >= size.width() &&
+            m_free[i].height() >= size.height())
+        {
+            m_slots[im] = m_free.takeAt(i);
+            area = QRect(m_slots[im].topLeft(), size);
+            return true;
+        }
+    }
+
+    if (m_rowLeft + size.width() > m_size.width())
+    {
+        m_rowLeft    = 0;
+        m_rowTop    += m_rowHeight;
+        m_rowHeight  = 0;
+    }
+
+    if (m_rowLeft + size.width() > m_size.width() ||
+        m_rowTop + size.height() > m_size.height())
+        return false;
+
+    area = QRect(QPoint(m_rowLeft, m_rowTop), size);
+    m_slots[im] = area;
+    m_rowLeft  += size.width();
+    m_rowHeight = max(m_rowHeight, size.height());
+    return true;
+}
+
+/// \brief Gives up the space of an image, true once the atlas is empty.
+bool MythGLAtlas::Release(MythImage *im)
+{
+    QMap<MythImage *, QRect>::iterator it = m_slots.find(im);
+    if (it != m_slots.end())
+    {
+        m_free.push_back(*it);
+        m_slots.erase(it);
+    }
+    return m_slots.empty();
+}
+
+/// Surrounds a 32 bit image with a copy of its edge pixels, so filtering
+/// at the edges does not pick up the neighbouring images in an atlas.
+static QImage pad_image(const QImage &src)
+{
+    int width  = src.width();
+    int height = src.height();
+
+    QImage dst(width + 2, height + 2, src.format());
+    for (int y = 0; y < height + 2; y++)
+    {
+        const uint32_t *in =
+            (const uint32_t*)src.scanLine(min(max(y - 1, 0), height - 1));
+        uint32_t *out = (uint32_t*)dst.scanLine(y);
+        out[0] = in[0];
+        memcpy(out + 1, in, width * sizeof(uint32_t));
+        out[width + 1] = in[width - 1];
+    }
+    return dst;
+}
+
 MythOpenGLPainter::MythOpenGLPainter(MythRenderOpenGL *render,
                                      QGLWidget *parent) :
     MythPainter(), realParent(parent), realRender(render),
@@ -66,10 +140,21 @@ void MythOpenGLPainter::ClearCache(void)
     while (it.hasNext())
     {
         it.next();
-        m_textureDeleteList.push_back(m_ImageIntMap[it.key()]);
+        if (!m_ImageAtlasMap.contains(it.key()))
+            m_textureDeleteList.push_back(m_ImageIntMap[it.key()]);
         m_ImageExpireList.remove(it.key());
     }
     m_ImageIntMap.clear();
+    m_ImageAtlasMap.clear();
+
+    QMap<uint, MythGLAtlas *>::iterator ait = m_atlases.begin();
+    for (; ait != m_atlases.end(); ++ait)
+    {
+        m_textureDeleteList.push_back(ait.key());
+        delete *ait;
+    }
+    m_atlases.clear();
+    m_AtlasExpireList.clear();
 }
 
 void MythOpenGLPainter::Begin(QPaintDevice *parent)
@@ -99,6 +184,7 @@ void MythOpenGLPainter::Begin(QPaintDevice *parent)
 
     DeleteTextures();
     realRender->makeCurrent();
+    realRender->ResetFrameStats();
 
     if (target || swapControl)
     {
@@ -119,6 +205,8 @@ void MythOpenGLPainter::End(void)
     }
     else
     {
+        if (ShowBorders())
+            DrawStats();
         realRender->Flush(false);
         if (target == 0 && swapControl)
             realRender->swapBuffers();
@@ -137,9 +225,15 @@ int MythOpenGLPainter::GetTextureFromCache(MythImage *im)
     {
         if (!im->IsChanged())
         {
+            uint tex = m_ImageIntMap[im];
             m_ImageExpireList.remove(im);
             m_ImageExpireList.push_back(im);
-            return m_ImageIntMap[im];
+            if (m_atlases.contains(tex))
+            {
+                m_AtlasExpireList.remove(tex);
+                m_AtlasExpireList.push_back(tex);
+            }
+            return tex;
         }
         else
         {
@@ -150,42 +244,183 @@ int MythOpenGLPainter::GetTextureFromCache(MythImage *im)
     im->SetChanged(false);
 
     QImage tx = QGLWidget::convertToGLFormat(*im);
-    GLuint tx_id =
-        realRender->CreateTexture(tx.size(),false, 0,
-                                  GL_UNSIGNED_BYTE, GL_RGBA, GL_RGBA8,
-                                  GL_LINEAR_MIPMAP_LINEAR);
+    GLuint tx_id = 0;
+
+    if (!tx.isNull() && tx.width() <= kAtlasMaxImage &&
+        tx.height() <= kAtlasMaxImage)
+        tx_id = AddToAtlas(im, tx);
 
     if (!tx_id)
     {
-        LOG(VB_GENERAL, LOG_ERR, "Failed to create OpenGL texture.");
-        return tx_id;
+        tx_id = realRender->CreateTexture(tx.size(),false, 0,
+                                          GL_UNSIGNED_BYTE, GL_RGBA, GL_RGBA8,
+                                          GL_LINEAR_MIPMAP_LINEAR);
+
+        if (!tx_id)
+        {
+            LOG(VB_GENERAL, LOG_ERR, "Failed to create OpenGL texture.");
+            return tx_id;
+        }
+
+        m_HardwareCacheSize += realRender->GetTextureDataSize(tx_id);
+        realRender->GetTextureBuffer(tx_id, false);
+        realRender->UpdateTexture(tx_id, tx.bits());
     }
 
     CheckFormatImage(im);
-    m_HardwareCacheSize += realRender->GetTextureDataSize(tx_id);
-    realRender->GetTextureBuffer(tx_id, false);
-    realRender->UpdateTexture(tx_id, tx.bits());
-
     m_ImageIntMap[im] = tx_id;
     m_ImageExpireList.push_back(im);
 
-    while (m_HardwareCacheSize > m_MaxHardwareCacheSize)
+    // Never expire the image just loaded, its texture is returned.
+    // Dropping an image from an atlas frees no texture memory, so those
+    // are skipped and whole atlases are expired after the other images.
+    std::list<MythImage *>::iterator eit = m_ImageExpireList.begin();
+    while (m_HardwareCacheSize > m_MaxHardwareCacheSize &&
+           *eit != im)
     {
-        MythImage *expiredIm = m_ImageExpireList.front();
-        m_ImageExpireList.pop_front();
+        MythImage *expiredIm = *eit++;
+        if (m_ImageAtlasMap.contains(expiredIm))
+            continue;
         DeleteFormatImagePriv(expiredIm);
         DeleteTextures();
     }
 
+    while (m_HardwareCacheSize > m_MaxHardwareCacheSize &&
+           !m_AtlasExpireList.empty() &&
+           m_AtlasExpireList.front() != tx_id)
+    {
+        ExpireAtlas(m_AtlasExpireList.front());
+        DeleteTextures();
+    }
+
     return tx_id;
 }
 
+/// \brief Drops every image in an atlas, which deletes its texture.
+void MythOpenGLPainter::ExpireAtlas(uint tex)
+{
+    MythGLAtlas *atlas = m_atlases.value(tex);
+    if (!atlas)
+    {
+        m_AtlasExpireList.remove(tex);
+        return;
+    }
+
+    LOG(VB_GUI, LOG_DEBUG, QString("Expiring OpenGL image atlas with %1 "
+                                   "images.").arg(atlas->m_slots.size()));
+
+    QList<MythImage *> images = atlas->m_slots.keys();
+    for (int i = 0; i < images.size(); i++)
+        DeleteFormatImagePriv(images[i]);
+}
+
+/** \fn MythOpenGLPainter::AddToAtlas(MythImage*, const QImage&)
+ *  \brief Copies a small image into an atlas texture shared with others,
+ *         so drawing a screen full of icons needs fewer texture binds.
+ *  \return the atlas texture, or 0 to use a texture of its own
+ */
+uint MythOpenGLPainter::AddToAtlas(MythImage *im, const QImage &image)
+{
+    QImage padded = pad_image(image);
+    MythGLAtlas *atlas = NULL;
+    QRect area;
+
+    QMutexLocker locker(&m_textureDeleteLock);
+
+    QMap<uint, MythGLAtlas *>::iterator it = m_atlases.begin();
+    for (; it != m_atlases.end() && !atlas; ++it)
+    {
+        if ((*it)->Allocate(im, padded.size(), area))
+            atlas = *it;
+    }
+
+    if (!atlas)
+    {
+        int size = min(kAtlasSize, realRender->GetMaxTextureSize());
+        if (size < padded.width() || size < padded.height())
+            return 0;
+
+        uint tex = realRender->CreateTexture(QSize(size, size), false, 0,
+                                             GL_UNSIGNED_BYTE, GL_RGBA,
+                                             GL_RGBA8, GL_LINEAR);
+        if (!tex)
+            return 0;
+
+        LOG(VB_GUI, LOG_DEBUG, QString("Created %1x%1 OpenGL image atlas.")
+            .arg(size));
+
+        m_HardwareCacheSize += realRender->GetTextureDataSize(tex);
+        atlas = new MythGLAtlas(tex, QSize(size, size));
+        m_atlases[tex] = atlas;
+        if (!atlas->Allocate(im, padded.size(), area))
+            return 0;
+    }
+
+    realRender->UpdateTexture(atlas->m_texture, padded.bits(), area);
+    m_ImageAtlasMap[im] = area.adjusted(1, 1, -1, -1);
+    m_AtlasExpireList.remove(atlas->m_texture);
+    m_AtlasExpireList.push_back(atlas->m_texture);
+    return atlas->m_texture;
+}
+
 void MythOpenGLPainter::DrawImage(const QRect &r, MythImage *im,
                                   const QRect &src, int alpha)
 {
-    if (realRender)
-        realRender->DrawBitmap(GetTextureFromCache(im), target,
-                               &src, &r, 0, alpha);
+    if (!realRender)
+        return;
+
+    uint tex = GetTextureFromCache(im);
+
+    QMap<MythImage *, QRect>::const_iterator it = m_ImageAtlasMap.find(im);
+    if (it == m_ImageAtlasMap.end())
+    {
+        realRender->DrawBitmap(tex, target, &src, &r, 0, alpha);
+        return;
+    }
+
+    // Keep to the image, the rest of the atlas is other images.  Whatever
+    // is clipped off the source is clipped off the destination as well,
+    // so the part drawn isn't stretched.
+    QRect atlas_src = src.intersected(QRect(QPoint(0, 0), it->size()));
+    if (atlas_src.isEmpty())
+        return;
+
+    QRect dest = r;
+    if (atlas_src != src)
+    {
+        qreal sx = (qreal)r.width()  / src.width();
+        qreal sy = (qreal)r.height() / src.height();
+        int left   = r.left() + qRound((atlas_src.left() - src.left()) * sx);
+        int top    = r.top()  + qRound((atlas_src.top()  - src.top())  * sy);
+        int right  = r.left() +
+            qRound((atlas_src.left() + atlas_src.width()  - src.left()) * sx);
+        int bottom = r.top()  +
+            qRound((atlas_src.top()  + atlas_src.height() - src.top())  * sy);
+        dest = QRect(left, top, right - left, bottom - top);
+        if (dest.isEmpty())
+            return;
+    }
+
+    atlas_src.translate(it->topLeft());
+    realRender->DrawBitmap(tex, target, &atlas_src, &dest, 0, alpha);
+}
+
+/// \brief Shows the work done for the frame, with the theme debug borders.
+void MythOpenGLPainter::DrawStats(void)
+{
+    uint binds, draws, quads;
+    realRender->GetFrameStats(binds, draws, quads);
+
+    QString msg = QString("OpenGL: %1 images, %2 draws, %3 binds, %4 atlases")
+        .arg(quads).arg(draws).arg(binds).arg(m_atlases.size());
+
+    MythFontProperties font;
+    font.SetFace(QFont("Droid Sans"));
+    font.SetColor(Qt::yellow);
+    font.SetPointSize(8);
+
+    QRect area(0, 0, realParent->width(), 20);
+    DrawText(area, msg, Qt::AlignLeft | Qt::AlignTop, font, 255, area);
 }
 
 void MythOpenGLPainter::DrawRect(const QRect &area, const QBrush &fillBrush,
@@ -222,7 +457,22 @@ void MythOpenGLPainter::DeleteFormatImagePriv(MythImage *im)
     if (m_ImageIntMap.contains(im))
     {
         QMutexLocker locker(&m_textureDeleteLock);
-        m_textureDeleteList.push_back(m_ImageIntMap[im]);
+        uint tex = m_ImageIntMap[im];
+        if (m_ImageAtlasMap.remove(im))
+        {
+            MythGLAtlas *atlas = m_atlases.value(tex);
+            if (atlas && atlas->Release(im))
+            {
+                m_textureDeleteList.push_back(tex);
+                m_atlases.remove(tex);
+                m_AtlasExpireList.remove(tex);
+                delete atlas;
+            }
+        }
+        else
+        {
+            m_textureDeleteList.push_back(tex);
+        }
         m_ImageIntMap.remove(im);
         m_ImageExpireList.remove(im);
     }
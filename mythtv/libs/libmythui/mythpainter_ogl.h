@@ -10,6 +10,31 @@
 #include "mythimage.h"
 #include "mythrender_opengl.h"
 
+/** \class MythGLAtlas
+ *  \brief A texture shared by many small images, filled row by row.
+ *
+ *   The space of a dropped image is reused by the next image that fits
+ *   in it. The texture is deleted once the last of its images is gone.
+ */
+class MythGLAtlas
+{
+  public:
+    MythGLAtlas(uint texture, const QSize &size)
+      : m_texture(texture), m_size(size), m_rowLeft(0), m_rowTop(0),
+        m_rowHeight(0) { }
+
+    bool Allocate(MythImage *im, const QSize &size, QRect &area);
+    bool Release(MythImage *im);
+
+    uint  m_texture;
+    QSize m_size;
+    int   m_rowLeft;
+    int   m_rowTop;
+    int   m_rowHeight;
+    QMap<MythImage *, QRect> m_slots;  ///< space held by each image
+    QList<QRect>             m_free;   ///< space given up by dropped images
+};
+
 class MUI_PUBLIC MythOpenGLPainter : public MythPainter
 {
   public:
@@ -41,6 +66,9 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     void       ClearCache(void);
     void       DeleteTextures(void);
     int        GetTextureFromCache(MythImage *im);
+    uint       AddToAtlas(MythImage *im, const QImage &image);
+    void       ExpireAtlas(uint tex);
+    void       DrawStats(void);
 
     QGLWidget        *realParent;
     MythRenderOpenGL *realRender;
@@ -51,6 +79,15 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     std::list<MythImage *>     m_ImageExpireList;
     std::list<uint>            m_textureDeleteList;
     QMutex                     m_textureDeleteLock;
+
+    QMap<MythImage *, QRect>   m_ImageAtlasMap;
+    QMap<uint, MythGLAtlas *>  m_atlases;
+    std::list<uint>            m_AtlasExpireList;
+
+    /// Images up to this size are put in an atlas texture
+    static const int kAtlasMaxImage;
+    /// Width and height of an atlas texture
+    static const int kAtlasSize;
 };
 
 #endif
@@ -110,6 +110,9 @@ void MythRenderOpenGL::makeCurrent()
 
 void MythRenderOpenGL::doneCurrent()
 {
+    // nothing batched may be left behind when the context is released
+    if (m_lock_level == 1)
+        FlushBatch();
     m_lock_level--;
     if (m_lock_level == 0)
         QGLContext::doneCurrent();
@@ -139,6 +142,7 @@ void MythRenderOpenGL::SetViewPort(const QRect &rect)
         return;
 
     makeCurrent();
+    FlushBatch();
     m_viewport = rect;
     glViewport(m_viewport.left(), m_viewport.top(),
                m_viewport.width(), m_viewport.height());
@@ -149,6 +153,7 @@ void MythRenderOpenGL::SetViewPort(const QRect &rect)
 void MythRenderOpenGL::Flush(bool use_fence)
 {
     makeCurrent();
+    FlushBatch();
 
     if ((m_exts_used & kGLAppleFence) &&
         (m_fence && use_fence))
@@ -217,6 +222,7 @@ void* MythRenderOpenGL::GetTextureBuffer(uint tex, bool create_buffer)
         return NULL;
 
     makeCurrent(); // associated doneCurrent() in UpdateTexture
+    FlushBatch();
 
     EnableTextures(tex);
     glBindTexture(m_textures[tex].m_type, tex);
@@ -270,6 +276,24 @@ void MythRenderOpenGL::UpdateTexture(uint tex, void *buf)
     doneCurrent();
 }
 
+/** \fn MythRenderOpenGL::UpdateTexture(uint, void*, const QRect&)
+ *  \brief Copies buf into the area of a texture without a pixel buffer,
+ *         e.g. a single image in a texture shared by many.
+ */
+void MythRenderOpenGL::UpdateTexture(uint tex, void *buf, const QRect &area)
+{
+    if (!m_textures.contains(tex))
+        return;
+
+    makeCurrent();
+    FlushBatch();
+    glBindTexture(m_textures[tex].m_type, tex);
+    glTexSubImage2D(m_textures[tex].m_type, 0, area.left(), area.top(),
+                    area.width(), area.height(), m_textures[tex].m_data_fmt,
+                    m_textures[tex].m_data_type, buf);
+    doneCurrent();
+}
+
 int MythRenderOpenGL::GetTextureType(bool &rect)
 {
     static bool rects = true;
@@ -400,6 +424,7 @@ void MythRenderOpenGL::SetTextureFilters(uint tex, uint filt, uint wrap)
         filt = GL_LINEAR;
 
     makeCurrent();
+    FlushBatch();
     EnableTextures(tex);
     m_textures[tex].m_filter = filt;
     m_textures[tex].m_wrap   = wrap;
@@ -479,6 +504,7 @@ void MythRenderOpenGL::DeleteTexture(uint tex)
         return;
 
     makeCurrent();
+    FlushBatch();
 
     GLuint gltex = tex;
     glDeleteTextures(1, &gltex);
@@ -506,6 +532,7 @@ bool MythRenderOpenGL::CreateFrameBuffer(uint &fb, uint tex)
     GLuint glfb;
 
     makeCurrent();
+    FlushBatch();
     glCheck();
 
     EnableTextures(tex);
@@ -608,6 +635,7 @@ void MythRenderOpenGL::BindFramebuffer(uint fb)
         return;
 
     makeCurrent();
+    FlushBatch();
     m_glBindFramebuffer(GL_FRAMEBUFFER, fb);
     doneCurrent();
     m_active_fb = fb;
@@ -616,6 +644,7 @@ void MythRenderOpenGL::BindFramebuffer(uint fb)
 void MythRenderOpenGL::ClearFramebuffer(void)
 {
     makeCurrent();
+    FlushBatch();
     glClear(GL_COLOR_BUFFER_BIT);
     doneCurrent();
 }
@@ -632,7 +661,21 @@ void MythRenderOpenGL::DrawBitmap(uint tex, uint target, const QRect *src,
 
     makeCurrent();
     BindFramebuffer(target);
-    DrawBitmapPriv(tex, src, dst, prog, alpha, red, green, blue);
+    if (prog)
+    {
+        FlushBatch();
+        DrawBitmapPriv(tex, src, dst, prog, alpha, red, green, blue);
+    }
+    else
+    {
+        uint32_t color = ((uint32_t)red << 24) + ((uint32_t)green << 16) +
+                         ((uint32_t)blue << 8) + (uint32_t)alpha;
+        if (tex != m_batch_tex || color != m_batch_color)
+            FlushBatch();
+        m_batch_tex   = tex;
+        m_batch_color = color;
+        AddBatchQuad(tex, src, dst);
+    }
     doneCurrent();
 }
 
@@ -648,6 +691,7 @@ void MythRenderOpenGL::DrawBitmap(uint *textures, uint texture_count,
 
     makeCurrent();
     BindFramebuffer(target);
+    FlushBatch();
     DrawBitmapPriv(textures, texture_count, src, dst, prog);
     doneCurrent();
 }
@@ -657,6 +701,7 @@ void MythRenderOpenGL::DrawRect(const QRect &area, const QBrush &fillBrush,
 {
     makeCurrent();
     BindFramebuffer(0);
+    FlushBatch();
     DrawRectPriv(area, fillBrush, linePen, alpha);
     doneCurrent();
 }
@@ -667,10 +712,32 @@ void MythRenderOpenGL::DrawRoundRect(const QRect &area, int cornerRadius,
 {
     makeCurrent();
     BindFramebuffer(0);
+    FlushBatch();
     DrawRoundRectPriv(area, cornerRadius, fillBrush, linePen, alpha);
     doneCurrent();
 }
 
+/** \fn MythRenderOpenGL::GetFrameStats(uint&, uint&, uint&)
+ *  \brief Returns the texture binds, draw calls and bitmaps drawn since
+ *         the last ResetFrameStats(), drawing any batched bitmaps first.
+ */
+void MythRenderOpenGL::GetFrameStats(uint &binds, uint &draws, uint &quads)
+{
+    makeCurrent();
+    FlushBatch();
+    binds = m_frame_binds;
+    draws = m_frame_draws;
+    quads = m_frame_quads;
+    doneCurrent();
+}
+
+void MythRenderOpenGL::ResetFrameStats(void)
+{
+    m_frame_binds = 0;
+    m_frame_draws = 0;
+    m_frame_quads = 0;
+}
+
 void MythRenderOpenGL::Init2DState(void)
 {
     SetBlend(false);
@@ -916,6 +983,15 @@ void MythRenderOpenGL::ResetVars(void)
     m_active_fb       = 0;
     m_blend           = false;
     m_background      = 0x00000000;
+
+    m_batch_tex       = 0;
+    m_batch_color     = 0;
+    m_batch_vertices.clear();
+    m_batch_texcoords.clear();
+
+    m_frame_binds     = 0;
+    m_frame_draws     = 0;
+    m_frame_quads     = 0;
 }
 
 void MythRenderOpenGL::ResetProcs(void)
@@ -1012,6 +1088,8 @@ void MythRenderOpenGL::DeleteOpenGLResources(void)
 
 void MythRenderOpenGL::DeleteTextures(void)
 {
+    FlushBatch();
+
     QHash<GLuint, MythGLTexture>::iterator it;
     for (it = m_textures.begin(); it !=m_textures.end(); ++it)
     {
@@ -1034,6 +1112,56 @@ void MythRenderOpenGL::DeleteFrameBuffers(void)
     Flush(true);
 }
 
+/** \fn MythRenderOpenGL::AddBatchQuad(uint, const QRect*, const QRect*)
+ *  \brief Queues a bitmap to be drawn by FlushBatch(), with any others
+ *         from the same texture, in a single draw call.
+ */
+void MythRenderOpenGL::AddBatchQuad(uint tex, const QRect *src,
+                                    const QRect *dst)
+{
+    if (!UpdateTextureVertices(tex, src, dst))
+        return;
+
+    // the strip is top left, bottom left, top right, bottom right
+    static const int kTriangles[6] = { 0, 1, 2, 2, 1, 3 };
+
+    const GLfloat *data = m_textures[tex].m_vertex_data;
+    for (int i = 0; i < 6; i++)
+    {
+        int vertex = kTriangles[i] * 2;
+        m_batch_vertices.push_back(data[vertex]);
+        m_batch_vertices.push_back(data[vertex + 1]);
+        m_batch_texcoords.push_back(data[vertex + TEX_OFFSET]);
+        m_batch_texcoords.push_back(data[vertex + TEX_OFFSET + 1]);
+    }
+    m_frame_quads++;
+}
+
+/** \fn MythRenderOpenGL::FlushBatch(void)
+ *  \brief Draws the bitmaps queued by AddBatchQuad().
+ *
+ *   Must be called before anything else is drawn, or the queued texture,
+ *   frame buffer or view port changed, so the drawing order is kept.
+ */
+void MythRenderOpenGL::FlushBatch(void)
+{
+    if (m_batch_vertices.empty())
+        return;
+
+    makeCurrent();
+    if (m_textures.contains(m_batch_tex))
+    {
+        DrawBatchPriv(m_batch_tex, &m_batch_vertices[0],
+                      &m_batch_texcoords[0], m_batch_vertices.size() / 2,
+                      m_batch_color & 0xff, m_batch_color >> 24,
+                      (m_batch_color >> 16) & 0xff,
+                      (m_batch_color >> 8) & 0xff);
+    }
+    m_batch_vertices.clear();
+    m_batch_texcoords.clear();
+    doneCurrent();
+}
+
 bool MythRenderOpenGL::UpdateTextureVertices(uint tex, const QRect *src,
                                              const QRect *dst)
 {
@@ -2,6 +2,7 @@
 #define MYTHRENDER_OPENGL_H_
 
 #include <stdint.h>
+#include <vector>
 
 #include <QPainter>
 #include <QGLContext>
@@ -126,6 +127,7 @@ class MUI_PUBLIC MythRenderOpenGL : public QGLContext, public MythRender
 
     void* GetTextureBuffer(uint tex, bool create_buffer = true);
     void  UpdateTexture(uint tex, void *buf);
+    void  UpdateTexture(uint tex, void *buf, const QRect &area);
     int   GetTextureType(bool &rect);
     bool  IsRectTexture(uint type);
     uint  CreateTexture(QSize act_size, bool use_pbo, uint type,
@@ -164,6 +166,9 @@ class MUI_PUBLIC MythRenderOpenGL : public QGLContext, public MythRender
                        int alpha);
     virtual bool RectanglesAreAccelerated(void) { return false; }
 
+    void GetFrameStats(uint &binds, uint &draws, uint &quads);
+    void ResetFrameStats(void);
+
   protected:
     virtual ~MythRenderOpenGL();
     virtual void DrawBitmapPriv(uint tex, const QRect *src, const QRect *dst,
@@ -172,6 +177,9 @@ class MUI_PUBLIC MythRenderOpenGL : public QGLContext, public MythRender
     virtual void DrawBitmapPriv(uint *textures, uint texture_count,
                                 const QRectF *src, const QRectF *dst,
                                 uint prog) = 0;
+    virtual void DrawBatchPriv(uint tex, const GLfloat *vertices,
+                               const GLfloat *texcoords, uint count,
+                               int alpha, int red, int green, int blue) = 0;
     virtual void DrawRectPriv(const QRect &area, const QBrush &fillBrush,
                               const QPen &linePen, int alpha) = 0;
     virtual void DrawRoundRectPriv(const QRect &area, int cornerRadius,
@@ -193,6 +201,8 @@ class MUI_PUBLIC MythRenderOpenGL : public QGLContext, public MythRender
     virtual void DeleteShaders(void) = 0;
     void DeleteFrameBuffers(void);
 
+    void AddBatchQuad(uint tex, const QRect *src, const QRect *dst);
+    void FlushBatch(void);
     bool UpdateTextureVertices(uint tex, const QRect *src, const QRect *dst);
     bool UpdateTextureVertices(uint tex, const QRectF *src, const QRectF *dst);
     GLfloat* GetCachedVertices(GLuint type, const QRect &area);
@@ -236,6 +246,17 @@ class MUI_PUBLIC MythRenderOpenGL : public QGLContext, public MythRender
     QMap<uint64_t,GLuint>   m_cachedVBOS;
     QList<uint64_t>         m_vboExpiry;
 
+    // bitmap batching
+    uint                 m_batch_tex;
+    uint32_t             m_batch_color;
+    std::vector<GLfloat> m_batch_vertices;
+    std::vector<GLfloat> m_batch_texcoords;
+
+    // statistics for the current frame
+    uint     m_frame_binds;
+    uint     m_frame_draws;
+    uint     m_frame_quads;
+
     // Multi-texturing
     MYTH_GLACTIVETEXTUREPROC             m_glActiveTexture;
 
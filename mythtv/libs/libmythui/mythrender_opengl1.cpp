@@ -311,10 +311,12 @@ void MythRenderOpenGL1::DrawBitmapPriv(uint tex, const QRect *src,
     glEnableClientState(GL_TEXTURE_COORD_ARRAY);
     EnableTextures(tex);
     glBindTexture(m_textures[tex].m_type, tex);
+    m_frame_binds++;
     UpdateTextureVertices(tex, src, dst);
     glVertexPointer(2, GL_FLOAT, 0, m_textures[tex].m_vertex_data);
     glTexCoordPointer(2, GL_FLOAT, 0, m_textures[tex].m_vertex_data + TEX_OFFSET);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_frame_draws++;
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
 }
@@ -342,6 +344,7 @@ void MythRenderOpenGL1::DrawBitmapPriv(uint *textures, uint texture_count,
         {
             ActiveTexture(GL_TEXTURE0 + active_tex++);
             glBindTexture(m_textures[textures[i]].m_type, textures[i]);
+            m_frame_binds++;
         }
     }
 
@@ -349,12 +352,34 @@ void MythRenderOpenGL1::DrawBitmapPriv(uint *textures, uint texture_count,
     glVertexPointer(2, GL_FLOAT, 0, m_textures[first].m_vertex_data);
     glTexCoordPointer(2, GL_FLOAT, 0, m_textures[first].m_vertex_data + TEX_OFFSET);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    m_frame_draws++;
 
     ActiveTexture(GL_TEXTURE0);
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
 }
 
+void MythRenderOpenGL1::DrawBatchPriv(uint tex, const GLfloat *vertices,
+                                      const GLfloat *texcoords, uint count,
+                                      int alpha, int red, int green, int blue)
+{
+    EnableShaderObject(0);
+    SetBlend(true);
+    SetColor(red, green, blue, alpha);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    EnableTextures(tex);
+    glBindTexture(m_textures[tex].m_type, tex);
+    m_frame_binds++;
+    glVertexPointer(2, GL_FLOAT, 0, vertices);
+    glTexCoordPointer(2, GL_FLOAT, 0, texcoords);
+    glDrawArrays(GL_TRIANGLES, 0, count);
+    m_frame_draws++;
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
 void MythRenderOpenGL1::DrawRectPriv(const QRect &area, const QBrush &fillBrush,
                                      const QPen &linePen, int alpha)
 {
@@ -369,6 +394,7 @@ void MythRenderOpenGL1::DrawRectPriv(const QRect &area, const QBrush &fillBrush,
         GLfloat *vertices = GetCachedVertices(GL_TRIANGLE_STRIP, area);
         glVertexPointer(2, GL_FLOAT, 0, vertices);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
     }
 
     if (linePen.style() != Qt::NoPen)
@@ -379,6 +405,7 @@ void MythRenderOpenGL1::DrawRectPriv(const QRect &area, const QBrush &fillBrush,
         GLfloat *vertices = GetCachedVertices(GL_LINE_LOOP, area);
         glVertexPointer(2, GL_FLOAT, 0, vertices);
         glDrawArrays(GL_LINE_LOOP, 0, 4);
+        m_frame_draws++;
     }
 
     glDisableClientState(GL_VERTEX_ARRAY);
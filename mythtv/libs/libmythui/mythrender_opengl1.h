@@ -27,6 +27,9 @@ class MUI_PUBLIC MythRenderOpenGL1 : public MythRenderOpenGL
     virtual void DrawBitmapPriv(uint *textures, uint texture_count,
                                 const QRectF *src, const QRectF *dst,
                                 uint prog);
+    virtual void DrawBatchPriv(uint tex, const GLfloat *vertices,
+                               const GLfloat *texcoords, uint count,
+                               int alpha, int red, int green, int blue);
     virtual void DrawRectPriv(const QRect &area, const QBrush &fillBrush,
                               const QPen &linePen, int alpha);
     virtual void DrawRoundRectPriv(const QRect &area, int cornerRadius,
@@ -405,6 +405,7 @@ void MythRenderOpenGL2::DrawBitmapPriv(uint tex, const QRect *src,
 
     EnableTextures(tex);
     glBindTexture(m_textures[tex].m_type, tex);
+    m_frame_binds++;
 
     m_glBindBuffer(GL_ARRAY_BUFFER, m_textures[tex].m_vbo);
     UpdateTextureVertices(tex, src, dst);
@@ -427,6 +428,8 @@ void MythRenderOpenGL2::DrawBitmapPriv(uint tex, const QRect *src,
 
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
+    m_frame_draws++;
+
     m_glDisableVertexAttribArray(TEXTURE_INDEX);
     m_glDisableVertexAttribArray(VERTEX_INDEX);
     m_glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -457,6 +460,7 @@ void MythRenderOpenGL2::DrawBitmapPriv(uint *textures, uint texture_count,
         {
             ActiveTexture(GL_TEXTURE0 + active_tex++);
             glBindTexture(m_textures[textures[i]].m_type, textures[i]);
+            m_frame_binds++;
         }
     }
 
@@ -481,6 +485,58 @@ void MythRenderOpenGL2::DrawBitmapPriv(uint *textures, uint texture_count,
 
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
+    m_frame_draws++;
+
+    m_glDisableVertexAttribArray(TEXTURE_INDEX);
+    m_glDisableVertexAttribArray(VERTEX_INDEX);
+    m_glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MythRenderOpenGL2::DrawBatchPriv(uint tex, const GLfloat *vertices,
+                                      const GLfloat *texcoords, uint count,
+                                      int alpha, int red, int green, int blue)
+{
+    uint prog = m_shaders[kShaderDefault];
+
+    EnableShaderObject(prog);
+    SetShaderParams(prog, &m_projection[0][0], "u_projection");
+    SetBlend(true);
+
+    EnableTextures(tex);
+    glBindTexture(m_textures[tex].m_type, tex);
+    m_frame_binds++;
+
+    // vertices followed by texture coordinates, in the VBO when there is one
+    GLuint size = count * VERTEX_SIZE * sizeof(GLfloat);
+    const char *vertex_ptr  = (const char *)vertices;
+    const char *texture_ptr = (const char *)texcoords;
+    if (m_textures[tex].m_vbo)
+    {
+        m_glBindBuffer(GL_ARRAY_BUFFER, m_textures[tex].m_vbo);
+        m_glBufferData(GL_ARRAY_BUFFER, size * 2, NULL, GL_STREAM_DRAW);
+        char* target = (char*)m_glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+        if (target)
+        {
+            memcpy(target, vertices, size);
+            memcpy(target + size, texcoords, size);
+        }
+        m_glUnmapBuffer(GL_ARRAY_BUFFER);
+        vertex_ptr  = NULL;
+        texture_ptr = vertex_ptr + size;
+    }
+
+    m_glEnableVertexAttribArray(VERTEX_INDEX);
+    m_glEnableVertexAttribArray(TEXTURE_INDEX);
+
+    m_glVertexAttribPointer(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE,
+                            VERTEX_SIZE * sizeof(GLfloat), vertex_ptr);
+    m_glVertexAttrib4f(COLOR_INDEX, red / 255.0, green / 255.0, blue / 255.0, alpha / 255.0);
+    m_glVertexAttribPointer(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE,
+                            TEXTURE_SIZE * sizeof(GLfloat), texture_ptr);
+
+    glDrawArrays(GL_TRIANGLES, 0, count);
+    m_frame_draws++;
+
     m_glDisableVertexAttribArray(TEXTURE_INDEX);
     m_glDisableVertexAttribArray(VERTEX_INDEX);
     m_glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -538,6 +594,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the top right segment
         m_parameters[0][0] = tr.left();
@@ -548,6 +605,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the bottom left segment
         m_parameters[0][0] = bl.left() + rad;
@@ -558,6 +616,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the bottom right segment
         m_parameters[0][0] = br.left();
@@ -568,6 +627,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Fill the remaining areas
         QRect main(area.left() + rad, area.top(), area.width() - dia, area.height());
@@ -582,16 +642,19 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
         GetCachedVBO(GL_TRIANGLE_STRIP, left);
         m_glVertexAttribPointer(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
         GetCachedVBO(GL_TRIANGLE_STRIP, right);
         m_glVertexAttribPointer(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
         m_glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
@@ -625,6 +688,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the top right edge segment
         m_parameters[0][0] = tr.left();
@@ -635,6 +699,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the bottom left edge segment
         m_parameters[0][0] = bl.left() + rad;
@@ -645,6 +710,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the bottom right edge segment
         m_parameters[0][0] = br.left();
@@ -655,6 +721,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Vertical lines
         SetShaderParams(vline, &m_projection[0][0], "u_projection");
@@ -670,6 +737,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the right line segment
         vl.translate(area.width() - linePen.width(), 0);
@@ -680,6 +748,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Horizontal lines
         SetShaderParams(hline, &m_projection[0][0], "u_projection");
@@ -694,6 +763,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         // Draw the bottom line segment
         hl.translate(0, area.height() - linePen.width());
@@ -704,6 +774,7 @@ void MythRenderOpenGL2::DrawRoundRectPriv(const QRect &area, int cornerRadius,
                                 VERTEX_SIZE * sizeof(GLfloat),
                                (const void *) kVertexOffset);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        m_frame_draws++;
 
         m_glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
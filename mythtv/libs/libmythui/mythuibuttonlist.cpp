@@ -20,6 +20,9 @@
 #define LOC     QString("MythUIButtonList(%1): ").arg(objectName())
 #define LOC_ERR QString("MythUIButtonList(%1), Error: ").arg(objectName())
 
+/// Fewest items of a provided list kept filled in, see SetProvider()
+static const int kMinProvidedItems = 128;
+
 MythUIButtonList::MythUIButtonList(MythUIType *parent, const QString &name)
               : MythUIType(parent, name)
 {
@@ -57,6 +60,8 @@ void MythUIButtonList::Const(void)
     m_itemCount = 0;
     m_keepSelAtBottom = false;
 
+    m_provider = NULL;
+
     m_initialized      = false;
     m_needsUpdate      = false;
     m_clearing         = false;
@@ -130,6 +135,8 @@ void MythUIButtonList::SetActive(bool active)
 void MythUIButtonList::Reset()
 {
     m_ButtonToItem.clear();
+    m_provider = NULL;
+    m_providedItems.clear();
 
     if (m_itemList.isEmpty())
         return;
@@ -155,6 +162,82 @@ void MythUIButtonList::Update()
     SetRedraw();
 }
 
+/**
+ * \brief Fills the list with count items that are only filled in by the
+ *        provider when they are drawn or asked for.
+ *
+ * Building a list of thousands of items this way costs about the same as
+ * building the few that are visible. Only a limited number of items are
+ * kept filled in, so pointers to items of such a list should not be kept,
+ * and changes made to an item after FillItem() may be lost. Call this
+ * again after the data behind the list has changed; Reset() removes the
+ * provider. Items must not be added to the list while it has a provider.
+ */
+void MythUIButtonList::SetProvider(MythUIButtonListProvider *provider,
+                                   int count)
+{
+    Reset();
+
+    if (!provider || count <= 0)
+        return;
+
+    m_provider = provider;
+    for (int i = 0; i < count; ++i)
+        m_itemList.append(NULL);
+    m_itemCount = count;
+
+    emit itemSelected(GetItemCurrent());
+
+    Update();
+}
+
+/// \brief Returns the item at pos, filling it in first if need be.
+MythUIButtonListItem *MythUIButtonList::ItemAt(int pos) const
+{
+    if (m_provider)
+        return ((MythUIButtonList*)this)->ProvideItem(pos);
+
+    return m_itemList.at(pos);
+}
+
+MythUIButtonListItem *MythUIButtonList::ProvideItem(int pos)
+{
+    MythUIButtonListItem *item = m_itemList.at(pos);
+    if (item)
+    {
+        m_providedItems.removeOne(pos);
+        m_providedItems.append(pos);
+        return item;
+    }
+
+    item = new MythUIButtonListItem(this);
+    m_itemList[pos] = item;
+    m_provider->FillItem(item, pos);
+    m_providedItems.append(pos);
+
+    // Drop the least recently used items, except the selected item
+    // and the ones on the buttons.
+    int maxItems = qMax(kMinProvidedItems, (int)m_itemsVisible * 4);
+    QList<int>::iterator it = m_providedItems.begin();
+    while (m_providedItems.size() > maxItems && it != m_providedItems.end())
+    {
+        MythUIButtonListItem *old = m_itemList.at(*it);
+        if (*it == m_selPosition || *it == pos ||
+            m_ButtonToItem.key(old, -1) >= 0)
+        {
+            ++it;
+            continue;
+        }
+
+        // cleared first, so RemoveItem() leaves the list alone
+        m_itemList[*it] = NULL;
+        delete old;
+        it = m_providedItems.erase(it);
+    }
+
+    return item;
+}
+
 /*
  * The "width" of a button determines it relative position when using
  * Dynamic-Layout.
@@ -217,7 +300,7 @@ MythUIGroup *MythUIButtonList::PrepareButton(int buttonIdx, int itemIdx,
 {
     MythUIStateType *realButton;
     MythUIGroup *buttonstate;
-    MythUIButtonListItem* buttonItem = m_itemList[itemIdx];
+    MythUIButtonListItem* buttonItem = ItemAt(itemIdx);
 
     buttonIdx += button_shift;
     if (buttonIdx < 0 || buttonIdx + 1 > m_maxVisible)
@@ -1243,11 +1326,11 @@ void MythUIButtonList::SetPosition(void)
     if (it < m_itemList.begin())
         it = m_itemList.begin();
 
-    int curItem = GetItemPos(*it);
+    int curItem = it - m_itemList.begin();
     while (it < m_itemList.end() && button < (int)m_itemsVisible)
     {
         realButton = m_ButtonList[button];
-        buttonItem = *it;
+        buttonItem = ItemAt(curItem);
 
         if (!realButton || !buttonItem)
             break;
@@ -1399,7 +1482,7 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     Update();
 
     if (m_selPosition < m_itemCount)
-        emit itemSelected(m_itemList.at(m_selPosition));
+        emit itemSelected(ItemAt(m_selPosition));
     else
         emit itemSelected(NULL);
 }
@@ -1411,7 +1494,7 @@ void MythUIButtonList::SetValueByData(QVariant data)
 
     for (int i = 0; i < m_itemList.size(); ++i)
     {
-        MythUIButtonListItem *item = m_itemList.at(i);
+        MythUIButtonListItem *item = ItemAt(i);
         if (item->GetData() == data)
         {
             SetItemCurrent(item);
@@ -1455,7 +1538,7 @@ MythUIButtonListItem* MythUIButtonList::GetItemCurrent() const
         m_selPosition < 0)
         return NULL;
 
-    return m_itemList.at(m_selPosition);
+    return ItemAt(m_selPosition);
 }
 
 int MythUIButtonList::GetIntValue() const
@@ -1488,7 +1571,7 @@ QVariant MythUIButtonList::GetDataValue() const
 MythUIButtonListItem* MythUIButtonList::GetItemFirst() const
 {
     if (!m_itemList.empty())
-        return m_itemList[0];
+        return ItemAt(0);
     return NULL;
 }
 
@@ -1528,7 +1611,7 @@ MythUIButtonListItem* MythUIButtonList::GetItemAt(int pos) const
     if (pos < 0 || pos >= m_itemList.size())
         return NULL;
 
-    return m_itemList.at(pos);
+    return ItemAt(pos);
 }
 
 MythUIButtonListItem* MythUIButtonList::GetItemByData(QVariant data)
@@ -1538,7 +1621,7 @@ MythUIButtonListItem* MythUIButtonList::GetItemByData(QVariant data)
 
     for (int i = 0; i < m_itemList.size(); ++i)
     {
-        MythUIButtonListItem *item = m_itemList.at(i);
+        MythUIButtonListItem *item = ItemAt(i);
         if (item->GetData() == data)
             return item;
     }
@@ -1556,7 +1639,7 @@ int MythUIButtonList::GetItemPos(MythUIButtonListItem* item) const
 void MythUIButtonList::InitButton(int itemIdx, MythUIStateType* & realButton,
                                   MythUIButtonListItem* & buttonItem)
 {
-    buttonItem = m_itemList[itemIdx];
+    buttonItem = ItemAt(itemIdx);
 
     if (m_maxVisible == 0)
     {
@@ -1945,15 +2028,13 @@ bool MythUIButtonList::MoveToNamedPosition(const QString &position_name)
 
     bool found_it = false;
     int selectedPosition = 0;
-    QList<MythUIButtonListItem*>::iterator it = m_itemList.begin();
-    while(it != m_itemList.end())
+    while (selectedPosition < m_itemList.size())
     {
-        if ((*it)->GetText() == position_name)
+        if (ItemAt(selectedPosition)->GetText() == position_name)
         {
             found_it = true;
             break;
         }
-        ++it;
         ++selectedPosition;
     }
 
@@ -1966,7 +2047,7 @@ bool MythUIButtonList::MoveToNamedPosition(const QString &position_name)
 
 bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
 {
-    if (GetItemCurrent() != item)
+    if (m_provider || GetItemCurrent() != item)
         return false;
     if (item == m_itemList.first() && up)
         return false;
@@ -2008,9 +2089,15 @@ bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
 
 void MythUIButtonList::SetAllChecked(MythUIButtonListItem::CheckState state)
 {
+    // Items of a provided list that are not filled in yet get their
+    // state from the provider.
     QMutableListIterator<MythUIButtonListItem*> it(m_itemList);
     while (it.hasNext())
-        it.next()->setChecked(state);
+    {
+        MythUIButtonListItem *item = it.next();
+        if (item)
+            item->setChecked(state);
+    }
 }
 
 void MythUIButtonList::Init()
@@ -2695,6 +2782,16 @@ MythUIButtonListItem::MythUIButtonListItem(MythUIButtonList* lbtype,
         m_parent->InsertItem(this, listPosition);
 }
 
+/// Item of a list with a provider, see MythUIButtonList::SetProvider()
+MythUIButtonListItem::MythUIButtonListItem(MythUIButtonList *lbtype)
+{
+    m_parent    = lbtype;
+    m_image     = NULL;
+    m_checkable = false;
+    m_state     = CantCheck;
+    m_showArrow = false;
+}
+
 MythUIButtonListItem::~MythUIButtonListItem()
 {
     if (m_parent)
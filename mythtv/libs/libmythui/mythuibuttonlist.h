@@ -85,6 +85,8 @@ class MUI_PUBLIC MythUIButtonListItem
     virtual void SetToRealButton(MythUIStateType *button, bool selected);
 
   protected:
+    explicit MythUIButtonListItem(MythUIButtonList *lbtype);
+
     MythUIButtonList *m_parent;
     QString         m_text;
     QString         m_fontState;
@@ -104,6 +106,22 @@ class MUI_PUBLIC MythUIButtonListItem
     friend class MythGenericTree;
 };
 
+/**
+ * \class MythUIButtonListProvider
+ *
+ * \brief Supplies the items of a MythUIButtonList as they are needed.
+ *
+ * See MythUIButtonList::SetProvider().
+ */
+class MUI_PUBLIC MythUIButtonListProvider
+{
+  public:
+    virtual ~MythUIButtonListProvider() {}
+
+    /// Sets the text, images, states and data of the item at pos.
+    virtual void FillItem(MythUIButtonListItem *item, int pos) = 0;
+};
+
 /**
  * \class MythUIButtonList
  *
@@ -134,6 +152,8 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void Reset();
     void Update();
 
+    void SetProvider(MythUIButtonListProvider *provider, int count);
+
     virtual void SetValue(int value) { MoveToNamedPosition(QString::number(value)); }
     virtual void SetValue(QString value) { MoveToNamedPosition(value); }
     void SetValueByData(QVariant data);
@@ -243,6 +263,9 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
 
     void SanitizePosition(void);
 
+    MythUIButtonListItem *ItemAt(int pos) const;
+    MythUIButtonListItem *ProvideItem(int pos);
+
     /**/
 
     LayoutType  m_layout;
@@ -291,6 +314,9 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
 
     QList<MythUIButtonListItem*> m_itemList;
 
+    MythUIButtonListProvider *m_provider;
+    QList<int>  m_providedItems; ///< positions filled in, oldest first
+
     bool m_drawFromBottom;
 
     QString     m_lcdTitle;
@@ -16,6 +16,8 @@
 #include <QThreadPool>
 #include <QSize>
 #include <QFile>
+#include <QBuffer>
+#include <QImageReader>
 
 #include "mythdirs.h"
 #include "mythlogging.h"
@@ -1244,7 +1246,41 @@ bool MythUIHelper::FindThemeFile(QString &path)
     return foundit;
 }
 
-QImage *MythUIHelper::LoadScaleImage(QString filename, bool fromcache)
+/**
+ *  \brief Reads an image, letting the decoder drop detail that scaling
+ *         it to minSize would lose anyway.
+ *
+ *   JPEG can be decoded at 1/2, 1/4 or 1/8 of its size for much less
+ *   work than a full decode. The largest such reduction that still leaves
+ *   the image at least minSize after the theme scaling by wmult and
+ *   hmult is used, the final resize is left to the caller.
+ */
+static void read_scaled_image(QImageReader &reader, QImage &image,
+                              const QSize &minSize, float wmult, float hmult)
+{
+    if (minSize.width() > 0 && minSize.height() > 0 &&
+        reader.format() == "jpeg" &&
+        reader.supportsOption(QImageIOHandler::ScaledSize))
+    {
+        QSize size = reader.size();
+        int denom = 8;
+        while (denom > 1 &&
+               (size.width()  * wmult / denom < minSize.width() ||
+                size.height() * hmult / denom < minSize.height()))
+        {
+            denom /= 2;
+        }
+
+        if (denom > 1)
+            reader.setScaledSize(QSize(size.width()  / denom,
+                                       size.height() / denom));
+    }
+
+    reader.read(&image);
+}
+
+QImage *MythUIHelper::LoadScaleImage(QString filename, bool fromcache,
+                                     const QSize &minSize)
 {
     LOG(VB_GUI | VB_FILE, LOG_INFO, 
         QString("LoadScaleImage(%1)").arg(filename));
@@ -1280,7 +1316,11 @@ QImage *MythUIHelper::LoadScaleImage(QString filename, bool fromcache)
         delete rf;
 
         if (loaded)
-            tmpimage.loadFromData(data);
+        {
+            QBuffer buffer(&data);
+            QImageReader reader(&buffer);
+            read_scaled_image(reader, tmpimage, minSize, wmult, hmult);
+        }
         else
         {
             LOG(VB_GENERAL, LOG_ERR,
@@ -1304,7 +1344,8 @@ QImage *MythUIHelper::LoadScaleImage(QString filename, bool fromcache)
     }
     else
     {
-        tmpimage.load(filename);
+        QImageReader reader(filename);
+        read_scaled_image(reader, tmpimage, minSize, wmult, hmult);
     }
 
     if (width != d->m_baseWidth || height != d->m_baseHeight)
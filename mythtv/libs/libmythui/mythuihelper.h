@@ -80,7 +80,8 @@ class MUI_PUBLIC MythUIHelper
     bool IsGeometryOverridden(void);
 
     QPixmap *LoadScalePixmap(QString filename, bool fromcache = true);
-    QImage *LoadScaleImage(QString filename, bool fromcache = true);
+    QImage *LoadScaleImage(QString filename, bool fromcache = true,
+                           const QSize &minSize = QSize());
     MythImage *LoadCacheImage(QString srcfile, QString label,
                               MythPainter *painter,
                               ImageCacheMode cacheMode = kCacheNormal);
@@ -17,6 +17,7 @@
 #include <QRunnable>
 #include <QEvent>
 #include <QCoreApplication>
+#include <QTime>
 
 // libmythbase
 #include "mythlogging.h"
@@ -66,6 +67,56 @@ class ImageLoadEvent : public QEvent
 QEvent::Type ImageLoadEvent::kEventType =
     (QEvent::Type) QEvent::registerEventType();
 
+/// Live MythUIImages and how many of their loads are running, so that
+/// queued loads of a deleted or changed image are skipped, and deleting
+/// an image only waits for its own loads.
+static QMutex                    s_imageLoadsLock;
+static QWaitCondition            s_imageLoadsDone;
+static QHash<MythUIImage*, int>  s_imageLoads;
+
+/// Image load statistics, logged every kImageStatsInterval loads
+static QMutex s_imageStatsLock;
+static uint   s_imageStatsLoads     = 0;
+static uint   s_imageStatsCacheHits = 0;
+static uint   s_imageStatsQueued    = 0;
+static int    s_imageStatsQueueWait = 0;
+static int    s_imageStatsMaxWait   = 0;
+static const uint kImageStatsInterval = 200;
+
+/// Counts a background load that waited queueWait ms to start
+static void image_queue_stats(int queueWait)
+{
+    QMutexLocker locker(&s_imageStatsLock);
+    s_imageStatsQueued++;
+    s_imageStatsQueueWait += queueWait;
+    s_imageStatsMaxWait = qMax(s_imageStatsMaxWait, queueWait);
+}
+
+/// Counts a loaded image, and logs the statistics now and then
+static void image_load_stats(bool cacheHit)
+{
+    QMutexLocker locker(&s_imageStatsLock);
+    s_imageStatsLoads++;
+    if (cacheHit)
+        s_imageStatsCacheHits++;
+
+    if (s_imageStatsLoads < kImageStatsInterval)
+        return;
+
+    LOG(VB_GUI | VB_FILE, LOG_DEBUG,
+        QString("Image loads: %1, %2% from cache; background loads: %3, "
+                "%4 ms average and %5 ms longest wait in queue")
+            .arg(s_imageStatsLoads)
+            .arg(s_imageStatsCacheHits * 100 / s_imageStatsLoads)
+            .arg(s_imageStatsQueued)
+            .arg(s_imageStatsQueued ?
+                 s_imageStatsQueueWait / (int)s_imageStatsQueued : 0)
+            .arg(s_imageStatsMaxWait));
+
+    s_imageStatsLoads = s_imageStatsCacheHits = s_imageStatsQueued = 0;
+    s_imageStatsQueueWait = s_imageStatsMaxWait = 0;
+}
+
 /*!
 * \class ImageLoadThread
 */
@@ -81,10 +132,16 @@ class ImageLoadThread : public QRunnable
     {
         m_basefile.detach();
         m_filename.detach();
+        m_queued.start();
     }
 
     void run()
     {
+        image_queue_stats(m_queued.elapsed());
+
+        if (!Begin())
+            return;
+
         threadRegister("ImageLoad");
         QString tmpFilename;
         if (!(m_filename.startsWith("myth://")))
@@ -106,15 +163,49 @@ class ImageLoadThread : public QRunnable
             QCoreApplication::postEvent(m_parent, le);
         }
         threadDeregister();
+
+        End();
     }
 
   private:
+    /// Returns false if the image is gone or shows another file by now
+    bool Begin(void)
+    {
+        QMutexLocker locker(&s_imageLoadsLock);
+
+        if (!s_imageLoads.contains(m_parent))
+            return false;
+
+        m_parent->d->m_UpdateLock.lockForRead();
+        bool wanted = (m_parent->m_Filename == m_basefile);
+        m_parent->d->m_UpdateLock.unlock();
+
+        if (!wanted)
+        {
+            LOG(VB_GUI | VB_FILE, LOG_DEBUG,
+                QString("ImageLoadThread: '%1' no longer wanted, skipped")
+                    .arg(m_filename));
+            return false;
+        }
+
+        s_imageLoads[m_parent]++;
+        return true;
+    }
+
+    void End(void)
+    {
+        QMutexLocker locker(&s_imageLoadsLock);
+        s_imageLoads[m_parent]--;
+        s_imageLoadsDone.wakeAll();
+    }
+
     MythUIImage *m_parent;
     QString      m_basefile;
     QString      m_filename;
     int          m_number;
     QSize        m_ForceSize;
     ImageCacheMode m_cacheMode;
+    QTime        m_queued;
 };
 
 /////////////////////////////////////////////////////////////////
@@ -183,10 +274,12 @@ MythUIImage::MythUIImage(MythUIType *parent, const QString &name)
 
 MythUIImage::~MythUIImage()
 {
-    // Wait until all image loading threads are complete or bad things
-    // may happen if this MythUIImage disappears when a queued thread
-    // needs it.
-    GetMythUI()->GetImageThreadPool()->waitForDone();
+    // Wait for our running loads, the queued ones skip a deleted image.
+    s_imageLoadsLock.lock();
+    while (s_imageLoads.value(this) > 0)
+        s_imageLoadsDone.wait(&s_imageLoadsLock);
+    s_imageLoads.remove(this);
+    s_imageLoadsLock.unlock();
 
     Clear();
     if (m_maskImage)
@@ -271,6 +364,9 @@ void MythUIImage::Init(void)
     m_animationCycle = kCycleStart;
     m_animationReverse = false;
     m_animatedImage = false;
+
+    QMutexLocker locker(&s_imageLoadsLock);
+    s_imageLoads[this] = 0;
 }
 
 /**
@@ -619,7 +715,9 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
                 QString("Load(), spawning thread to load '%1'").arg(filename));
             ImageLoadThread *bImgThread = new ImageLoadThread(
                 this, bFilename, filename, i, bForceSize, cacheMode2);
-            GetMythUI()->GetImageThreadPool()->start(bImgThread);
+            // what is on screen now is decoded first
+            GetMythUI()->GetImageThreadPool()->start(
+                bImgThread, IsVisible(true) ? 1 : 0);
         }
         else
         {
@@ -755,6 +853,8 @@ MythImage *MythUIImage::LoadImage(
         bool ok = false;
         if (imageReader.supportsAnimation())
             ok = image->Load(imageReader);
+        else if (bForceResize)
+            ok = image->Load(filename, true, QSize(w, h));
         else
             ok = image->Load(filename);
 
@@ -771,6 +871,8 @@ MythImage *MythUIImage::LoadImage(
         }
     }
 
+    image_load_stats(bFoundInCache);
+
     if (!bFoundInCache)
     {
         if (bForceResize)
@@ -263,7 +263,9 @@ bool MythUIType::NeedsRedraw(void) const
 
 void MythUIType::ResetNeedsRedraw(void)
 {
+    // the dirty area has been collected, don't report it again
     m_NeedsRedraw = false;
+    m_DirtyRegion = QRegion();
 
     QList<MythUIType *>::Iterator it;
     for (it = m_ChildrenList.begin(); it != m_ChildrenList.end(); ++it)
@@ -275,6 +277,11 @@ void MythUIType::SetRedraw(void)
     if (m_Area.width() == 0 || m_Area.height() == 0)
         return;
 
+    // Nothing of a hidden widget is on screen, SetVisible() marks its
+    // area as it is hidden or shown again.
+    if (!m_Visible)
+        return;
+
     m_NeedsRedraw = true;
 
     if (m_DirtyRegion.isEmpty())
@@ -289,7 +296,7 @@ void MythUIType::SetRedraw(void)
 void MythUIType::SetChildNeedsRedraw(MythUIType *child)
 {
     QRegion childRegion = child->GetDirtyArea();
-    if (childRegion.isEmpty())
+    if (childRegion.isEmpty() || !m_Visible)
         return;
 
     childRegion.translate(m_Area.x(), m_Area.y());
@@ -932,8 +939,17 @@ void MythUIType::SetVisible(bool visible)
     if (visible == m_Visible)
         return;
 
-    m_Visible = visible;
-    SetRedraw();
+    // SetRedraw() ignores hidden widgets, so mark the area while visible
+    if (visible)
+    {
+        m_Visible = true;
+        SetRedraw();
+    }
+    else
+    {
+        SetRedraw();
+        m_Visible = false;
+    }
 
     if (m_Visible)
         emit Showing();
@@ -0,0 +1,421 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpcompressor.cpp
+// Created     : Oct. 19, 2026
+//
+// Purpose     : gzip/deflate Content-Encoding support for HTTPRequest
+//
+// Copyright (c) 2026 MythTV Developers <mythtv-dev@mythtv.org>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or at your option any later version of the LGPL.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <sys/time.h>
+#include <string.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include "httpcompressor.h"
+#include "upnp.h"
+#include "compat.h"
+#include "mythlogging.h"
+
+#define OUTPUT_BLOCK_SIZE   16384
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpCompressor Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+HttpCompressor::HttpCompressor( const QString &sEncoding, int nLevel )
+              : m_bValid   ( false     ),
+                m_sEncoding( sEncoding ),
+                m_nBytesIn ( 0         ),
+                m_nBytesOut( 0         ),
+                m_nUSecs   ( 0         )
+{
+    memset( &m_stream, 0, sizeof( m_stream ));
+
+    // windowBits + 16 makes zlib write a gzip header & trailer instead
+    // of the zlib wrapper used by "deflate".
+
+    int nWindowBits = (sEncoding == "gzip") ? MAX_WBITS + 16 : MAX_WBITS;
+
+    int nRet = deflateInit2( &m_stream, nLevel, Z_DEFLATED, nWindowBits,
+                             8, Z_DEFAULT_STRATEGY );
+
+    if (nRet == Z_OK)
+        m_bValid = true;
+    else
+        LOG(VB_GENERAL, LOG_ERR,
+            QString("HttpCompressor - deflateInit2 failed (%1)").arg(nRet));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpCompressor::~HttpCompressor()
+{
+    if (m_bValid)
+        deflateEnd( &m_stream );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpCompressor::Compress( const char *pData, qint64 nLen,
+                               QByteArray &out, bool bFinish )
+{
+    if (!m_bValid)
+        return false;
+
+    struct timeval tvStart, tvEnd;
+    gettimeofday( &tvStart, NULL );
+
+    m_stream.next_in  = (Bytef *)pData;
+    m_stream.avail_in = (uInt)nLen;
+
+    int nFlush = bFinish ? Z_FINISH : Z_NO_FLUSH;
+    int nRet   = Z_OK;
+
+    do
+    {
+        int nOffset = out.size();
+
+        out.resize( nOffset + OUTPUT_BLOCK_SIZE );
+
+        m_stream.next_out  = (Bytef *)out.data() + nOffset;
+        m_stream.avail_out = OUTPUT_BLOCK_SIZE;
+
+        nRet = deflate( &m_stream, nFlush );
+
+        int nProduced = OUTPUT_BLOCK_SIZE - m_stream.avail_out;
+
+        out.resize( nOffset + nProduced );
+        m_nBytesOut += nProduced;
+
+        if (nRet == Z_STREAM_ERROR)
+            break;
+
+    } while (m_stream.avail_out == 0);
+
+    m_nBytesIn += nLen;
+
+    gettimeofday( &tvEnd, NULL );
+
+    m_nUSecs += (tvEnd.tv_sec  - tvStart.tv_sec) * 1000000LL +
+                (tvEnd.tv_usec - tvStart.tv_usec);
+
+    if (nRet == Z_STREAM_ERROR)
+    {
+        LOG(VB_GENERAL, LOG_ERR, "HttpCompressor - deflate failed");
+        m_bValid = false;
+        return false;
+    }
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Picks gzip or deflate from an Accept-Encoding header, honouring q=0.
+// Returns an empty string if neither is acceptable or compression is off.
+/////////////////////////////////////////////////////////////////////////////
+
+QString HttpCompressor::GetEncoding( const QString &sAcceptEncoding )
+{
+    if (sAcceptEncoding.isEmpty() || GetThreshold() <= 0)
+        return QString();
+
+    float fGzip    = 0.0;
+    float fDeflate = 0.0;
+    float fAny     = -1.0;     // q of "*", -1 if not given
+    bool  bGzip    = false;    // named explicitly, "*" doesn't apply
+    bool  bDeflate = false;
+
+    QStringList codings = sAcceptEncoding.toLower().split( ',' );
+
+    for (QStringList::iterator it = codings.begin(); it != codings.end(); ++it)
+    {
+        QStringList parts  = (*it).split( ';' );
+        QString     sCoding = parts[0].trimmed();
+        float       fQ      = 1.0;
+
+        for (int nIdx = 1; nIdx < parts.count(); ++nIdx)
+        {
+            QString sParam = parts[ nIdx ].trimmed();
+
+            if (sParam.startsWith( "q=" ))
+                fQ = sParam.mid( 2 ).toFloat();
+        }
+
+        if (sCoding == "gzip" || sCoding == "x-gzip")
+        {
+            fGzip = fQ;
+            bGzip = true;
+        }
+        else if (sCoding == "deflate")
+        {
+            fDeflate = fQ;
+            bDeflate = true;
+        }
+        else if (sCoding == "*")
+            fAny = fQ;
+    }
+
+    // "*" only covers codings not listed, see RFC 7231 section 5.3.4.
+
+    if (fAny >= 0.0)
+    {
+        if (!bGzip)    fGzip    = fAny;
+        if (!bDeflate) fDeflate = fAny;
+    }
+
+    if (fGzip > 0.0 && fGzip >= fDeflate)
+        return "gzip";
+
+    if (fDeflate > 0.0)
+        return "deflate";
+
+    return QString();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Images, video & audio are already compressed.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpCompressor::IsCompressible( const QString &sContentType )
+{
+    QString sType = sContentType.section( ';', 0, 0 ).trimmed().toLower();
+
+    return (sType.startsWith( "text/"        ) ||
+            sType.endsWith  ( "xml"          ) ||
+            sType.endsWith  ( "json"         ) ||
+            sType.endsWith  ( "javascript"   ) ||
+            sType == "image/svg+xml");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+int HttpCompressor::GetLevel()
+{
+    int nLevel = UPnp::GetConfiguration()->GetValue( "HTTP/CompressLevel",
+                                                     Z_DEFAULT_COMPRESSION );
+
+    if (nLevel < Z_DEFAULT_COMPRESSION || nLevel > Z_BEST_COMPRESSION)
+        nLevel = Z_DEFAULT_COMPRESSION;
+
+    return nLevel;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Bodies smaller than this aren't worth the CPU.  0 disables compression.
+/////////////////////////////////////////////////////////////////////////////
+
+qint64 HttpCompressor::GetThreshold()
+{
+    return UPnp::GetConfiguration()->GetValue( "HTTP/CompressThreshold", 1024 );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QByteArray HttpCompressor::CompressBuffer( const QByteArray &data,
+                                           const QString    &sEncoding,
+                                           int              *pTimeMS )
+{
+    QByteArray     out;
+    HttpCompressor compressor( sEncoding, GetLevel() );
+
+    out.reserve( data.size() / 4 );
+
+    if (!compressor.Compress( data.constData(), data.size(), out, true ))
+        out.clear();
+
+    if (pTimeMS != NULL)
+        *pTimeMS = compressor.TimeMS();
+
+    return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpCompressCache Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+HttpCompressCache *HttpCompressCache::g_pCache = NULL;
+QMutex             HttpCompressCache::g_lock;
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpCompressCache::HttpCompressCache() : m_nTotalBytes( 0 )
+{
+    m_nMaxBytes = 1024LL * UPnp::GetConfiguration()->GetValue(
+                               "HTTP/CompressCacheKB", 8192 );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpCompressCache *HttpCompressCache::Instance()
+{
+    QMutexLocker locker( &g_lock );
+
+    if (g_pCache == NULL)
+        g_pCache = new HttpCompressCache();
+
+    return g_pCache;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QByteArray HttpCompressCache::Get( const QString &sFileName,
+                                   const QString &sEncoding )
+{
+    QFileInfo info( sFileName );
+
+    if (!info.exists())
+        return QByteArray();
+
+    QString sKey = sEncoding + ':' + info.absoluteFilePath();
+
+    // ----------------------------------------------------------------------
+    // Return the cached copy if the file hasn't changed
+    // ----------------------------------------------------------------------
+
+    {
+        QMutexLocker locker( &m_lock );
+
+        EntryMap::iterator it = m_entries.find( sKey );
+
+        if (it != m_entries.end())
+        {
+            if ((it->m_dtModified == info.lastModified()) &&
+                (it->m_nSize      == info.size()))
+            {
+                m_lru.removeOne( sKey );
+                m_lru.append   ( sKey );
+
+                return it->m_data;
+            }
+
+            m_nTotalBytes -= it->m_data.size();
+            m_entries.erase( it );
+            m_lru.removeOne( sKey );
+        }
+    }
+
+    // ----------------------------------------------------------------------
+    // Use a precompressed copy shipped next to the file when there is one,
+    // otherwise compress it (outside of the lock).
+    // ----------------------------------------------------------------------
+
+    Entry entry;
+
+    entry.m_dtModified = info.lastModified();
+    entry.m_nSize      = info.size();
+
+    QFileInfo gzInfo( info.absoluteFilePath() + ".gz" );
+
+    bool bPrecompressed = (sEncoding == "gzip") && gzInfo.exists() &&
+                          (gzInfo.lastModified() >= info.lastModified()) &&
+                          (gzInfo.size() <= m_nMaxBytes);
+
+    // A file too big to be cached is sent uncompressed, rather than being
+    // read into memory and compressed again for every request.
+
+    if (!bPrecompressed && (info.size() > m_nMaxBytes))
+        return QByteArray();
+
+    if (bPrecompressed)
+    {
+        QFile gzFile( gzInfo.absoluteFilePath() );
+
+        if (gzFile.open( QIODevice::ReadOnly ))
+            entry.m_data = gzFile.readAll();
+    }
+
+    if (entry.m_data.isEmpty())
+    {
+        QFile file( info.absoluteFilePath() );
+
+        if (!file.open( QIODevice::ReadOnly ))
+            return QByteArray();
+
+        int nMS = 0;
+
+        entry.m_data = HttpCompressor::CompressBuffer( file.readAll(), sEncoding,
+                                                       &nMS );
+
+        LOG(VB_UPNP, LOG_DEBUG,
+            QString("HttpCompressCache - %1 (%2) %3 -> %4 bytes in %5ms")
+                .arg(sFileName) .arg(sEncoding) .arg(info.size())
+                .arg(entry.m_data.size()) .arg(nMS));
+    }
+
+    // Not worth sending compressed, remember that too.
+
+    if (entry.m_data.size() >= info.size())
+        entry.m_data.clear();
+
+    QMutexLocker locker( &m_lock );
+
+    if (entry.m_data.size() <= m_nMaxBytes && !m_entries.contains( sKey ))
+    {
+        m_entries.insert( sKey, entry );
+        m_lru.append( sKey );
+        m_nTotalBytes += entry.m_data.size();
+
+        Evict();
+    }
+
+    return entry.m_data;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Must be called with m_lock held.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpCompressCache::Evict()
+{
+    while (m_nTotalBytes > m_nMaxBytes && !m_lru.isEmpty())
+    {
+        QString sKey = m_lru.takeFirst();
+
+        EntryMap::iterator it = m_entries.find( sKey );
+
+        if (it != m_entries.end())
+        {
+            m_nTotalBytes -= it->m_data.size();
+            m_entries.erase( it );
+        }
+    }
+}
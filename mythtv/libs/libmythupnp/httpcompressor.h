@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpcompressor.h
+// Created     : Oct. 19, 2026
+//
+// Purpose     : gzip/deflate Content-Encoding support for HTTPRequest
+//
+// Copyright (c) 2026 MythTV Developers <mythtv-dev@mythtv.org>
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or at your option any later version of the LGPL.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __HTTPCOMPRESSOR_H__
+#define __HTTPCOMPRESSOR_H__
+
+#include <zlib.h>
+
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QMutex>
+#include <QMap>
+#include <QList>
+
+#include "upnpexp.h"
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpCompressor Class Definition
+//
+// Wraps a zlib deflate stream producing either a gzip ("gzip") or zlib
+// ("deflate") body.  Input can be fed in pieces so chunked responses can
+// be compressed as they are written.
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC HttpCompressor
+{
+    protected:
+
+        z_stream    m_stream;
+        bool        m_bValid;
+        QString     m_sEncoding;
+
+        qint64      m_nBytesIn;
+        qint64      m_nBytesOut;
+        qint64      m_nUSecs;       // time spent inside zlib
+
+    public:
+
+                 HttpCompressor( const QString &sEncoding, int nLevel );
+        virtual ~HttpCompressor();
+
+        // Appends the compressed form of pData to out.  bFinish must be
+        // set on the last call to flush the stream trailer.
+
+        bool     Compress ( const char *pData, qint64 nLen,
+                            QByteArray &out, bool bFinish );
+
+        bool     IsValid  () const { return m_bValid;    }
+        QString  Encoding () const { return m_sEncoding; }
+        qint64   BytesIn  () const { return m_nBytesIn;  }
+        qint64   BytesOut () const { return m_nBytesOut; }
+        int      TimeMS   () const { return (int)(m_nUSecs / 1000); }
+
+        // ------------------------------------------------------------------
+
+        static QString    GetEncoding  ( const QString &sAcceptEncoding );
+        static bool       IsCompressible( const QString &sContentType );
+        static int        GetLevel     ();
+        static qint64     GetThreshold ();
+
+        static QByteArray CompressBuffer( const QByteArray &data,
+                                          const QString    &sEncoding,
+                                          int              *pTimeMS = NULL );
+};
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpCompressCache Class Definition
+//
+// Compressed copies of static files (html/js/css/xml) so they are only
+// compressed once.  Entries are keyed by path and encoding, and dropped
+// when the file's mtime or size changes.  A "<file>.gz" next to the file,
+// at least as new as it, is used as is for gzip.
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC HttpCompressCache
+{
+    protected:
+
+        class Entry
+        {
+            public:
+
+                QDateTime   m_dtModified;
+                qint64      m_nSize;
+                QByteArray  m_data;
+
+                Entry() : m_nSize( 0 ) {}
+        };
+
+        typedef QMap< QString, Entry > EntryMap;
+
+        QMutex          m_lock;
+        EntryMap        m_entries;
+        QList<QString>  m_lru;          // most recently used last
+        qint64          m_nTotalBytes;
+        qint64          m_nMaxBytes;
+
+        static HttpCompressCache *g_pCache;
+        static QMutex             g_lock;
+
+        HttpCompressCache();
+
+        void      Evict ();
+
+    public:
+
+        static HttpCompressCache *Instance();
+
+        // Returns an empty array if the file could not be read or doesn't
+        // compress to less than its original size.
+
+        QByteArray Get  ( const QString &sFileName, const QString &sEncoding );
+};
+
+#endif
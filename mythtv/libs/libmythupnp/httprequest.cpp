@@ -54,6 +54,8 @@
 #include "serializers/soapSerializer.h"
 #include "serializers/jsonSerializer.h"
 
+#include "httpcompressor.h"
+
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
 #endif
@@ -137,7 +139,12 @@ HTTPRequest::HTTPRequest() : m_procReqLineExp ( "[ \r\n][ \r\n]*"  ),
                              m_bSOAPRequest   ( false ),
                              m_eResponseType  ( ResponseTypeUnknown),
                              m_nResponseStatus( 200 ),
-                             m_pPostProcess   ( NULL )
+                             m_pPostProcess   ( NULL ),
+                             m_pChunkedStream ( NULL ),
+                             m_bStreamed      ( false ),
+                             m_nEncodeBytesIn ( 0 ),
+                             m_nEncodeBytesOut( 0 ),
+                             m_nEncodeMS      ( 0 )
 {
     m_response.open( QIODevice::ReadWrite );
 }
@@ -186,11 +193,17 @@ QString HTTPRequest::BuildHeader( long long nSize )
     sHeader += GetAdditionalHeaders();
 
     sHeader += QString( "Connection: %1\r\n"
-                        "Content-Type: %2\r\n"
-                        "Content-Length: %3\r\n" )
+                        "Content-Type: %2\r\n" )
                         .arg( GetKeepAlive() ? "Keep-Alive" : "Close" )
-                        .arg( sContentType )
-                        .arg( nSize );
+                        .arg( sContentType );
+
+    // A negative size means the length isn't known yet and the body
+    // will follow as chunks (see HttpChunkedStream).
+
+    if (nSize < 0)
+        sHeader += "Transfer-Encoding: chunked\r\n";
+    else
+        sHeader += QString( "Content-Length: %1\r\n" ).arg( nSize );
 
     // ----------------------------------------------------------------------
     // Temp Hack to process DLNA header
@@ -216,6 +229,24 @@ long HTTPRequest::SendResponse( void )
 {
     long      nBytes    = 0;
 
+    // ----------------------------------------------------------------------
+    // Already sent while it was being serialized.
+    // ----------------------------------------------------------------------
+
+    if (m_bStreamed && m_pChunkedStream != NULL)
+    {
+        LOG(VB_UPNP, LOG_INFO,
+            QString("HTTPRequest::SendResponse( Chunked ) :%1 -> %2: %3 bytes")
+                .arg(GetResponseStatus()) .arg(GetPeerAddress())
+                .arg(m_pChunkedStream->BytesSent()));
+
+        // The connection can't be kept alive after a broken chunked body
+        if (m_pChunkedStream->Failed())
+            return( -1 );
+
+        return( m_pChunkedStream->BytesSent() );
+    }
+
     switch( m_eResponseType )
     {
         case ResponseTypeUnknown:
@@ -257,15 +288,51 @@ long HTTPRequest::SendResponse( void )
     // ----------------------------------------------------------------------
     const QByteArray &buffer = m_response.buffer();
 
-    QString    rHeader = BuildHeader( buffer.length() );
-    QByteArray sHeader = rHeader.toUtf8();
+    // ----------------------------------------------------------------------
+    // Compress the body if the client accepts it and it's worth it.
+    // ----------------------------------------------------------------------
+
+    QByteArray encoded;
+    QString    sContentType = (m_eResponseType == ResponseTypeOther) ?
+                               m_sResponseTypeText : GetResponseType();
+    QString    sEncoding    = GetResponseEncoding( buffer.length(),
+                                                   sContentType );
+
+    if (!sEncoding.isEmpty())
+    {
+        encoded = HttpCompressor::CompressBuffer( buffer, sEncoding,
+                                                  &m_nEncodeMS );
+
+        if (!encoded.isEmpty() && (encoded.length() < buffer.length()))
+        {
+            SetResponseEncoding( sEncoding );
+
+            m_nEncodeBytesIn  = buffer.length();
+            m_nEncodeBytesOut = encoded.length();
+
+            LOG(VB_UPNP, LOG_DEBUG,
+                QString("HTTPRequest::SendResponse - %1 %2 -> %3 bytes in %4ms")
+                    .arg(sEncoding) .arg(m_nEncodeBytesIn)
+                    .arg(m_nEncodeBytesOut) .arg(m_nEncodeMS));
+        }
+        else
+            encoded.clear();
+    }
+
+    qint64     nBodySize = encoded.isEmpty() ? buffer.length() : encoded.length();
+    QString    rHeader   = BuildHeader( nBodySize );
+    QByteArray sHeader   = rHeader.toUtf8();
     nBytes  = WriteBlockDirect( sHeader.constData(), sHeader.length() );
 
     // ----------------------------------------------------------------------
     // Write out Response buffer.
     // ----------------------------------------------------------------------
 
-    if (( m_eType != RequestTypeHead ) && ( buffer.length() > 0 ))
+    if (( m_eType != RequestTypeHead ) && !encoded.isEmpty())
+    {
+        nBytes += WriteBlockDirect( encoded.constData(), encoded.length() );
+    }
+    else if (( m_eType != RequestTypeHead ) && ( buffer.length() > 0 ))
     {
         nBytes += SendData( &m_response, 0, m_response.size() );
     }
@@ -291,6 +358,7 @@ long HTTPRequest::SendResponseFile( QString sFileName )
     long long   llSize  = 0;
     long long   llStart = 0;
     long long   llEnd   = 0;
+    QByteArray  encoded;
 
     LOG(VB_UPNP, LOG_INFO, QString("SendResponseFile ( %1 )").arg(sFileName));
 
@@ -374,6 +442,34 @@ long HTTPRequest::SendResponseFile( QString sFileName )
         if (bRange == false)
             m_mapRespHeaders[ "User-Agent"    ] = "redsonic";
 
+        // ------------------------------------------------------------------
+        // Send a compressed copy of whole text files (html, js, css...)
+        // if the client accepts one.  These are cached, see
+        // HttpCompressCache.
+        // ------------------------------------------------------------------
+
+        if ((bRange == false) && (m_nResponseStatus == 200))
+        {
+            QString sEncoding = GetResponseEncoding( llSize,
+                                                     m_sResponseTypeText );
+
+            if (!sEncoding.isEmpty())
+            {
+                encoded = HttpCompressCache::Instance()->Get( sFileName,
+                                                              sEncoding );
+
+                if (!encoded.isEmpty())
+                {
+                    SetResponseEncoding( sEncoding );
+
+                    m_nEncodeBytesIn  = llSize;
+                    m_nEncodeBytesOut = encoded.length();
+
+                    llSize = encoded.length();
+                }
+            }
+        }
+
         // ------------------------------------------------------------------
         //
         // ------------------------------------------------------------------
@@ -406,7 +502,12 @@ long HTTPRequest::SendResponseFile( QString sFileName )
         QString("SendResponseFile : size = %1, start = %2, end = %3")
             .arg(llSize).arg(llStart).arg(llEnd));
 #endif
-    if (( m_eType != RequestTypeHead ) && (llSize != 0))
+    if (( m_eType != RequestTypeHead ) && !encoded.isEmpty())
+    {
+        if (WriteBlockDirect( encoded.constData(), encoded.length() ) < 0)
+            nBytes = -1;
+    }
+    else if (( m_eType != RequestTypeHead ) && (llSize != 0))
     {
         long long sent = SendFile( tmpFile, llStart, llSize );
 
@@ -582,6 +683,20 @@ void HTTPRequest::FormatActionResponse( Serializer *pSer )
     pSer->AddHeaders( m_mapRespHeaders );
 
     //m_response << pFormatter->ToString();
+
+    // ----------------------------------------------------------------------
+    // If the serializer was writing to a chunked stream, either terminate
+    // the chunks already sent, or move the (small) result into m_response
+    // so it goes out with a Content-Length as usual.
+    // ----------------------------------------------------------------------
+
+    if (m_pChunkedStream != NULL)
+    {
+        if (m_pChunkedStream->Finish())
+            m_bStreamed = true;
+        else
+            m_response.write( m_pChunkedStream->Buffer() );
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -1397,26 +1512,62 @@ bool HTTPRequest::ProcessSOAPPayload( const QString &sSOAPAction )
 Serializer *HTTPRequest::GetSerializer()
 {
     Serializer *pSerializer = NULL;
+    QIODevice  *pDevice     = &m_response;
+
+    // ----------------------------------------------------------------------
+    // Large results (guide data, recording lists...) are sent as they are
+    // serialized rather than being built up in m_response first.
+    // ----------------------------------------------------------------------
+
+    if (CanStreamResponse())
+    {
+        int nThreshold = UPnp::GetConfiguration()->GetValue(
+                             "HTTP/ChunkedThresholdKB", 64 );
+
+        delete m_pChunkedStream;
+
+        m_pChunkedStream = new HttpChunkedStream( this, nThreshold * 1024 );
+
+        pDevice = m_pChunkedStream;
+    }
 
     if (m_bSOAPRequest) 
-        pSerializer = (Serializer *)new SoapSerializer(&m_response,
+        pSerializer = (Serializer *)new SoapSerializer(pDevice,
                                                        m_sNameSpace, m_sMethod);
     else
     {
         QString sAccept = GetHeaderValue( "Accept", "*/*" );
         
         if (sAccept.contains( "application/json", Qt::CaseInsensitive ))    
-            pSerializer = (Serializer *)new JSONSerializer(&m_response,
+            pSerializer = (Serializer *)new JSONSerializer(pDevice,
                                                            m_sMethod);
         else if (sAccept.contains( "text/javascript", Qt::CaseInsensitive ))    
-            pSerializer = (Serializer *)new JSONSerializer(&m_response,
+            pSerializer = (Serializer *)new JSONSerializer(pDevice,
                                                            m_sMethod);
     }
 
     // Default to XML
 
     if (pSerializer == NULL)
-        pSerializer = (Serializer *)new XmlSerializer(&m_response, m_sMethod);
+        pSerializer = (Serializer *)new XmlSerializer(pDevice, m_sMethod);
+
+    // ----------------------------------------------------------------------
+    // The header may be sent before FormatActionResponse is called, so it
+    // has to be filled in now.
+    // ----------------------------------------------------------------------
+
+    if (m_pChunkedStream != NULL)
+    {
+        m_eResponseType     = ResponseTypeOther;
+        m_sResponseTypeText = pSerializer->GetContentType();
+        m_nResponseStatus   = 200;
+
+        pSerializer->AddHeaders( m_mapRespHeaders );
+
+        m_pChunkedStream->SetEncoding(
+            GetResponseEncoding( -1, m_sResponseTypeText ));
+        m_pChunkedStream->open( QIODevice::WriteOnly );
+    }
 
     return pSerializer;
 }
@@ -1425,6 +1576,55 @@ Serializer *HTTPRequest::GetSerializer()
 //
 /////////////////////////////////////////////////////////////////////////////
 
+bool HTTPRequest::CanStreamResponse()
+{
+    // Chunked transfer coding is HTTP/1.1 only, and HEAD has no body.
+
+    if ((m_nMajor < 1) || ((m_nMajor == 1) && (m_nMinor < 1)))
+        return false;
+
+    if (m_eType == RequestTypeHead)
+        return false;
+
+    return UPnp::GetConfiguration()->GetValue( "HTTP/ChunkedThresholdKB", 64 ) > 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the Content-Encoding to use for a body of nSize bytes (-1 if not
+// known yet), or an empty string to send it as is.
+/////////////////////////////////////////////////////////////////////////////
+
+QString HTTPRequest::GetResponseEncoding( qint64 nSize,
+                                          const QString &sContentType )
+{
+    if (m_eType == RequestTypeHead)
+        return QString();
+
+    qint64 nThreshold = HttpCompressor::GetThreshold();
+
+    if ((nThreshold <= 0) || ((nSize >= 0) && (nSize < nThreshold)))
+        return QString();
+
+    if (!HttpCompressor::IsCompressible( sContentType ))
+        return QString();
+
+    return HttpCompressor::GetEncoding( GetHeaderValue( "accept-encoding", "" ));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HTTPRequest::SetResponseEncoding( const QString &sEncoding )
+{
+    m_mapRespHeaders[ "Content-Encoding" ] = sEncoding;
+    m_mapRespHeaders[ "Vary"             ] = "Accept-Encoding";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 QString HTTPRequest::Encode(const QString &sIn)
 {
     QString sStr = sIn;
@@ -1507,6 +1707,173 @@ bool HTTPRequest::Authenticated()
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpChunkedStream Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+HttpChunkedStream::HttpChunkedStream( HTTPRequest *pRequest, qint64 nThreshold )
+                 : m_pRequest   ( pRequest   ),
+                   m_pCompressor( NULL       ),
+                   m_nThreshold ( nThreshold ),
+                   m_nSent      ( 0          ),
+                   m_bStarted   ( false      ),
+                   m_bError     ( false      )
+{
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpChunkedStream::~HttpChunkedStream()
+{
+    delete m_pCompressor;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpChunkedStream::SetEncoding( const QString &sEncoding )
+{
+    delete m_pCompressor;
+    m_pCompressor = NULL;
+
+    if (!sEncoding.isEmpty())
+        m_pCompressor = new HttpCompressor( sEncoding,
+                                            HttpCompressor::GetLevel() );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Until streaming starts m_buffer holds uncompressed data, so it can still
+// be handed back by Finish().  Afterwards it holds compressed data when
+// compressing.
+/////////////////////////////////////////////////////////////////////////////
+
+qint64 HttpChunkedStream::writeData( const char *pData, qint64 nLen )
+{
+    if (m_bError)
+        return -1;
+
+    if (m_bStarted && (m_pCompressor != NULL))
+    {
+        if (!m_pCompressor->Compress( pData, nLen, m_buffer, false ))
+        {
+            m_bError = true;
+            return -1;
+        }
+    }
+    else
+        m_buffer.append( pData, nLen );
+
+    if (m_buffer.size() >= m_nThreshold)
+    {
+        if (!m_bStarted && (m_pCompressor != NULL))
+        {
+            QByteArray raw( m_buffer );
+
+            m_buffer.clear();
+
+            if (!m_pCompressor->Compress( raw.constData(), raw.size(),
+                                          m_buffer, false ))
+            {
+                m_bError = true;
+                return -1;
+            }
+        }
+
+        if (!SendChunk( m_buffer.constData(), m_buffer.size() ))
+            return -1;
+
+        m_buffer.clear();
+    }
+
+    return nLen;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// The header goes out in the same write as the first chunk.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpChunkedStream::SendChunk( const char *pData, qint64 nLen, bool bLast )
+{
+    QByteArray frame;
+
+    if (!m_bStarted)
+    {
+        if (m_pCompressor != NULL)
+            m_pRequest->SetResponseEncoding( m_pCompressor->Encoding() );
+
+        frame      = m_pRequest->BuildHeader( -1 ).toUtf8();
+        m_bStarted = true;
+    }
+
+    if (nLen > 0)
+    {
+        frame += QByteArray::number( nLen, 16 ) + "\r\n";
+        frame += QByteArray::fromRawData( pData, nLen );
+        frame += "\r\n";
+    }
+
+    if (bLast)
+        frame += "0\r\n\r\n";
+
+    if (frame.isEmpty())
+        return true;
+
+    qlonglong nWritten = m_pRequest->WriteBlockDirect( frame.constData(),
+                                                       frame.size() );
+
+    if (nWritten != frame.size())
+    {
+        LOG(VB_UPNP, LOG_ERR,
+            QString("HttpChunkedStream::SendChunk - write failed to %1")
+                .arg(m_pRequest->GetPeerAddress()));
+
+        m_bError = true;
+        return false;
+    }
+
+    m_nSent += nWritten;
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns false if nothing was sent yet, the caller should then send
+// Buffer() as a normal response.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpChunkedStream::Finish()
+{
+    if (!m_bStarted)
+        return false;
+
+    if (!m_bError)
+    {
+        if (m_pCompressor != NULL)
+        {
+            if (!m_pCompressor->Compress( NULL, 0, m_buffer, true ))
+                m_bError = true;
+
+            m_pRequest->m_nEncodeBytesIn  = m_pCompressor->BytesIn();
+            m_pRequest->m_nEncodeBytesOut = m_pCompressor->BytesOut();
+            m_pRequest->m_nEncodeMS       = m_pCompressor->TimeMS();
+        }
+
+        if (!m_bError)
+            SendChunk( m_buffer.constData(), m_buffer.size(), true );
+    }
+
+    m_buffer.clear();
+
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -96,12 +96,64 @@ class IPostProcess
         virtual ~IPostProcess() {};
 };
 
+/////////////////////////////////////////////////////////////////////////////
+// Write-only device handed to serializers in place of the response buffer.
+// Output is buffered until it passes the threshold, after which the header
+// is sent and the rest goes out as HTTP/1.1 chunks while the serializer is
+// still running, compressed on the fly when the client allows it.
+// Responses that never reach the threshold are sent the usual way, with a
+// Content-Length.
+/////////////////////////////////////////////////////////////////////////////
+
+class HTTPRequest;
+class HttpCompressor;
+
+class UPNP_PUBLIC HttpChunkedStream : public QIODevice
+{
+    protected:
+
+        HTTPRequest    *m_pRequest;
+        HttpCompressor *m_pCompressor;  // NULL when not compressing
+        QByteArray      m_buffer;
+        qint64          m_nThreshold;
+        qint64          m_nSent;
+        bool            m_bStarted;
+        bool            m_bError;
+
+        virtual qint64  readData ( char *, qint64 ) { return -1; }
+        virtual qint64  writeData( const char *pData, qint64 nLen );
+
+        bool            SendChunk( const char *pData, qint64 nLen,
+                                   bool bLast = false );
+
+    public:
+
+                 HttpChunkedStream( HTTPRequest *pRequest, qint64 nThreshold );
+        virtual ~HttpChunkedStream();
+
+        // Compress the chunks with the given Content-Encoding.  Must be
+        // called before anything is written.
+
+        void              SetEncoding( const QString &sEncoding );
+
+        virtual bool isSequential() const { return true; }
+
+        bool              Finish    ();
+        bool              IsStarted () const { return m_bStarted; }
+        // True if the body was cut short, the client can't find its end
+        bool              Failed    () const { return m_bError;   }
+        qint64            BytesSent () const { return m_nSent;    }
+        const QByteArray &Buffer    () const { return m_buffer;   }
+};
+
 /////////////////////////////////////////////////////////////////////////////
 // 
 /////////////////////////////////////////////////////////////////////////////
 
 class UPNP_PUBLIC HTTPRequest
 {
+    friend class HttpChunkedStream;
+
     protected:
 
         static const char  *m_szServerHeaders;
@@ -148,6 +200,19 @@ class UPNP_PUBLIC HTTPRequest
 
         IPostProcess       *m_pPostProcess;
 
+        // Set when the response was streamed by m_pChunkedStream and
+        // SendResponse has nothing left to do.
+
+        HttpChunkedStream  *m_pChunkedStream;
+        bool                m_bStreamed;
+
+        // Content-Encoding statistics for the response (body size before
+        // and after compression, and time spent compressing).
+
+        qint64              m_nEncodeBytesIn;
+        qint64              m_nEncodeBytesOut;
+        int                 m_nEncodeMS;
+
     protected:
 
         RequestType     SetRequestType      ( const QString &sType  );
@@ -171,6 +236,12 @@ class UPNP_PUBLIC HTTPRequest
 
         QString         BuildHeader         ( long long nSize );
 
+        bool            CanStreamResponse   ( );
+
+        QString         GetResponseEncoding ( qint64 nSize,
+                                              const QString &sContentType );
+        void            SetResponseEncoding ( const QString &sEncoding );
+
         qint64          SendData            ( QIODevice *pDevice, qint64 llStart, qint64 llBytes );
         qint64          SendFile            ( QFile &file, qint64 llStart, qint64 llBytes );
 
@@ -180,7 +251,7 @@ class UPNP_PUBLIC HTTPRequest
     public:
         
                         HTTPRequest     ();
-        virtual        ~HTTPRequest     () {};
+        virtual        ~HTTPRequest     () { delete m_pChunkedStream; };
 
         bool            ParseRequest    ();
 
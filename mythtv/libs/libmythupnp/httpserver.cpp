@@ -25,14 +25,37 @@
 // ANSI C headers
 #include <cmath>
 
+// C++ headers
+#include <algorithm>
+using namespace std;
+
 // POSIX headers
 #include <compat.h>
 #ifndef USING_MINGW
 #include <sys/utsname.h> 
+#include <sys/select.h>
+#endif
+#include <fcntl.h>
+#include <errno.h>
+
+#ifndef O_NONBLOCK
+#define O_NONBLOCK 0 /* not actually supported in MINGW */
+#endif
+
+// An fd_set holds descriptor values below FD_SETSIZE, except on Windows
+// where it is a list of up to FD_SETSIZE sockets of any value.
+static inline bool fits_fd_set( int nSocket )
+{
+#ifdef USING_MINGW
+    return nSocket >= 0;
+#else
+    return (nSocket >= 0) && (nSocket < (int)FD_SETSIZE);
 #endif
+}
 
 // Qt headers
 #include <QScriptEngine>
+#include <QFileInfo>
 
 // MythTV headers
 #include "httpserver.h"
@@ -41,6 +64,7 @@
 #include "compat.h"
 #include "mythdirs.h"
 #include "mythlogging.h"
+#include "mythbaseutil.h"
 #include "htmlserver.h"
 
 /////////////////////////////////////////////////////////////////////////////
@@ -57,11 +81,27 @@ QString  HttpServer::g_sPlatform;
 //
 /////////////////////////////////////////////////////////////////////////////
 
-HttpServer::HttpServer() : QTcpServer(), ThreadPool("HTTP")
+HttpServer::HttpServer() : QTcpServer(), ThreadPool("HTTP"),
+    m_pMonitor(NULL), m_pStreamPool(NULL), m_nStreamThreshold(0)
 {
     setMaxPendingConnections(20);
     InitializeThreads();
 
+    // ----------------------------------------------------------------------
+    // Idle keep-alive connections wait in the monitor, large file responses
+    // are sent from the stream pool.  Setting the threshold to 0 keeps
+    // streaming on the worker threads.
+    // ----------------------------------------------------------------------
+
+    m_nStreamThreshold = UPnp::GetConfiguration()->GetValue(
+                             "HTTP/StreamThresholdKB", 1024 ) * 1024LL;
+
+    m_pMonitor = new HttpConnectionMonitor( this );
+    m_pMonitor->start();
+
+    if (m_nStreamThreshold > 0)
+        m_pStreamPool = new HttpStreamPool( this );
+
     // ----------------------------------------------------------------------
     // Build Platform String
     // ----------------------------------------------------------------------
@@ -106,6 +146,32 @@ HttpServer::HttpServer() : QTcpServer(), ThreadPool("HTTP")
 
 HttpServer::~HttpServer()
 {
+    // ----------------------------------------------------------------------
+    // Worker threads are still running, take the monitor & stream pool away
+    // from them before either is deleted.  See ParkConnection() and
+    // StreamResponse().
+    // ----------------------------------------------------------------------
+
+    m_handoffLock.lockForWrite();
+
+    HttpConnectionMonitor *pMonitor    = m_pMonitor;
+    HttpStreamPool        *pStreamPool = m_pStreamPool;
+
+    m_pMonitor    = NULL;
+    m_pStreamPool = NULL;
+
+    m_handoffLock.unlock();
+
+    if (pMonitor != NULL)
+    {
+        pMonitor->RequestTerminate();
+        pMonitor->wait();
+        delete pMonitor;
+    }
+
+    if (pStreamPool != NULL)
+        delete pStreamPool;
+
     while (!m_extensions.empty())
     {
         delete m_extensions.takeFirst();
@@ -139,11 +205,219 @@ WorkerThread *HttpServer::CreateWorkerThread( ThreadPool * /*pThreadPool */,
 /////////////////////////////////////////////////////////////////////////////
 
 void HttpServer::incomingConnection(int nSocket)
+{
+    QTime ttQueued;
+    ttQueued.start();
+
+    BufferedSocketDevice *pSocket = new BufferedSocketDevice( nSocket );
+
+    m_statsLock.lock();
+    m_stats.m_nActiveConnections++;
+    m_statsLock.unlock();
+
+    DispatchConnection( pSocket, ttQueued );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Hand a connection with (or about to have) a request waiting to a worker.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::DispatchConnection( BufferedSocketDevice *pSocket,
+                                     const QTime          &ttQueued )
 {
     HttpWorkerThread *pThread = (HttpWorkerThread *)GetWorkerThread();
 
     if (pThread != NULL)
-        pThread->StartWork( nSocket );
+        pThread->StartWork( pSocket, ttQueued );
+    else
+        CloseConnection( pSocket );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// As DispatchConnection, but returns false rather than waiting when every
+// worker is busy.  Used by the monitor, which must not block.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpServer::TryDispatchConnection( BufferedSocketDevice *pSocket,
+                                        const QTime          &ttQueued )
+{
+    HttpWorkerThread *pThread = (HttpWorkerThread *)GetWorkerThread( false );
+
+    if (pThread == NULL)
+        return false;
+
+    pThread->StartWork( pSocket, ttQueued );
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Called by a worker when a keep-alive connection has no request pending.
+// Returns false, leaving the connection with the worker, if the monitor
+// can't watch it.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpServer::ParkConnection( BufferedSocketDevice *pSocket )
+{
+    QReadLocker locker( &m_handoffLock );
+
+    if (m_pMonitor == NULL)
+        return false;
+
+    return m_pMonitor->AddConnection( pSocket );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::CloseConnection( BufferedSocketDevice *pSocket )
+{
+    if (pSocket == NULL)
+        return;
+
+    pSocket->Close();
+    delete pSocket;
+
+    m_statsLock.lock();
+    m_stats.m_nActiveConnections--;
+    m_statsLock.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpServer::IsStreamResponse( HTTPRequest *pRequest )
+{
+    if ((m_pStreamPool == NULL) ||
+        (pRequest->m_eResponseType != ResponseTypeFile) ||
+        (pRequest->m_eType == RequestTypeHead))
+    {
+        return false;
+    }
+
+    QFileInfo info( pRequest->m_sFileName );
+
+    return info.exists() && (info.size() >= m_nStreamThreshold);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Takes ownership of pSocket & pRequest when it returns true.  Returns
+// false rather than waiting when every stream thread is busy, the worker
+// then sends the response itself.
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpServer::StreamResponse( BufferedSocketDevice *pSocket,
+                                 HTTPRequest          *pRequest,
+                                 bool                  bKeepAlive )
+{
+    QReadLocker locker( &m_handoffLock );
+
+    if (m_pStreamPool == NULL)
+        return false;
+
+    HttpStreamThread *pThread =
+        (HttpStreamThread *)m_pStreamPool->GetWorkerThread( false );
+
+    if (pThread == NULL)
+        return false;
+
+    m_statsLock.lock();
+    m_stats.m_nStreamConnections++;
+    m_statsLock.unlock();
+
+    pThread->StartWork( pSocket, pRequest, bKeepAlive );
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::StreamFinished( )
+{
+    m_statsLock.lock();
+    m_stats.m_nStreamConnections--;
+    m_statsLock.unlock();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::RecordQueueWait( int nMS )
+{
+    if (nMS < 0)
+        nMS = 0;
+
+    QMutexLocker locker( &m_statsLock );
+
+    m_stats.m_nDispatched++;
+    m_stats.m_nQueueWaitTotalMS += nMS;
+    m_stats.m_nQueueWaitMaxMS    = max( m_stats.m_nQueueWaitMaxMS, (uint)nMS );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+const char *HttpServer::kOtherEndpoint = "(other)";
+
+void HttpServer::RecordRequest( const QString &sBaseUrl, int nMS )
+{
+    if (nMS < 0)
+        nMS = 0;
+
+    // The base url comes from the client, only those of registered
+    // extensions get their own entry so the map can't grow without bound.
+
+    m_rwlock.lockForRead();
+    bool bKnown = m_basePaths.contains( sBaseUrl );
+    m_rwlock.unlock();
+
+    QMutexLocker locker( &m_statsLock );
+
+    HttpEndpointStats &stats =
+        m_stats.m_endpoints[ bKnown ? sBaseUrl : QString( kOtherEndpoint ) ];
+
+    stats.m_nRequests++;
+    stats.m_nTotalMS += nMS;
+    stats.m_nMaxMS    = max( stats.m_nMaxMS, (uint)nMS );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::RecordEncoding( const HTTPRequest *pRequest )
+{
+    if (pRequest->m_nEncodeBytesOut <= 0)
+        return;
+
+    QMutexLocker locker( &m_statsLock );
+
+    m_stats.m_nEncoded++;
+    m_stats.m_nEncodeBytesIn  += pRequest->m_nEncodeBytesIn;
+    m_stats.m_nEncodeBytesOut += pRequest->m_nEncodeBytesOut;
+    m_stats.m_nEncodeTotalMS  += pRequest->m_nEncodeMS;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpServerStats HttpServer::GetStatistics()
+{
+    m_statsLock.lock();
+    HttpServerStats stats = m_stats;
+    m_statsLock.unlock();
+
+    if (m_pMonitor != NULL)
+        stats.m_nIdleConnections = m_pMonitor->Count();
+
+    return stats;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -262,7 +536,7 @@ HttpWorkerThread::HttpWorkerThread( HttpServer *pParent, const QString &sName )
                   WorkerThread( (ThreadPool *)pParent, sName )
 {
     m_pHttpServer    = pParent;
-    m_nSocket        = 0;                                                  
+    m_pSocket        = NULL;
     m_nSocketTimeout = 1000 *
         UPnp::GetConfiguration()->GetValue("HTTP/KeepAliveTimeoutSecs", 10);
 
@@ -298,9 +572,11 @@ void HttpWorkerThread::SetWorkerData( HttpWorkerData *pData )
 //
 /////////////////////////////////////////////////////////////////////////////
 
-void HttpWorkerThread::StartWork( int nSocket )
+void HttpWorkerThread::StartWork( BufferedSocketDevice *pSocket,
+                                  const QTime          &ttQueued )
 {
-    m_nSocket = nSocket;
+    m_pSocket  = pSocket;
+    m_ttQueued = ttQueued;
 
     SignalWork();
 }
@@ -314,26 +590,44 @@ void  HttpWorkerThread::ProcessWork()
 #if 0
     LOG(VB_UPNP, LOG_DEBUG,
         QString("HttpWorkerThread::ProcessWork:Begin( %1 ) socket=%2")
-            .arg((long)QThread::currentThread()) .arg(m_nSocket));
+            .arg((long)QThread::currentThread()) .arg(m_pSocket->socket()));
 #endif
 
     bool                    bTimeout   = false;
     bool                    bKeepAlive = true;
-    BufferedSocketDevice   *pSocket    = NULL;
+    int                     nRequests  = 0;
+    BufferedSocketDevice   *pSocket    = m_pSocket;
     HTTPRequest            *pRequest   = NULL;
 
-    try
+    m_pSocket = NULL;
+
+    if (pSocket == NULL)
     {
-        if ((pSocket = new BufferedSocketDevice( m_nSocket )) == NULL)
-        {
-            LOG(VB_GENERAL, LOG_ERR, "Error Creating BufferedSocketDevice");
-            return;
-        }
+        LOG(VB_GENERAL, LOG_ERR, "HttpWorkerThread::ProcessWork - No Socket");
+        return;
+    }
+
+    m_pHttpServer->RecordQueueWait( m_ttQueued.elapsed() );
 
+    try
+    {
         pSocket->SocketDevice()->setBlocking( true );
 
         while( !m_bTermRequested && bKeepAlive && pSocket->IsValid())
         {
+            // --------------------------------------------------------------
+            // Once we've answered a request, don't sit on an idle keep-alive
+            // connection.  Unless the client has already pipelined another
+            // request, give it to the monitor and free this thread.
+            // --------------------------------------------------------------
+
+            if ((nRequests > 0) && (pSocket->BytesAvailable() == 0) &&
+                m_pHttpServer->ParkConnection( pSocket ))
+            {
+                pSocket = NULL;
+                break;
+            }
+
             bTimeout = 0;
 
             int64_t nBytes = pSocket->WaitForMore(m_nSocketTimeout, &bTimeout);
@@ -344,6 +638,9 @@ void  HttpWorkerThread::ProcessWork()
                 // See if this is a valid request
                 // ----------------------------------------------------------
 
+                QTime ttRequest;
+                ttRequest.start();
+
                 pRequest = new BufferedSocketDeviceRequest( pSocket );
                 if (pRequest != NULL)
                 {
@@ -381,6 +678,27 @@ void  HttpWorkerThread::ProcessWork()
                     }
 #endif
 
+                    // -------------------------------------------------------
+                    // Large files are sent from the stream pool, which
+                    // takes over the connection.  Latency is recorded up to
+                    // the hand off.
+                    // -------------------------------------------------------
+
+                    if (m_pHttpServer->IsStreamResponse( pRequest ))
+                    {
+                        int nMS = ttRequest.elapsed();
+                        QString sBaseUrl = pRequest->m_sBaseUrl;
+
+                        if (m_pHttpServer->StreamResponse( pSocket, pRequest,
+                                                           bKeepAlive ))
+                        {
+                            m_pHttpServer->RecordRequest( sBaseUrl, nMS );
+                            pSocket  = NULL;
+                            pRequest = NULL;
+                            break;
+                        }
+                    }
+
                     // -------------------------------------------------------
                     // Always MUST send a response.
                     // -------------------------------------------------------
@@ -391,9 +709,13 @@ void  HttpWorkerThread::ProcessWork()
                         LOG(VB_UPNP, LOG_ERR,
                             QString("socket(%1) - Error returned from "
                                     "SendResponse... Closing connection")
-                                .arg(m_nSocket));
+                                .arg(pSocket->socket()));
                     }
 
+                    m_pHttpServer->RecordRequest( pRequest->m_sBaseUrl,
+                                                  ttRequest.elapsed() );
+                    m_pHttpServer->RecordEncoding( pRequest );
+
                     // -------------------------------------------------------
                     // Check to see if a PostProcess was registered
                     // -------------------------------------------------------
@@ -403,6 +725,8 @@ void  HttpWorkerThread::ProcessWork()
 
                     delete pRequest;
                     pRequest = NULL;
+
+                    nRequests++;
                 }
                 else
                 {
@@ -426,10 +750,8 @@ void  HttpWorkerThread::ProcessWork()
     if (pRequest != NULL)
         delete pRequest;
 
-    pSocket->Close();
-
-    delete pSocket;
-    m_nSocket = 0;
+    if (pSocket != NULL)
+        m_pHttpServer->CloseConnection( pSocket );
 
 #if 0
     LOG(VB_UPNP, LOG_DEBUG,
@@ -438,4 +760,417 @@ void  HttpWorkerThread::ProcessWork()
 #endif
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpConnectionMonitor Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
 
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpConnectionMonitor::HttpConnectionMonitor( HttpServer *pParent )
+  : m_pHttpServer( pParent ), m_bTermRequested( false ), m_nIdleCount( 0 )
+{
+    m_nKeepAliveTimeout = 1000 *
+        UPnp::GetConfiguration()->GetValue("HTTP/KeepAliveTimeoutSecs", 10);
+
+    // Stay well below FD_SETSIZE.
+
+    m_nMaxIdle = min( UPnp::GetConfiguration()->GetValue(
+                          "HTTP/MaxIdleConnections", 256 ),
+                      (int)FD_SETSIZE - 64 );
+
+    m_wakePipe     [0] = m_wakePipe     [1] = -1;
+    m_wakePipeFlags[0] = m_wakePipeFlags[1] = 0;
+
+    setup_pipe( m_wakePipe, m_wakePipeFlags );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpConnectionMonitor::~HttpConnectionMonitor()
+{
+    for (uint i = 0; i < 2; i++)
+    {
+        if (m_wakePipe[i] >= 0)
+        {
+            ::close( m_wakePipe[i] );
+            m_wakePipe[i] = -1;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool HttpConnectionMonitor::AddConnection( BufferedSocketDevice *pSocket )
+{
+    if (!fits_fd_set( pSocket->socket() ))
+        return false;
+
+    m_lock.lock();
+
+    if (m_bTermRequested || (m_nIdleCount >= m_nMaxIdle))
+    {
+        m_lock.unlock();
+
+        LOG(VB_UPNP, LOG_INFO,
+            "HttpConnectionMonitor - Too many idle connections, closing.");
+
+        m_pHttpServer->CloseConnection( pSocket );
+        return true;
+    }
+
+    m_addList.push_back( IdleConnection( pSocket ));
+    m_nIdleCount++;
+
+    m_lock.unlock();
+
+    Wake();
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpConnectionMonitor::RequestTerminate( )
+{
+    m_lock.lock();
+    m_bTermRequested = true;
+    m_lock.unlock();
+
+    Wake();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+int HttpConnectionMonitor::Count( ) const
+{
+    QMutexLocker locker( &m_lock );
+
+    return m_nIdleCount;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpConnectionMonitor::Wake( )
+{
+    if (m_wakePipe[1] < 0)
+        return;
+
+    char buf[1] = { '0' };
+
+    if ((::write( m_wakePipe[1], &buf, 1 ) < 0) && (errno != EAGAIN))
+        LOG(VB_UPNP, LOG_ERR, "HttpConnectionMonitor - Wake failed" + ENO);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Only called from the monitor thread.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpConnectionMonitor::ProcessAddQueue( )
+{
+    QMutexLocker locker( &m_lock );
+
+    while (!m_addList.empty())
+        m_idleList.push_back( m_addList.takeFirst() );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Only called from the monitor thread.  Hands readable connections to
+// workers while there are free ones, the rest wait for the next pass.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpConnectionMonitor::DispatchReady( )
+{
+    while (!m_readyList.empty())
+    {
+        const IdleConnection &conn = m_readyList.front();
+
+        if (!m_pHttpServer->TryDispatchConnection( conn.m_pSocket,
+                                                   conn.m_ttParked ))
+            break;
+
+        m_readyList.pop_front();
+
+        m_lock.lock();
+        m_nIdleCount--;
+        m_lock.unlock();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpConnectionMonitor::run( )
+{
+    fd_set          read_set;
+    struct timeval  timeout;
+
+    threadRegister("HttpMonitor");
+    LOG(VB_UPNP, LOG_INFO, "HttpConnectionMonitor::Run - Thread Started." );
+
+    while (true)
+    {
+        m_lock.lock();
+        bool bTerm = m_bTermRequested;
+        m_lock.unlock();
+
+        if (bTerm)
+            break;
+
+        ProcessAddQueue();
+
+        int nMaxSocket = -1;
+
+        FD_ZERO( &read_set );
+
+        QList< IdleConnection >::iterator it = m_idleList.begin();
+        for (; it != m_idleList.end(); ++it)
+        {
+            int nSocket = (*it).m_pSocket->socket();
+
+            if (fits_fd_set( nSocket ))
+            {
+                FD_SET( nSocket, &read_set );
+                nMaxSocket = max( nSocket, nMaxSocket );
+            }
+        }
+
+        bool bWakePipe = fits_fd_set( m_wakePipe[0] );
+
+        if (bWakePipe)
+        {
+            FD_SET( m_wakePipe[0], &read_set );
+            nMaxSocket = max( m_wakePipe[0], nMaxSocket );
+        }
+
+        // Without a wake pipe, poll often enough that newly parked
+        // connections are picked up quickly.  The same goes for those
+        // waiting for a worker to become free.
+
+        bool bPoll = !bWakePipe || !m_readyList.empty();
+
+        timeout.tv_sec  = bPoll ? 0     : 1;
+        timeout.tv_usec = bPoll ? 10000 : 0;
+
+        int nCount = 0;
+
+        if (nMaxSocket >= 0)
+            nCount = select( nMaxSocket + 1, &read_set, NULL, NULL, &timeout );
+        else
+            usleep( timeout.tv_usec );
+
+        if (nCount < 0)
+        {
+            if (errno != EINTR)
+            {
+                LOG(VB_UPNP, LOG_ERR,
+                    "HttpConnectionMonitor - select failed" + ENO);
+                usleep( 10000 );
+            }
+            continue;
+        }
+
+        if ((nCount > 0) && bWakePipe && FD_ISSET( m_wakePipe[0], &read_set ))
+        {
+            char dummy[128];
+            while (::read( m_wakePipe[0], dummy, sizeof( dummy )) > 0)
+                ;
+        }
+
+        // ------------------------------------------------------------------
+        // Dispatch readable connections, expire those idle for too long.
+        // ------------------------------------------------------------------
+
+        it = m_idleList.begin();
+        while (it != m_idleList.end())
+        {
+            BufferedSocketDevice *pSocket = (*it).m_pSocket;
+            int                   nSocket = pSocket->socket();
+
+            bool bReady   = (nCount > 0) && fits_fd_set( nSocket ) &&
+                            FD_ISSET( nSocket, &read_set );
+            bool bExpired = !bReady &&
+                            ((nSocket < 0) ||
+                             ((*it).m_ttParked.elapsed() > m_nKeepAliveTimeout));
+
+            if (!bReady && !bExpired)
+            {
+                ++it;
+                continue;
+            }
+
+            it = m_idleList.erase( it );
+
+            if (bReady)
+            {
+                // Queued from now, until a worker picks it up.
+
+                m_readyList.push_back( IdleConnection( pSocket ));
+                continue;
+            }
+
+            m_lock.lock();
+            m_nIdleCount--;
+            m_lock.unlock();
+
+            m_pHttpServer->CloseConnection( pSocket );
+        }
+
+        DispatchReady();
+    }
+
+    // ----------------------------------------------------------------------
+    // Shutting down, close anything left.
+    // ----------------------------------------------------------------------
+
+    ProcessAddQueue();
+
+    while (!m_idleList.empty())
+        m_pHttpServer->CloseConnection( m_idleList.takeFirst().m_pSocket );
+
+    while (!m_readyList.empty())
+        m_pHttpServer->CloseConnection( m_readyList.takeFirst().m_pSocket );
+
+    m_lock.lock();
+    m_nIdleCount = 0;
+    m_lock.unlock();
+
+    LOG(VB_UPNP, LOG_INFO, "HttpConnectionMonitor::Run - Thread Exiting." );
+    threadDeregister();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpStreamPool Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpStreamPool::HttpStreamPool( HttpServer *pParent )
+  : ThreadPool( "HTTPStream" ), m_pHttpServer( pParent )
+{
+    InitializeThreads();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+WorkerThread *HttpStreamPool::CreateWorkerThread( ThreadPool *pThreadPool,
+                                                  const QString &sName )
+{
+    return( new HttpStreamThread( pThreadPool, m_pHttpServer, sName ));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpStreamThread Class Implementation
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpStreamThread::HttpStreamThread( ThreadPool    *pPool,
+                                    HttpServer    *pParent,
+                                    const QString &sName )
+  : WorkerThread( pPool, sName ),
+    m_pHttpServer( pParent ), m_pSocket( NULL ), m_pRequest( NULL ),
+    m_bKeepAlive( false )
+{
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStreamThread::StartWork( BufferedSocketDevice *pSocket,
+                                  HTTPRequest          *pRequest,
+                                  bool                  bKeepAlive )
+{
+    m_pSocket    = pSocket;
+    m_pRequest   = pRequest;
+    m_bKeepAlive = bKeepAlive;
+
+    SignalWork();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStreamThread::ProcessWork()
+{
+    BufferedSocketDevice *pSocket    = m_pSocket;
+    HTTPRequest          *pRequest   = m_pRequest;
+    bool                  bKeepAlive = m_bKeepAlive;
+
+    m_pSocket  = NULL;
+    m_pRequest = NULL;
+
+    if ((pSocket == NULL) || (pRequest == NULL))
+        return;
+
+    try
+    {
+        if (pRequest->SendResponse() < 0)
+        {
+            bKeepAlive = false;
+            LOG(VB_UPNP, LOG_ERR,
+                QString("socket(%1) - Error returned from "
+                        "SendResponse... Closing connection")
+                    .arg(pSocket->socket()));
+        }
+
+        m_pHttpServer->RecordEncoding( pRequest );
+
+        if ( pRequest->m_pPostProcess != NULL )
+            pRequest->m_pPostProcess->ExecutePostProcess();
+    }
+    catch(...)
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            "HttpStreamThread::ProcessWork - Unexpected Exception.");
+        bKeepAlive = false;
+    }
+
+    delete pRequest;
+
+    m_pHttpServer->StreamFinished();
+
+    if (!bKeepAlive || m_bTermRequested || !pSocket->IsValid())
+        m_pHttpServer->CloseConnection( pSocket );
+    else if (!m_pHttpServer->ParkConnection( pSocket ))
+    {
+        // The monitor can't watch it, a worker waits for the next request.
+
+        QTime ttQueued;
+        ttQueued.start();
+
+        m_pHttpServer->DispatchConnection( pSocket, ttQueued );
+    }
+}
@@ -36,6 +36,9 @@
 #include <QReadWriteLock>
 #include <QTcpServer>
 #include <QMultiMap>
+#include <QMutex>
+#include <QList>
+#include <QTime>
 
 // MythTV headers
 #include "upnputil.h"
@@ -47,6 +50,8 @@
 typedef struct timeval  TaskTime;
 
 class HttpWorkerThread;
+class HttpConnectionMonitor;
+class HttpStreamPool;
 class QScriptEngine;
 class HttpServer;
 
@@ -82,6 +87,67 @@ class UPNP_PUBLIC HttpServerExtension : public QObject
 
 typedef QList<QPointer<HttpServerExtension> > HttpServerExtensionList;
 
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpServer statistics
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC HttpEndpointStats
+{
+    public:
+
+        quint64     m_nRequests;
+        quint64     m_nTotalMS;
+        uint        m_nMaxMS;
+
+    public:
+
+        HttpEndpointStats() : m_nRequests( 0 ), m_nTotalMS( 0 ), m_nMaxMS( 0 )
+        {
+        }
+};
+
+/// Key == Base Url of a registered extension, or kOtherEndpoint
+typedef QMap< QString, HttpEndpointStats > HttpEndpointStatsMap;
+
+class UPNP_PUBLIC HttpServerStats
+{
+    public:
+
+        int                     m_nActiveConnections;  ///< busy, idle & streaming
+        int                     m_nIdleConnections;    ///< parked keep-alives
+        int                     m_nStreamConnections;  ///< sending large files
+
+        quint64                 m_nDispatched;         ///< handed to a worker
+        quint64                 m_nQueueWaitTotalMS;
+        uint                    m_nQueueWaitMaxMS;
+
+        quint64                 m_nEncoded;            ///< compressed responses
+        quint64                 m_nEncodeBytesIn;      ///< before compression
+        quint64                 m_nEncodeBytesOut;     ///< on the wire
+        quint64                 m_nEncodeTotalMS;
+
+        HttpEndpointStatsMap    m_endpoints;
+
+    public:
+
+        HttpServerStats() : m_nActiveConnections( 0 ),
+                            m_nIdleConnections  ( 0 ),
+                            m_nStreamConnections( 0 ),
+                            m_nDispatched       ( 0 ),
+                            m_nQueueWaitTotalMS ( 0 ),
+                            m_nQueueWaitMaxMS   ( 0 ),
+                            m_nEncoded          ( 0 ),
+                            m_nEncodeBytesIn    ( 0 ),
+                            m_nEncodeBytesOut   ( 0 ),
+                            m_nEncodeTotalMS    ( 0 )
+        {
+        }
+};
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -104,6 +170,14 @@ class UPNP_PUBLIC HttpServer : public QTcpServer,
 
         HttpServerExtension*    m_pHtmlServer;
 
+        HttpConnectionMonitor  *m_pMonitor;
+        HttpStreamPool         *m_pStreamPool;
+        QReadWriteLock          m_handoffLock;  ///< guards the two above
+        qint64                  m_nStreamThreshold;
+
+        QMutex                  m_statsLock;
+        HttpServerStats         m_stats;
+
         virtual WorkerThread *CreateWorkerThread( ThreadPool *,
                                                   const QString &sName );
         virtual void          incomingConnection     ( int socket );
@@ -126,6 +200,36 @@ class UPNP_PUBLIC HttpServer : public QTcpServer,
 
         QScriptEngine* ScriptEngine();
 
+        // ------------------------------------------------------------------
+        // Connection hand-off between the monitor, workers & stream pool
+        // ------------------------------------------------------------------
+
+        void     DispatchConnection ( BufferedSocketDevice *pSocket,
+                                      const QTime          &ttQueued );
+        bool     TryDispatchConnection( BufferedSocketDevice *pSocket,
+                                        const QTime          &ttQueued );
+        bool     ParkConnection     ( BufferedSocketDevice *pSocket );
+        void     CloseConnection    ( BufferedSocketDevice *pSocket );
+
+        bool     IsStreamResponse   ( HTTPRequest          *pRequest );
+        bool     StreamResponse     ( BufferedSocketDevice *pSocket,
+                                      HTTPRequest          *pRequest,
+                                      bool                  bKeepAlive );
+        void     StreamFinished     ( );
+
+        // ------------------------------------------------------------------
+        // Statistics
+        // ------------------------------------------------------------------
+
+        void     RecordQueueWait    ( int nMS );
+        void     RecordRequest      ( const QString &sBaseUrl, int nMS );
+
+        /// Statistics key for requests not handled by a registered extension
+        static const char *kOtherEndpoint;
+        void     RecordEncoding     ( const HTTPRequest *pRequest );
+
+        HttpServerStats GetStatistics();
+
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -156,9 +260,10 @@ class UPNP_PUBLIC HttpWorkerThread : public WorkerThread
 {
     protected:
 
-        HttpServer      *m_pHttpServer; 
-        int              m_nSocket;
-        int              m_nSocketTimeout;
+        HttpServer           *m_pHttpServer; 
+        BufferedSocketDevice *m_pSocket;
+        QTime                 m_ttQueued;
+        int                   m_nSocketTimeout;
 
         HttpWorkerData  *m_pData;
 
@@ -171,11 +276,129 @@ class UPNP_PUBLIC HttpWorkerThread : public WorkerThread
                  HttpWorkerThread( HttpServer *pParent, const QString &sName );
         virtual ~HttpWorkerThread();
 
-        void            StartWork( int nSocket );
+        void            StartWork( BufferedSocketDevice *pSocket,
+                                   const QTime          &ttQueued );
 
         void            SetWorkerData( HttpWorkerData *pData );
         HttpWorkerData *GetWorkerData( ) { return( m_pData ); }
 };
 
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpConnectionMonitor Class Definition
+//
+// Keep-alive connections with no request pending are parked here instead of
+// holding on to a worker thread.  A single thread select()s on all of them
+// and hands a connection back to the HttpServer as soon as it is readable.
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class HttpConnectionMonitor : public QThread
+{
+    protected:
+
+        class IdleConnection
+        {
+            public:
+
+                BufferedSocketDevice *m_pSocket;
+                QTime                 m_ttParked;
+
+                IdleConnection( BufferedSocketDevice *pSocket = NULL )
+                    : m_pSocket( pSocket )
+                {
+                    m_ttParked.start();
+                }
+        };
+
+        HttpServer             *m_pHttpServer;
+
+        mutable QMutex          m_lock;
+        bool                    m_bTermRequested;
+        QList< IdleConnection > m_addList;
+        QList< IdleConnection > m_idleList;
+        QList< IdleConnection > m_readyList;  ///< readable, waiting for a worker
+        int                     m_nIdleCount;
+
+        int                     m_nKeepAliveTimeout;
+        int                     m_nMaxIdle;
+
+        int                     m_wakePipe[2];
+        long                    m_wakePipeFlags[2];
+
+    protected:
+
+        virtual void run                ( );
+
+        void         Wake               ( );
+        void         ProcessAddQueue    ( );
+        void         DispatchReady      ( );
+
+    public:
+
+                 HttpConnectionMonitor( HttpServer *pParent );
+        virtual ~HttpConnectionMonitor( );
+
+        bool     AddConnection        ( BufferedSocketDevice *pSocket );
+        void     RequestTerminate     ( );
+
+        int      Count                ( ) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+//
+// HttpStreamPool Class Definition
+//
+// Large file responses (recordings, videos, music) are sent from their own
+// thread pool so long running transfers to slow clients can't starve the
+// worker threads answering services and UPnP requests.
+//
+/////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+class HttpStreamPool : public ThreadPool
+{
+    protected:
+
+        HttpServer  *m_pHttpServer;
+
+        virtual WorkerThread *CreateWorkerThread( ThreadPool *,
+                                                  const QString &sName );
+
+    public:
+
+                 HttpStreamPool( HttpServer *pParent );
+        virtual ~HttpStreamPool( ) {}
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+class HttpStreamThread : public WorkerThread
+{
+    protected:
+
+        HttpServer           *m_pHttpServer;
+        BufferedSocketDevice *m_pSocket;
+        HTTPRequest          *m_pRequest;
+        bool                  m_bKeepAlive;
+
+    protected:
+
+        virtual void  ProcessWork();
+
+    public:
+
+                 HttpStreamThread( ThreadPool    *pPool,
+                                   HttpServer    *pParent,
+                                   const QString &sName );
+        virtual ~HttpStreamThread() {}
+
+        void     StartWork( BufferedSocketDevice *pSocket,
+                            HTTPRequest          *pRequest,
+                            bool                  bKeepAlive );
+};
 
 #endif
@@ -25,6 +25,51 @@
 
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QMutex>
+#include <QHash>
+
+static QMutex                                              g_propertyLock;
+static QHash< const QMetaObject*, SerializerPropertyList > g_propertyCache;
+
+//////////////////////////////////////////////////////////////////////////////
+// QMetaObjects are static and live for the life of the process, so the
+// cached lists never need to be invalidated.
+//////////////////////////////////////////////////////////////////////////////
+
+const SerializerPropertyList &Serializer::GetProperties( const QMetaObject *pMetaObject )
+{
+    QMutexLocker locker( &g_propertyLock );
+
+    QHash< const QMetaObject*, SerializerPropertyList >::const_iterator it =
+        g_propertyCache.constFind( pMetaObject );
+
+    if (it != g_propertyCache.constEnd())
+        return *it;
+
+    SerializerPropertyList list;
+
+    int nCount = pMetaObject->propertyCount();
+
+    for (int nIdx=0; nIdx < nCount; ++nIdx )
+    {
+        QMetaProperty metaProperty = pMetaObject->property( nIdx );
+
+        // Only properties that can never be designable are dropped here,
+        // the rest are still checked against each instance.
+
+        if (!metaProperty.isDesignable())
+            continue;
+
+        if (qstrcmp( metaProperty.name(), "objectName" ) == 0)
+            continue;
+
+        list.append( SerializerProperty( metaProperty ));
+    }
+
+    // QHash references stay valid as long as no item is removed.
+
+    return *g_propertyCache.insert( pMetaObject, list );
+}
 
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -98,25 +143,20 @@ void Serializer::SerializeObjectProperties( const QObject *pObject )
 {
     if (pObject != NULL)
     {
-        const QMetaObject *pMetaObject = pObject->metaObject();
+        const QMetaObject            *pMetaObject = pObject->metaObject();
+        const SerializerPropertyList &props       = GetProperties( pMetaObject );
 
-        int nCount = pMetaObject->propertyCount();
+        SerializerPropertyList::const_iterator it;
 
-        for (int nIdx=0; nIdx < nCount; ++nIdx ) 
+        for (it = props.begin(); it != props.end(); ++it)
         {
-            QMetaProperty metaProperty = pMetaObject->property( nIdx );
+            const QMetaProperty &metaProperty = it->m_metaProperty;
 
             if (metaProperty.isDesignable( pObject ))
             {
-                const char *pszPropName = metaProperty.name();
-                QString     sPropName( pszPropName );
-
-                if ( sPropName.compare( "objectName" ) == 0)
-                    continue;
-
-                QVariant value( pObject->property( pszPropName ) );
+                QVariant value( metaProperty.read( pObject ));
 
-                AddProperty( sPropName, value, pMetaObject, &metaProperty );
+                AddProperty( it->m_sName, value, pMetaObject, &metaProperty );
             }
         }
     }
@@ -29,6 +29,30 @@
 
 #include <QList>
 #include <QMetaType>
+#include <QMetaProperty>
+#include <QString>
+
+//////////////////////////////////////////////////////////////////////////////
+// Properties of a class that are worth serializing.  Looking these up by
+// walking the QMetaObject for every instance is a large part of the cost of
+// serializing long lists (e.g. program guides), so the list is built once
+// per class and shared.
+//////////////////////////////////////////////////////////////////////////////
+
+class SerializerProperty
+{
+    public:
+
+        QMetaProperty m_metaProperty;
+        QString       m_sName;
+
+        SerializerProperty() {}
+        SerializerProperty( const QMetaProperty &metaProperty )
+            : m_metaProperty( metaProperty ),
+              m_sName       ( metaProperty.name() ) {}
+};
+
+typedef QList< SerializerProperty > SerializerPropertyList;
 
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -58,6 +82,8 @@ class UPNP_PUBLIC Serializer
         void SerializeObject          ( const QObject *pObject, const QString &sName );
         void SerializeObjectProperties( const QObject *pObject );
 
+        static const SerializerPropertyList &GetProperties( const QMetaObject *pMetaObject );
+
     public:
 
         virtual void Serialize( const QObject *pObject, const QString &_sName = QString() );
@@ -75,6 +101,8 @@ class UPNP_PUBLIC Serializer
         {
             qRegisterMetaType< QList<QObject*> >("QList<QObject*>");
         }
+
+        virtual ~Serializer() {}
 };
 
 Q_DECLARE_METATYPE( QList<QObject*> )
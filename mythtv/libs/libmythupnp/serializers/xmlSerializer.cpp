@@ -274,12 +274,26 @@ QString XmlSerializer::GetContentName( const QString        &sName,
                                        const QMetaObject   *pMetaObject,
                                        const QMetaProperty *pMetaProp )
 {
+    if (pMetaObject == NULL)
+        return sName;
+
+    ContentNameKey key( pMetaObject, sName );
+
+    QHash< ContentNameKey, QString >::const_iterator it =
+        m_contentNames.constFind( key );
+
+    if (it != m_contentNames.constEnd())
+        return *it;
+
+    QString sContentName     = sName;
     QString sMethodClassInfo = sName + "_type";
 
     int nClassIdx = pMetaObject->indexOfClassInfo( sMethodClassInfo.toAscii() );
 
     if (nClassIdx >=0)
-        return GetItemName( pMetaObject->classInfo( nClassIdx ).value() );
+        sContentName = GetItemName( pMetaObject->classInfo( nClassIdx ).value() );
+
+    m_contentNames.insert( key, sContentName );
 
-    return sName;
+    return sContentName;
 }
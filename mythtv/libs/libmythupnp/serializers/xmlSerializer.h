@@ -28,6 +28,8 @@
 #include <QVariant>
 #include <QIODevice>
 #include <QStringList>
+#include <QHash>
+#include <QPair>
 
 #include "upnpexp.h"
 #include "serializer.h"
@@ -48,6 +50,13 @@ class UPNP_PUBLIC XmlSerializer : public Serializer
         QXmlStreamWriter *m_pXmlWriter;
         QString           m_sRequestName;
 
+        // GetContentName results, the same few (class, property) pairs are
+        // looked up for every item in a list.
+
+        typedef QPair< const QMetaObject *, QString > ContentNameKey;
+
+        QHash< ContentNameKey, QString > m_contentNames;
+
         virtual void BeginSerialize( QString &sName );
         virtual void EndSerialize  ();
 
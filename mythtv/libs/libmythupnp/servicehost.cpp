@@ -426,6 +426,7 @@ bool ServiceHost::FormatResponse( HTTPRequest *pRequest, QObject *pResults )
 
         pRequest->FormatActionResponse( pSer );
 
+        delete pSer;
         delete pResults;
 
         return true;
@@ -491,5 +492,7 @@ bool ServiceHost::FormatResponse( HTTPRequest *pRequest, QVariant vValue )
 
     pRequest->FormatActionResponse( pSer );
 
+    delete pSer;
+
     return true;
 }
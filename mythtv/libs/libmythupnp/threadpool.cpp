@@ -364,7 +364,7 @@ void ThreadPool::InitializeThreads()
 //
 /////////////////////////////////////////////////////////////////////////////
 
-WorkerThread *ThreadPool::GetWorkerThread()
+WorkerThread *ThreadPool::GetWorkerThread( bool bWait )
 {
     WorkerThread *pThread     = NULL;
     long          nThreadCount= 0;
@@ -394,6 +394,8 @@ WorkerThread *ThreadPool::GetWorkerThread()
         
             if ( nThreadCount < m_nMaxThreadCount)
                 pThread = AddWorkerThread( false, m_nIdleTimeout );
+            else if (!bWait)
+                return NULL;     // caller will try again later.
             else
             {
                 QMutex mutex;
@@ -188,7 +188,7 @@ class UPNP_PUBLIC ThreadPool : public QObject
                         ThreadPool( const QString &sName );
         virtual        ~ThreadPool( );
 
-        WorkerThread   *GetWorkerThread();
+        WorkerThread   *GetWorkerThread( bool bWait = true );
 
 };
 
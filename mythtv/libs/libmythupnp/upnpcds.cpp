@@ -61,7 +61,8 @@ QString UPnpCDSExtensionResults::GetResultXML(FilterMap &filter)
 /////////////////////////////////////////////////////////////////////////////
 
 UPnpCDS::UPnpCDS( UPnpDevice *pDevice, const QString &sSharePath )
-  : Eventing( "UPnpCDS", "CDS_Event", sSharePath )
+  : Eventing( "UPnpCDS", "CDS_Event", sSharePath ),
+    m_nCacheTimeout( 300 ), m_nCacheMaxEntries( 512 )
 {
     m_root.m_eType      = OT_Container;
     m_root.m_sId        = "0";
@@ -82,6 +83,13 @@ UPnpCDS::UPnpCDS( UPnpDevice *pDevice, const QString &sSharePath )
     m_sServiceDescFileName = sUPnpDescPath + "CDS_scpd.xml";
     m_sControlUrl          = "/CDS_Control";
 
+    // Browse/Search result cache.  A timeout of 0 disables caching.
+
+    m_nCacheTimeout    = UPnp::GetConfiguration()->GetValue(
+                             "UPnP/CDSCacheTimeout"   , m_nCacheTimeout    );
+    m_nCacheMaxEntries = UPnp::GetConfiguration()->GetValue(
+                             "UPnP/CDSCacheMaxEntries", m_nCacheMaxEntries );
+
 
     // Add our Service Definition to the device.
 
@@ -150,6 +158,135 @@ void UPnpCDS::UnregisterExtension( UPnpCDSExtension *pExtension )
         delete pExtension;
         m_extensions.removeAll(pExtension);
     }
+
+    InvalidateCache();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Called when the content served by any extension has changed.  Clients
+// subscribed to our events see the new SystemUpdateID and re-browse, so
+// everything we have cached must be thrown away first.
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDS::IncrementSystemUpdateID( )
+{
+    InvalidateCache();
+
+    unsigned short nId = GetValue<unsigned short>( "SystemUpdateID" );
+
+    // Zero is not a valid SystemUpdateID, skip it when we wrap.
+
+    if (++nId == 0)
+        nId = 1;
+
+    SetValue< unsigned short >( "SystemUpdateID", nId );
+
+    LOG(VB_UPNP, LOG_INFO,
+        QString("UPnpCDS::IncrementSystemUpdateID - Now %1").arg(nId));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDS::InvalidateCache( )
+{
+    m_cacheLock.lock();
+    m_resultCache.clear();
+    m_cacheLock.unlock();
+
+    UPnpCDSExtensionList::iterator it = m_extensions.begin();
+    for (; it != m_extensions.end(); ++it)
+        (*it)->InvalidateCache();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QString UPnpCDS::GetCacheKey( const QString        &sMethod,
+                              const UPnpCDSRequest &request )
+{
+    // Some extensions tailor their results to the client, so it must be
+    // part of the key along with everything that selects the page.
+
+    return QString( "%1|%2|%3|%4|%5|%6|%7|%8|%9" )
+              .arg( sMethod                  )
+              .arg( request.m_sObjectId      )
+              .arg( request.m_eBrowseFlag    )
+              .arg( request.m_sSearchCriteria)
+              .arg( request.m_sFilter        )
+              .arg( request.m_sSortCriteria  )
+              .arg( request.m_nStartingIndex )
+              .arg( request.m_nRequestedCount)
+              .arg( QString( "%1/%2" ).arg( request.m_eClient        )
+                                      .arg( request.m_nClientVersion ));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool UPnpCDS::LookupCachedResult( const QString       &sKey,
+                                  UPnpCDSCachedResult &result )
+{
+    if (m_nCacheTimeout <= 0)
+        return false;
+
+    QMutexLocker locker( &m_cacheLock );
+
+    UPnpCDSResultCache::iterator it = m_resultCache.find( sKey );
+
+    if (it == m_resultCache.end())
+        return false;
+
+    if ((*it).m_ttExpires < QDateTime::currentDateTime())
+    {
+        m_resultCache.erase( it );
+        return false;
+    }
+
+    result = *it;
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDS::AddCachedResult( const QString       &sKey,
+                               UPnpCDSCachedResult &result )
+{
+    if (m_nCacheTimeout <= 0)
+        return;
+
+    QDateTime ttNow = QDateTime::currentDateTime();
+
+    result.m_ttExpires = ttNow.addSecs( m_nCacheTimeout );
+
+    QMutexLocker locker( &m_cacheLock );
+
+    if (m_resultCache.size() >= m_nCacheMaxEntries)
+    {
+        // Drop anything that has expired, and if that isn't enough,
+        // start over.  Renderers tend to walk the same few containers,
+        // so the cache refills quickly.
+
+        UPnpCDSResultCache::iterator it = m_resultCache.begin();
+        while (it != m_resultCache.end())
+        {
+            if ((*it).m_ttExpires < ttNow)
+                it = m_resultCache.erase( it );
+            else
+                ++it;
+        }
+
+        if (m_resultCache.size() >= m_nCacheMaxEntries)
+            m_resultCache.clear();
+    }
+
+    m_resultCache.insert( sKey, result );
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -331,7 +468,23 @@ void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
         QString("UPnpCDS::HandleBrowse ObjectID=%1, ContainerId=%2")
             .arg(request.m_sObjectId) .arg(request.m_sContainerID));
 
-    if (request.m_sObjectId == "0")
+    QString             sCacheKey = GetCacheKey( "Browse", request );
+    UPnpCDSCachedResult cached;
+    bool                bCached   = LookupCachedResult( sCacheKey, cached );
+
+    if (bCached)
+    {
+        eErrorCode      = UPnPResult_Success;
+        nNumberReturned = cached.m_nNumberReturned;
+        nTotalMatches   = cached.m_nTotalMatches;
+        nUpdateID       = cached.m_nUpdateID;
+        sResultXML      = cached.m_sResultXML;
+
+        LOG(VB_UPNP, LOG_DEBUG,
+            QString("UPnpCDS::HandleBrowse Using cached result for %1")
+                .arg(request.m_sObjectId));
+    }
+    else if (request.m_sObjectId == "0")
     {
         // ------------------------------------------------------------------
         // This is for the root object... lets handle it.
@@ -449,6 +602,16 @@ void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
 
     if (eErrorCode == UPnPResult_Success)
     {
+        if (!bCached)
+        {
+            cached.m_sResultXML      = sResultXML;
+            cached.m_nNumberReturned = nNumberReturned;
+            cached.m_nTotalMatches   = nTotalMatches;
+            cached.m_nUpdateID       = nUpdateID;
+
+            AddCachedResult( sCacheKey, cached );
+        }
+
         NameValues list;
 
         QString sResults = DIDL_LITE_BEGIN;
@@ -560,9 +723,24 @@ void UPnpCDS::HandleSearch( HTTPRequest *pRequest )
     bool bSearchDone = false;
 #endif
 
-    UPnpCDSExtensionList::iterator it = m_extensions.begin();
-    for (; (it != m_extensions.end()) && !pResult; ++it)
-        pResult = (*it)->Search(&request);
+    QString             sCacheKey = GetCacheKey( "Search", request );
+    UPnpCDSCachedResult cached;
+    bool                bCached   = LookupCachedResult( sCacheKey, cached );
+
+    if (bCached)
+    {
+        eErrorCode      = UPnPResult_Success;
+        nNumberReturned = cached.m_nNumberReturned;
+        nTotalMatches   = cached.m_nTotalMatches;
+        nUpdateID       = cached.m_nUpdateID;
+        sResultXML      = cached.m_sResultXML;
+    }
+    else
+    {
+        UPnpCDSExtensionList::iterator it = m_extensions.begin();
+        for (; (it != m_extensions.end()) && !pResult; ++it)
+            pResult = (*it)->Search(&request);
+    }
 
     if (pResult != NULL)
     {
@@ -591,6 +769,16 @@ void UPnpCDS::HandleSearch( HTTPRequest *pRequest )
 
     if (eErrorCode == UPnPResult_Success)
     {
+        if (!bCached)
+        {
+            cached.m_sResultXML      = sResultXML;
+            cached.m_nNumberReturned = nNumberReturned;
+            cached.m_nTotalMatches   = nTotalMatches;
+            cached.m_nUpdateID       = nUpdateID;
+
+            AddCachedResult( sCacheKey, cached );
+        }
+
         NameValues list;
         QString sResults = DIDL_LITE_BEGIN;
         sResults += sResultXML;
@@ -893,7 +1081,7 @@ UPnpCDSExtensionResults *
                             CreateContainer( sId, QObject::tr( pInfo->title ),
                                              m_sExtensionId );
 
-                        pItem->SetChildCount( GetDistinctCount( pInfo ) );
+                        pItem->SetChildCount( GetCachedDistinctCount( pInfo ) );
 
                         pResults->Add( pItem );
                     }
@@ -946,7 +1134,7 @@ UPnpCDSExtensionResults *
                                      QObject::tr( pInfo->title ),
                                      m_sExtensionId );
 
-                pItem->SetChildCount( GetDistinctCount( pInfo ) );
+                pItem->SetChildCount( GetCachedDistinctCount( pInfo ) );
 
                 pResults->Add( pItem );
             }
@@ -1097,7 +1285,7 @@ UPnpCDSExtensionResults *
                                              query.value(1).toString(),
                                              pRequest->m_sParentId );
 
-                        pItem->SetChildCount( GetDistinctCount( pInfo ));
+                        pItem->SetChildCount( GetCachedDistinctCount( pInfo ));
 
                         pResults->Add( pItem );
                     }
@@ -1154,7 +1342,7 @@ UPnpCDSExtensionResults *
                                                 QObject::tr( pInfo->title ),
                                                 m_sExtensionId );
 
-            pItem->SetChildCount( GetDistinctCount( pInfo ));
+            pItem->SetChildCount( GetCachedDistinctCount( pInfo ));
 
             pResults->Add( pItem );
             break;
@@ -1162,7 +1350,7 @@ UPnpCDSExtensionResults *
 
         case CDS_BrowseDirectChildren:
         {
-            pResults->m_nTotalMatches = GetDistinctCount( pInfo );
+            pResults->m_nTotalMatches = GetCachedDistinctCount( pInfo );
             pResults->m_nUpdateID     = 1;
 
             if (pRequest->m_nRequestedCount == 0)
@@ -1293,6 +1481,77 @@ int UPnpCDSExtension::GetCount( const QString &sColumn, const QString &sKey )
     return( nCount );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// The COUNT queries are the slowest part of browsing a large library and
+// the answers only change along with the SystemUpdateID, so remember them.
+/////////////////////////////////////////////////////////////////////////////
+
+int UPnpCDSExtension::GetCachedDistinctCount( UPnpCDSRootInfo *pInfo )
+{
+    if ((pInfo == NULL) || (pInfo->column == NULL))
+        return 0;
+
+    QString sCacheKey = QString( "DISTINCT|%1|%2" ).arg( pInfo->column )
+                                                   .arg( pInfo->title  );
+
+    m_countLock.lock();
+    QMap<QString, int>::const_iterator it = m_countCache.find( sCacheKey );
+    if (it != m_countCache.end())
+    {
+        int nCount = *it;
+        m_countLock.unlock();
+        return nCount;
+    }
+    m_countLock.unlock();
+
+    int nCount = GetDistinctCount( pInfo );
+
+    m_countLock.lock();
+    m_countCache.insert( sCacheKey, nCount );
+    m_countLock.unlock();
+
+    return nCount;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+int UPnpCDSExtension::GetCachedCount( const QString &sColumn,
+                                      const QString &sKey )
+{
+    QString sCacheKey = QString( "COUNT|%1|%2" ).arg( sColumn ).arg( sKey );
+
+    m_countLock.lock();
+    QMap<QString, int>::const_iterator it = m_countCache.find( sCacheKey );
+    if (it != m_countCache.end())
+    {
+        int nCount = *it;
+        m_countLock.unlock();
+        return nCount;
+    }
+    m_countLock.unlock();
+
+    int nCount = GetCount( sColumn, sKey );
+
+    m_countLock.lock();
+    m_countCache.insert( sCacheKey, nCount );
+    m_countLock.unlock();
+
+    return nCount;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDSExtension::InvalidateCache()
+{
+    QMutexLocker locker( &m_countLock );
+
+    m_countCache.clear();
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -1311,7 +1570,7 @@ void UPnpCDSExtension::CreateItems( UPnpCDSRequest          *pRequest,
     if (pInfo == NULL)
         return;
 
-    pResults->m_nTotalMatches = GetCount( pInfo->column, sKey );
+    pResults->m_nTotalMatches = GetCachedCount( pInfo->column, sKey );
     pResults->m_nUpdateID     = 1;
 
     if (pRequest->m_nRequestedCount == 0)
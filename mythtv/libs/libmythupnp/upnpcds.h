@@ -24,8 +24,10 @@
 #ifndef UPnpCDS_H_
 #define UPnpCDS_H_
 
+#include <QDateTime>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
 
 #include "upnp.h"
@@ -145,6 +147,34 @@ class UPNP_PUBLIC UPnpCDSExtensionResults
 
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+// Browse/Search results already rendered to DIDL-Lite, kept by UPnpCDS so
+// repeated requests for the same page of a container skip the database.
+//////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC UPnpCDSCachedResult
+{
+    public:
+
+        QString          m_sResultXML;
+        short            m_nNumberReturned;
+        short            m_nTotalMatches;
+        short            m_nUpdateID;
+        QDateTime        m_ttExpires;
+
+    public:
+
+        UPnpCDSCachedResult() : m_nNumberReturned( 0 ),
+                                m_nTotalMatches  ( 0 ),
+                                m_nUpdateID      ( 0 )
+        {
+        }
+};
+
+typedef QMap< QString, UPnpCDSCachedResult > UPnpCDSResultCache;
+
+//////////////////////////////////////////////////////////////////////////////
+
 typedef struct
 {
     const char *title;
@@ -163,6 +193,13 @@ class UPNP_PUBLIC UPnpCDSExtension
         QString     m_sName;
         QString     m_sClass;
 
+    private:
+
+        // Container counts, keyed by column/key.  Cleared by InvalidateCache.
+
+        QMutex              m_countLock;
+        QMap<QString, int>  m_countCache;
+
     protected:
 
         QString RemoveToken ( const QString &sToken, const QString &sStr, int num );
@@ -198,6 +235,9 @@ class UPNP_PUBLIC UPnpCDSExtension
         virtual int  GetDistinctCount      ( UPnpCDSRootInfo *pInfo );
         virtual int  GetCount              ( const QString &sColumn, const QString &sKey );
 
+        int  GetCachedDistinctCount( UPnpCDSRootInfo *pInfo );
+        int  GetCachedCount        ( const QString &sColumn, const QString &sKey );
+
         // ------------------------------------------------------------------
 
         virtual UPnpCDSRootInfo *GetRootInfo   ( int nIdx) = 0;
@@ -238,6 +278,8 @@ class UPNP_PUBLIC UPnpCDSExtension
 
         virtual QString GetSearchCapabilities() { return( "" ); }
         virtual QString GetSortCapabilities  () { return( "" ); }
+
+        virtual void    InvalidateCache      ();
 };
 
 typedef QList<UPnpCDSExtension*> UPnpCDSExtensionList;
@@ -260,6 +302,11 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         QString                m_sServiceDescFileName;
         QString                m_sControlUrl;
 
+        QMutex                 m_cacheLock;
+        UPnpCDSResultCache     m_resultCache;
+        int                    m_nCacheTimeout;
+        int                    m_nCacheMaxEntries;
+
     private:
 
         UPnpCDSMethod       GetMethod              ( const QString &sURI  );
@@ -272,6 +319,13 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         void            HandleGetSystemUpdateID    ( HTTPRequest *pRequest );
         void            DetermineClient            ( HTTPRequest *pRequest, UPnpCDSRequest *pCDSRequest );
 
+        QString         GetCacheKey                ( const QString        &sMethod,
+                                                     const UPnpCDSRequest &request );
+        bool            LookupCachedResult         ( const QString        &sKey,
+                                                     UPnpCDSCachedResult  &result );
+        void            AddCachedResult            ( const QString        &sKey,
+                                                     UPnpCDSCachedResult  &result );
+
     protected:
 
         // Implement UPnpServiceImpl methods that we can
@@ -290,6 +344,9 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         void     RegisterExtension  ( UPnpCDSExtension *pExtension );
         void     UnregisterExtension( UPnpCDSExtension *pExtension );
 
+        void     IncrementSystemUpdateID( );
+        void     InvalidateCache        ( );
+
         virtual QStringList GetBasePaths();
         
         virtual bool ProcessRequest( HttpWorkerThread *pThread, HTTPRequest *pRequest );
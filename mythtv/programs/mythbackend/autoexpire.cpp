@@ -50,6 +50,8 @@ extern AutoExpire *expirer;
  */
 #define SPACE_TOO_BIG_KB 3*1024*1024
 
+const int AutoExpire::kCandidateMaxAge = 12 * 60 * 60;
+
 /// \brief This calls AutoExpire::RunExpirer() from within a new thread.
 void ExpireThread::run(void)
 {
@@ -82,7 +84,11 @@ AutoExpire::AutoExpire(QMap<int, EncoderLink *> *tvList) :
     expire_thread_run(true),
     main_server(NULL),
     update_pending(false),
-    update_thread(NULL)
+    update_thread(NULL),
+    order_method(0),
+    order_watched(false),
+    order_day_priority(0),
+    reload_candidates(true)
 {
     expire_thread->start();
     gCoreContext->addListener(this);
@@ -98,7 +104,11 @@ AutoExpire::AutoExpire() :
     expire_thread_run(false),
     main_server(NULL),
     update_pending(false),
-    update_thread(NULL)
+    update_thread(NULL),
+    order_method(0),
+    order_watched(false),
+    order_day_priority(0),
+    reload_candidates(true)
 {
 }
 
@@ -389,7 +399,9 @@ void AutoExpire::ExpireOldDeleted(void)
  */
 void AutoExpire::ExpireRecordings(void)
 {
-    pginfolist_t expireList;
+    QStringList expireKeys;
+    QMap<QString, ProgramInfo*> expireInfo;
+    bool expireKeysFilled = false;
     pginfolist_t deleteList;
     QList<FileSystemInfo> fsInfos;
     QList<FileSystemInfo>::iterator fsit;
@@ -407,8 +419,6 @@ void AutoExpire::ExpireRecordings(void)
         return;
     }
 
-    FillExpireList(expireList);
-
     QMap <int, bool> truncateMap;
     MSqlQuery query(MSqlQuery::InitCon());
     query.prepare("SELECT DISTINCT rechost, recdir "
@@ -513,17 +523,27 @@ void AutoExpire::ExpireRecordings(void)
                 }
             }
 
+            // Only look at the candidates once some filesystem needs them
+            if (!expireKeysFilled)
+            {
+                FillExpireKeys(expireKeys, expireInfo);
+                expireKeysFilled = true;
+            }
+
             LOG(VB_FILE, LOG_INFO,
                 "    Searching for files expirable in these directories");
             QString myHostName = gCoreContext->GetHostName();
-            pginfolist_t::iterator it = expireList.begin();
-            while ((it != expireList.end()) &&
+            QStringList::const_iterator it = expireKeys.begin();
+            while ((it != expireKeys.end()) &&
                    ((size_t)max(0LL, fsit->getFreeSpace()) <
                     desired_space[fsit->getFSysID()]))
             {
-                ProgramInfo *p = *it;
+                ProgramInfo *p = GetExpireInfo(expireInfo, *it);
                 ++it;
 
+                if (!p)
+                    continue;
+
                 LOG(VB_FILE, LOG_INFO, QString("        Checking %1 => %2")
                         .arg(p->toString(ProgramInfo::kRecordingKey))
                         .arg(p->GetTitle()));
@@ -594,7 +614,7 @@ void AutoExpire::ExpireRecordings(void)
     SendDeleteMessages(deleteList);
 
     ClearExpireList(deleteList, false);
-    ClearExpireList(expireList);
+    qDeleteAll(expireInfo);
 }
 
 /**
@@ -641,109 +661,94 @@ void AutoExpire::SendDeleteMessages(pginfolist_t &deleteList)
  */
 void AutoExpire::ExpireEpisodesOverMax(void)
 {
-    QMap<QString, int> maxEpisodes;
-    QMap<QString, int>::Iterator maxIter;
     QMap<QString, int> episodeParts;
     QString episodeKey;
 
-    QString fileprefix = gCoreContext->GetFilePrefix();
-
     MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare("SELECT recordid, maxepisodes, title "
-                  "FROM record WHERE maxepisodes > 0 "
-                  "ORDER BY recordid ASC, maxepisodes DESC");
-
-    if (query.exec() && query.isActive() && query.size() > 0)
+    query.prepare("SELECT record.recordid, record.maxepisodes, "
+                      "recorded.chanid, recorded.starttime, recorded.title, "
+                      "recorded.progstart, recorded.progend, "
+                      "recorded.filesize, recorded.duplicate "
+                  "FROM record, recorded "
+                  "WHERE record.maxepisodes > 0 "
+                  "AND recorded.recordid = record.recordid "
+                  "AND recorded.preserve = 0 "
+                  "AND recorded.recgroup NOT IN ('LiveTV', 'Deleted') "
+                  "ORDER BY record.recordid ASC, recorded.starttime DESC;");
+
+    if (!query.exec() || !query.isActive())
     {
-        LOG(VB_FILE, LOG_INFO, LOC +
-            QString("Found %1 record profiles using max episode expiration")
-                .arg(query.size()));
-        while (query.next())
-        {
-            LOG(VB_FILE, LOG_INFO, QString("    %1 (%2 for rec id %3)")
-                                     .arg(query.value(2).toString())
-                                     .arg(query.value(1).toInt())
-                                     .arg(query.value(0).toInt()));
-            maxEpisodes[query.value(0).toString()] = query.value(1).toInt();
-        }
+        MythDB::DBError("AutoExpire query failed!", query);
+        return;
     }
 
     LOG(VB_FILE, LOG_INFO, LOC +
         "Checking episode count for each recording profile using max episodes");
-    for (maxIter = maxEpisodes.begin(); maxIter != maxEpisodes.end(); ++maxIter)
+
+    int recordid = -1;
+    int maxEpisodes = 0;
+    int found = 1;
+    while (query.next())
     {
-        query.prepare("SELECT chanid, starttime, title, progstart, progend, "
-                          "filesize, duplicate "
-                      "FROM recorded "
-                      "WHERE recordid = :RECID AND preserve = 0 "
-                      "AND recgroup NOT IN ('LiveTV', 'Deleted') "
-                      "ORDER BY starttime DESC;");
-        query.bindValue(":RECID", maxIter.key());
-
-        if (!query.exec() || !query.isActive())
+        if (query.value(0).toInt() != recordid)
         {
-            MythDB::DBError("AutoExpire query failed!", query);
-            continue;
+            recordid    = query.value(0).toInt();
+            maxEpisodes = query.value(1).toInt();
+            found       = 1;
+
+            LOG(VB_FILE, LOG_INFO, QString("    %1 (%2 for rec id %3)")
+                                     .arg(query.value(4).toString())
+                                     .arg(maxEpisodes).arg(recordid));
         }
 
-        LOG(VB_FILE, LOG_INFO, QString("    Recordid %1 has %2 recordings.")
-                                 .arg(maxIter.key())
-                                 .arg(query.size()));
-        if (query.size() > 0)
+        uint chanid = query.value(2).toUInt();
+        QDateTime startts = query.value(3).toDateTime();
+        QString title = query.value(4).toString();
+        QDateTime progstart = query.value(5).toDateTime();
+        QDateTime progend = query.value(6).toDateTime();
+        int duplicate = query.value(8).toInt();
+
+        episodeKey = QString("%1_%2_%3")
+                     .arg(chanid)
+                     .arg(progstart.toString(Qt::ISODate))
+                     .arg(progend.toString(Qt::ISODate));
+
+        if ((!IsInDontExpireSet(chanid, startts)) &&
+            (!episodeParts.contains(episodeKey)) &&
+            (found > maxEpisodes))
+        {
+            long long spaceFreed = query.value(7).toLongLong() >> 20;
+            QString msg =
+                QString("%1Expiring %2 MBytes for %3 at %4 => %5.  "
+                        "Too many episodes, we only want to keep %6.")
+                    .arg(VERBOSE_LEVEL_CHECK(VB_FILE) ? "    " : "")
+                    .arg(spaceFreed)
+                    .arg(chanid).arg(startts.toString())
+                    .arg(title).arg(maxEpisodes);
+
+            LOG(VB_GENERAL, LOG_NOTICE, msg);
+
+            msg = QString("AUTO_EXPIRE %1 %2")
+                          .arg(chanid)
+                          .arg(startts.toString(Qt::ISODate));
+
+            MythEvent me(msg);
+            gCoreContext->dispatch(me);
+        }
+        else
         {
-            int found = 1;
-            while (query.next())
+            // keep track of shows we haven't expired so we can
+            // make sure we don't expire another part of the same
+            // episode.
+            if (episodeParts.contains(episodeKey))
             {
-                uint chanid = query.value(0).toUInt();
-                QDateTime startts = query.value(1).toDateTime();
-                QString title = query.value(2).toString();
-                QDateTime progstart = query.value(3).toDateTime();
-                QDateTime progend = query.value(4).toDateTime();
-                int duplicate = query.value(6).toInt();
-
-                episodeKey = QString("%1_%2_%3")
-                             .arg(chanid)
-                             .arg(progstart.toString(Qt::ISODate))
-                             .arg(progend.toString(Qt::ISODate));
-
-                if ((!IsInDontExpireSet(chanid, startts)) &&
-                    (!episodeParts.contains(episodeKey)) &&
-                    (found > *maxIter))
-                {
-                    long long spaceFreed = query.value(5).toLongLong() >> 20;
-                    QString msg =
-                        QString("%1Expiring %2 MBytes for %3 at %4 => %5.  "
-                                "Too many episodes, we only want to keep %6.")
-                            .arg(VERBOSE_LEVEL_CHECK(VB_FILE) ? "    " : "")
-                            .arg(spaceFreed)
-                            .arg(chanid).arg(startts.toString())
-                            .arg(title).arg(*maxIter);
-
-                    LOG(VB_GENERAL, LOG_NOTICE, msg);
-
-                    msg = QString("AUTO_EXPIRE %1 %2")
-                                  .arg(chanid)
-                                  .arg(startts.toString(Qt::ISODate));
-
-                    MythEvent me(msg);
-                    gCoreContext->dispatch(me);
-                }
-                else
-                {
-                    // keep track of shows we haven't expired so we can
-                    // make sure we don't expire another part of the same
-                    // episode.
-                    if (episodeParts.contains(episodeKey))
-                    {
-                        episodeParts[episodeKey] = episodeParts[episodeKey] + 1;
-                    }
-                    else
-                    {
-                        episodeParts[episodeKey] = 1;
-                        if( duplicate )
-                            found++;
-                    }
-                }
+                episodeParts[episodeKey] = episodeParts[episodeKey] + 1;
+            }
+            else
+            {
+                episodeParts[episodeKey] = 1;
+                if( duplicate )
+                    found++;
             }
         }
     }
@@ -1005,6 +1010,319 @@ void AutoExpire::FillDBOrdered(pginfolist_t &expireList, int expMethod)
     }
 }
 
+/** \fn AutoExpire::FillExpireKeys(QStringList&, QMap<QString, ProgramInfo*>&)
+ *  \brief Fills expireKeys with the unique keys of the programs that can
+ *         be expired, in the same order as FillExpireList().
+ *
+ *   Normal recordings come from the in-memory candidates and are not
+ *   loaded here, use GetExpireInfo() to load them as they are needed.
+ *   Deleted programs in FIFO order are loaded into expireInfo.
+ */
+void AutoExpire::FillExpireKeys(QStringList &expireKeys,
+                                QMap<QString, ProgramInfo*> &expireInfo)
+{
+    pginfolist_t deletedList;
+    FillDBOrdered(deletedList, emNormalDeletedPrograms);
+
+    pginfolist_t::iterator dit = deletedList.begin();
+    for (; dit != deletedList.end(); ++dit)
+    {
+        QString key = (*dit)->MakeUniqueKey();
+        expireKeys.push_back(key);
+        expireInfo[key] = *dit;
+    }
+
+    UpdateCandidates();
+
+    switch (order_method)
+    {
+        case emOldestFirst:
+        case emLowestPriorityFirst:
+        case emWeightedTimePriority:
+            break;
+        default:
+            // no AutoExpire
+            return;
+    }
+
+    uint skipped = 0;
+    QMap<ExpireOrder, QString>::const_iterator it = candidate_order.begin();
+    for (; it != candidate_order.end(); ++it)
+    {
+        if (expireInfo.contains(*it))
+            continue;
+
+        if (dont_expire_set.contains(*it))
+        {
+            skipped++;
+            continue;
+        }
+
+        expireKeys.push_back(*it);
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("FillExpireKeys: %1 expirable, %2 in Don't Expire List")
+            .arg(expireKeys.size()).arg(skipped));
+}
+
+/** \fn AutoExpire::GetExpireInfo(QMap<QString, ProgramInfo*>&, const QString&)
+ *  \brief Returns the program for a key from FillExpireKeys(), loading it
+ *         into expireInfo the first time it is asked for.
+ *  \return NULL if it is no longer in the database.
+ */
+ProgramInfo *AutoExpire::GetExpireInfo(
+    QMap<QString, ProgramInfo*> &expireInfo, const QString &key)
+{
+    QMap<QString, ProgramInfo*>::iterator it = expireInfo.find(key);
+    if (it != expireInfo.end())
+        return *it;
+
+    uint chanid;
+    QDateTime recstartts;
+    ProgramInfo *pginfo = NULL;
+
+    if (ProgramInfo::ExtractKey(key, chanid, recstartts))
+    {
+        pginfo = new ProgramInfo(chanid, recstartts);
+        if (!pginfo->GetChanID())
+        {
+            LOG(VB_FILE, LOG_INFO, LOC +
+                QString("    Skipping %1 at %2 "
+                        "because it could not be loaded from the DB")
+                    .arg(chanid).arg(recstartts.toString(Qt::ISODate)));
+            delete pginfo;
+            pginfo = NULL;
+        }
+    }
+
+    expireInfo[key] = pginfo;
+    return pginfo;
+}
+
+/** \fn AutoExpire::UpdateCandidates(void)
+ *  \brief Brings the expire candidates up to date.
+ *
+ *   The candidates are the recordings with autoexpire set, kept in the
+ *   order of the AutoExpireMethod so the expirer doesn't have to query
+ *   and load every one of them on each pass. Only the recordings named
+ *   in RECORDING_LIST_CHANGE and MASTER_UPDATE_PROG_INFO events since
+ *   the last call are reloaded. Everything is reloaded on a bare
+ *   RECORDING_LIST_CHANGE and every kCandidateMaxAge seconds, which
+ *   picks up changes made to the database behind our back.
+ */
+void AutoExpire::UpdateCandidates(void)
+{
+    int  method      = gCoreContext->GetNumSetting("AutoExpireMethod",
+                                                   emOldestFirst);
+    bool watched     = gCoreContext->GetNumSetting(
+        "AutoExpireWatchedPriority", 0);
+    int  dayPriority = gCoreContext->GetNumSetting("AutoExpireDayPriority", 3);
+
+    QSet<QString> changed;
+    bool reload;
+    {
+        QMutexLocker locker(&change_lock);
+        changed = changed_candidates;
+        changed_candidates.clear();
+        reload = reload_candidates;
+        reload_candidates = false;
+    }
+
+    QDateTime now = QDateTime::currentDateTime();
+    if (!candidates_loaded.isValid() ||
+        (candidates_loaded.secsTo(now) > kCandidateMaxAge))
+    {
+        reload = true;
+    }
+
+    bool reorder = (method      != order_method)  ||
+                   (watched     != order_watched) ||
+                   (dayPriority != order_day_priority);
+
+    order_method       = method;
+    order_watched      = watched;
+    order_day_priority = dayPriority;
+
+    if (reload)
+    {
+        candidates.clear();
+        candidate_order.clear();
+        LoadCandidates();
+        candidates_loaded = now;
+
+        LOG(VB_FILE, LOG_INFO, LOC + QString("Loaded %1 expire candidates")
+                .arg(candidates.size()));
+        return;
+    }
+
+    if (reorder)
+    {
+        candidate_order.clear();
+        QMap<QString, ExpireCandidate>::iterator it = candidates.begin();
+        for (; it != candidates.end(); ++it)
+        {
+            (*it).order = MakeOrder(*it);
+            candidate_order[(*it).order] = it.key();
+        }
+    }
+
+    QSet<QString>::const_iterator cit = changed.begin();
+    for (; cit != changed.end(); ++cit)
+    {
+        uint chanid;
+        QDateTime recstartts;
+
+        RemoveCandidate(*cit);
+        if (ProgramInfo::ExtractKey(*cit, chanid, recstartts))
+            LoadCandidates(chanid, recstartts);
+    }
+
+    if (!changed.empty())
+    {
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("Updated %1 of %2 expire candidates")
+                .arg(changed.size()).arg(candidates.size()));
+    }
+}
+
+/** \fn AutoExpire::LoadCandidates(uint, const QDateTime&)
+ *  \brief Adds the recording to the candidates if it can be expired,
+ *         or all such recordings if chanid is 0.
+ */
+void AutoExpire::LoadCandidates(uint chanid, const QDateTime &recstartts)
+{
+    QString querystr =
+        "SELECT chanid, starttime, autoexpire, watched, recpriority "
+        "FROM recorded "
+        "WHERE autoexpire > 0 AND deletepending = 0";
+    if (chanid)
+        querystr += " AND chanid = :CHANID AND starttime = :STARTTIME";
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(querystr);
+    if (chanid)
+    {
+        query.bindValue(":CHANID", chanid);
+        query.bindValue(":STARTTIME", recstartts);
+    }
+
+    if (!query.exec())
+    {
+        MythDB::DBError(LOC + "LoadCandidates", query);
+        return;
+    }
+
+    while (query.next())
+    {
+        ExpireCandidate candidate;
+        candidate.chanid      = query.value(0).toUInt();
+        candidate.recstartts  = query.value(1).toDateTime();
+        candidate.autoexpire  = query.value(2).toInt();
+        candidate.watched     = query.value(3).toInt();
+        candidate.recpriority = query.value(4).toInt();
+        candidate.order       = MakeOrder(candidate);
+
+        QString key = ProgramInfo::MakeUniqueKey(candidate.chanid,
+                                                 candidate.recstartts);
+        RemoveCandidate(key);
+        candidates[key] = candidate;
+        candidate_order[candidate.order] = key;
+    }
+}
+
+void AutoExpire::RemoveCandidate(const QString &key)
+{
+    QMap<QString, ExpireCandidate>::iterator it = candidates.find(key);
+    if (it == candidates.end())
+        return;
+
+    candidate_order.remove((*it).order);
+    candidates.erase(it);
+}
+
+/// \brief Returns the sort key matching the ORDER BY of FillDBOrdered()
+///        for the current AutoExpireMethod.
+AutoExpire::ExpireOrder AutoExpire::MakeOrder(
+    const ExpireCandidate &candidate) const
+{
+    ExpireOrder order;
+    order.autoexpire = candidate.autoexpire;
+    order.watched    = order_watched && candidate.watched;
+    order.priority   = 0;
+    order.recstart   = candidate.recstartts.toTime_t();
+    order.when       = order.recstart;
+    order.chanid     = candidate.chanid;
+
+    if (order_method == emLowestPriorityFirst)
+        order.priority = candidate.recpriority;
+    else if (order_method == emWeightedTimePriority)
+        order.when += (qint64) order_day_priority * candidate.recpriority *
+                      24 * 60 * 60;
+
+    return order;
+}
+
+bool AutoExpire::ExpireOrder::operator<(const ExpireOrder &other) const
+{
+    if (autoexpire != other.autoexpire)
+        return autoexpire > other.autoexpire;
+    if (watched != other.watched)
+        return watched;
+    if (priority != other.priority)
+        return priority < other.priority;
+    if (when != other.when)
+        return when < other.when;
+    if (recstart != other.recstart)
+        return recstart < other.recstart;
+    return chanid < other.chanid;
+}
+
+/** \fn AutoExpire::customEvent(QEvent*)
+ *  \brief Notes recordings that changed so UpdateCandidates() can
+ *         reload them.
+ */
+void AutoExpire::customEvent(QEvent *event)
+{
+    if ((MythEvent::Type)(event->type()) != MythEvent::MythEventMessage)
+        return;
+
+    MythEvent *me = (MythEvent *)event;
+    QStringList tokens = me->Message().simplified().split(" ");
+
+    uint chanid = 0;
+    QDateTime recstartts;
+
+    if (tokens[0] == "RECORDING_LIST_CHANGE")
+    {
+        if (tokens.size() == 1)
+        {
+            QMutexLocker locker(&change_lock);
+            reload_candidates = true;
+            return;
+        }
+
+        if ((tokens.size() >= 4) &&
+            ((tokens[1] == "ADD") || (tokens[1] == "DELETE")))
+        {
+            chanid     = tokens[2].toUInt();
+            recstartts = QDateTime::fromString(tokens[3], Qt::ISODate);
+        }
+    }
+    else if ((tokens[0] == "MASTER_UPDATE_PROG_INFO") && (tokens.size() >= 3))
+    {
+        chanid     = tokens[1].toUInt();
+        recstartts = QDateTime::fromString(tokens[2], Qt::ISODate);
+    }
+
+    if (chanid && recstartts.isValid())
+    {
+        QMutexLocker locker(&change_lock);
+        changed_candidates.insert(
+            ProgramInfo::MakeUniqueKey(chanid, recstartts));
+    }
+}
+
 /** \brief This is used by Update(QMap<int, EncoderLink*> *, bool)
  *         to run CalcParams(vector<EncoderLink*>).
  *
@@ -15,6 +15,7 @@ using namespace std;
 #include <QDateTime>
 #include <QThread>
 #include <QPointer>
+#include <QStringList>
 
 class ProgramInfo;
 class EncoderLink;
@@ -92,6 +93,7 @@ class AutoExpire : public QObject
   protected:
     void RunExpirer(void);
     void RunUpdate(void);
+    virtual void customEvent(QEvent *event);
 
   private:
     void ExpireLiveTV(int type);
@@ -101,6 +103,10 @@ class AutoExpire : public QObject
 
     void FillExpireList(pginfolist_t &expireList);
     void FillDBOrdered(pginfolist_t &expireList, int expMethod);
+    void FillExpireKeys(QStringList &expireKeys,
+                        QMap<QString, ProgramInfo*> &expireInfo);
+    static ProgramInfo *GetExpireInfo(QMap<QString, ProgramInfo*> &expireInfo,
+                                      const QString &key);
     void SendDeleteMessages(pginfolist_t &deleteList);
     void Sleep(int sleepTime /*ms*/);
 
@@ -109,6 +115,38 @@ class AutoExpire : public QObject
     static bool IsInExpireList(const pginfolist_t &expireList,
                                uint chanid, const QDateTime &recstartts);
 
+    /// Sorts expire candidates the way FillDBOrdered() orders them
+    class ExpireOrder
+    {
+      public:
+        bool operator<(const ExpireOrder &other) const;
+
+        int    autoexpire; ///< higher values expire first
+        bool   watched;    ///< watched first, if AutoExpireWatchedPriority
+        int    priority;   ///< lower values expire first
+        qint64 when;       ///< earlier expires first
+        qint64 recstart;
+        uint   chanid;
+    };
+
+    /// A recording with autoexpire set, see UpdateCandidates()
+    class ExpireCandidate
+    {
+      public:
+        uint        chanid;
+        QDateTime   recstartts;
+        int         autoexpire;
+        bool        watched;
+        int         recpriority;
+        ExpireOrder order;
+    };
+
+    void UpdateCandidates(void);
+    void LoadCandidates(uint chanid = 0,
+                        const QDateTime &recstartts = QDateTime());
+    void RemoveCandidate(const QString &key);
+    ExpireOrder MakeOrder(const ExpireCandidate &candidate) const;
+
     // main expire info
     QSet<QString> dont_expire_set;
     QSet<QString> deleted_set;
@@ -127,6 +165,22 @@ class AutoExpire : public QObject
     // update info
     bool          update_pending; // protected by instance_lock
     UpdateThread *update_thread;
+
+    // expire candidates, only used by the expire thread
+    QMap<QString, ExpireCandidate> candidates;      // by unique key
+    QMap<ExpireOrder, QString>     candidate_order; // in expiration order
+    QDateTime                      candidates_loaded;
+    int                            order_method;
+    bool                           order_watched;
+    int                            order_day_priority;
+
+    // recordings changed since the last UpdateCandidates()
+    QMutex        change_lock;
+    QSet<QString> changed_candidates; // protected by change_lock
+    bool          reload_candidates;  // protected by change_lock
+
+    /// Seconds after which the candidates are reloaded from scratch
+    static const int kCandidateMaxAge;
 };
 
 #endif
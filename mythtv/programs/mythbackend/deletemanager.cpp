@@ -0,0 +1,342 @@
+// POSIX headers
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#ifdef __linux__
+#  include <linux/falloc.h>
+#endif
+
+// C++ headers
+#include <algorithm>
+using namespace std;
+
+// Qt headers
+#include <QFileInfo>
+
+// MythTV headers
+#include "deletemanager.h"
+#include "ThreadedFileWriter.h"
+#include "programinfo.h"
+#include "mythcorecontext.h"
+#include "mythdb.h"
+#include "mythlogging.h"
+
+#define LOC QString("DeleteManager: ")
+
+const int DeleteManager::kMinSleepTime  = 100;
+const int DeleteManager::kBaseSleepTime = 500;
+const int DeleteManager::kMaxSleepTime  = 8000;
+
+/// \brief Runs DeleteManager::RunDeletes(void)
+void DeleteManagerThread::run(void)
+{
+    threadRegister("DeleteManager");
+    m_parent->RunDeletes();
+    threadDeregister();
+}
+
+/** \class DeleteManager
+ *  \brief Slowly truncates unlinked recordings when TruncateDeletesSlowly
+ *         is set.
+ *
+ *   Files are queued per filesystem and shrunk one step at a time, the
+ *   oldest file first. Different filesystems are worked on in parallel.
+ *   The time between steps follows the write latency of the recordings
+ *   (ThreadedFileWriter) on the same device: it is short when nothing is
+ *   being recorded there, and backs off when the latency goes above
+ *   DeleteMaxWriteLatency milliseconds.
+ *
+ *   Where the filesystem supports it the blocks are released with
+ *   fallocate(FALLOC_FL_PUNCH_HOLE), which leaves the inode size alone,
+ *   otherwise with ftruncate().
+ */
+
+DeleteManager::DeleteManager(void) :
+    running(true), thread(new DeleteManagerThread(this))
+{
+    thread->start();
+}
+
+DeleteManager::~DeleteManager()
+{
+    lock.lock();
+    running = false;
+    wakeup.wakeAll();
+    lock.unlock();
+
+    thread->wait();
+    delete thread;
+    thread = NULL;
+
+    // The files are already unlinked, closing them releases the rest
+    // of their space in one go.
+    QMap<dev_t, DeleteDevice>::iterator it = devices.begin();
+    for (; it != devices.end(); ++it)
+    {
+        while (!(*it).files.empty())
+            FinishEntry((*it).files.takeFirst());
+    }
+}
+
+/** \fn DeleteManager::AddFile(int, const QString&, off_t, const ProgramInfo*)
+ *  \brief Queues an unlinked file for deletion. The manager takes
+ *         ownership of the file descriptor.
+ *
+ *  \param fd       descriptor returned by MainServer::DeleteFile()
+ *  \param filename name the file had, used for logging and in-use marks
+ *  \param size     size of the file before it was unlinked
+ *  \param pginfo   if not NULL the recording is marked as in use while
+ *                  it is being truncated
+ */
+void DeleteManager::AddFile(int fd, const QString &filename, off_t size,
+                            const ProgramInfo *pginfo)
+{
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to stat '%1'")
+                .arg(filename) + ENO);
+        close(fd);
+        return;
+    }
+
+    DeleteEntry *entry = new DeleteEntry();
+    entry->fd        = fd;
+    entry->filename  = filename;
+    entry->size      = size;
+    entry->increment = CalcIncrement();
+    entry->punchHole = true;
+    entry->steps     = 0;
+    entry->pginfo    = NULL;
+
+    if (pginfo)
+    {
+        entry->pginfo = new ProgramInfo(*pginfo);
+        entry->pginfo->SetPathname(filename);
+        entry->pginfo->MarkAsInUse(true, kTruncatingDeleteInUseID);
+    }
+
+    QMutexLocker locker(&lock);
+
+    DeleteDevice &dev = devices[st.st_dev];
+    dev.files.push_back(entry);
+    dev.bytes += size;
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("Queued '%1' (%2 MB), %3 file(s) and %4 MB pending "
+                "on this filesystem")
+            .arg(filename).arg(size >> 20)
+            .arg(dev.files.size()).arg(dev.bytes >> 20));
+
+    wakeup.wakeAll();
+}
+
+/** \fn DeleteManager::GetPending(QList<DeletePendingInfo>&) const
+ *  \brief Returns one entry for each filesystem with files pending.
+ */
+void DeleteManager::GetPending(QList<DeletePendingInfo> &list) const
+{
+    QMutexLocker locker(&lock);
+
+    QMap<dev_t, DeleteDevice>::const_iterator it = devices.begin();
+    for (; it != devices.end(); ++it)
+    {
+        if ((*it).files.empty())
+            continue;
+
+        DeletePendingInfo info;
+        info.path         = QFileInfo((*it).files.front()->filename).path();
+        info.files        = (*it).files.size();
+        info.bytes        = (*it).bytes;
+        info.sleepTime    = (*it).sleepTime;
+        info.writeLatency =
+            ThreadedFileWriter::GetWriteLatency(it.key(), &info.writers);
+
+        list.push_back(info);
+    }
+}
+
+void DeleteManager::RunDeletes(void)
+{
+    QMutexLocker locker(&lock);
+
+    while (running)
+    {
+        int sleepTime = -1;
+
+        // Only this thread removes devices or files, so the keys and
+        // the entry at the front of each list stay valid while unlocked.
+        QList<dev_t> keys = devices.keys();
+        QList<dev_t>::const_iterator kit = keys.begin();
+        for (; (kit != keys.end()) && running; ++kit)
+        {
+            DeleteDevice &dev = devices[*kit];
+
+            if (dev.files.empty())
+            {
+                devices.remove(*kit);
+                continue;
+            }
+
+            if (dev.lastStep.isRunning() &&
+                (dev.lastStep.elapsed() < dev.sleepTime))
+            {
+                int left = dev.sleepTime - dev.lastStep.elapsed();
+                sleepTime = (sleepTime < 0) ? left : min(sleepTime, left);
+                continue;
+            }
+
+            UpdateSleepTime(*kit, dev);
+
+            DeleteEntry *entry = dev.files.front();
+            off_t before = entry->size;
+
+            locker.unlock();
+            bool done = TruncateStep(entry);
+            locker.relock();
+
+            DeleteDevice &cur = devices[*kit];
+            cur.bytes -= before - entry->size;
+            cur.lastStep.start();
+
+            if (done)
+            {
+                cur.files.pop_front();
+                cur.bytes -= entry->size;
+
+                locker.unlock();
+                FinishEntry(entry);
+                locker.relock();
+            }
+
+            sleepTime = (sleepTime < 0) ?
+                cur.sleepTime : min(sleepTime, cur.sleepTime);
+        }
+
+        if (!running)
+            break;
+
+        if (sleepTime < 0)
+            wakeup.wait(locker.mutex());
+        else if (sleepTime > 0)
+            wakeup.wait(locker.mutex(), sleepTime);
+    }
+}
+
+/** \fn DeleteManager::TruncateStep(DeleteEntry*)
+ *  \brief Releases the last entry->increment bytes of a file.
+ *  \return true when there is nothing left to release.
+ */
+bool DeleteManager::TruncateStep(DeleteEntry *entry)
+{
+    off_t newsize = max(entry->size - entry->increment, (off_t)0);
+
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+    if (entry->punchHole)
+    {
+        if (fallocate(entry->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      newsize, entry->size - newsize) == 0)
+        {
+            entry->size = newsize;
+        }
+        else
+        {
+            LOG(VB_FILE, LOG_INFO, LOC +
+                QString("Hole punching not available for '%1', "
+                        "using ftruncate").arg(entry->filename) + ENO);
+            entry->punchHole = false;
+        }
+    }
+#else
+    entry->punchHole = false;
+#endif
+
+    if (!entry->punchHole)
+    {
+        if (ftruncate(entry->fd, newsize))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error truncating '%1'")
+                    .arg(entry->filename) + ENO);
+            return true;
+        }
+        entry->size = newsize;
+    }
+
+    if (entry->pginfo && ((entry->steps % 100) == 0))
+        entry->pginfo->UpdateInUseMark(true);
+
+    entry->steps++;
+
+    return entry->size <= 0;
+}
+
+void DeleteManager::FinishEntry(DeleteEntry *entry)
+{
+    if (close(entry->fd))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error closing '%1'")
+                .arg(entry->filename) + ENO);
+    }
+
+    if (entry->pginfo)
+    {
+        entry->pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
+        delete entry->pginfo;
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC + QString("Finished deleting '%1'")
+            .arg(entry->filename));
+
+    delete entry;
+}
+
+/** \fn DeleteManager::UpdateSleepTime(dev_t, DeleteDevice&)
+ *  \brief Adjusts the time between steps on a device from the write
+ *         latency of the recordings on it.
+ */
+void DeleteManager::UpdateSleepTime(dev_t device, DeleteDevice &dev)
+{
+    uint writers = 0;
+    int latency = ThreadedFileWriter::GetWriteLatency(device, &writers);
+    int maxLatency = gCoreContext->GetNumSetting("DeleteMaxWriteLatency", 200);
+    int old = dev.sleepTime;
+
+    if (!writers)
+        dev.sleepTime = kMinSleepTime;
+    else if (latency > maxLatency)
+        dev.sleepTime = min(max(dev.sleepTime, (int)kBaseSleepTime) * 2,
+                            (int)kMaxSleepTime);
+    else if (latency < maxLatency / 2)
+        dev.sleepTime = max(dev.sleepTime * 3 / 4, (int)kBaseSleepTime);
+    else
+        dev.sleepTime = max(dev.sleepTime, (int)kBaseSleepTime);
+
+    if (dev.sleepTime != old)
+    {
+        LOG(VB_FILE, LOG_DEBUG, LOC +
+            QString("%1 writer(s) at %2 ms, truncating every %3 ms")
+                .arg(writers).arg(latency).arg(dev.sleepTime));
+    }
+}
+
+/// \brief Bytes to release per step, enough to keep up with all the
+///        tuners recording HD at once when stepping every kBaseSleepTime.
+off_t DeleteManager::CalcIncrement(void)
+{
+    int cards = 5;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT COUNT(cardid) FROM capturecard;");
+    if (query.exec() && query.isActive() && query.size() && query.next())
+        cards = query.value(0).toInt();
+
+    const size_t min_tps  = 8 * 1024 * 1024;
+    const size_t calc_tps = (size_t) (cards * 1.2 * (22200000LL / 8));
+    const size_t tps      = max(min_tps, calc_tps);
+
+    return (off_t) (tps * (kBaseSleepTime * 0.001f));
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -0,0 +1,104 @@
+#ifndef DELETEMANAGER_H_
+#define DELETEMANAGER_H_
+
+#include <sys/types.h>
+
+#include <QWaitCondition>
+#include <QString>
+#include <QThread>
+#include <QMutex>
+#include <QList>
+#include <QMap>
+
+#include "mythtimer.h"
+
+class ProgramInfo;
+class DeleteManager;
+
+class DeleteManagerThread : public QThread
+{
+    Q_OBJECT
+  public:
+    DeleteManagerThread(DeleteManager *p) : m_parent(p) {}
+    virtual ~DeleteManagerThread() { wait(); m_parent = NULL; }
+    virtual void run(void);
+  private:
+    DeleteManager *m_parent;
+};
+
+/// Files waiting to be deleted on one filesystem, see DeleteManager
+class DeletePendingInfo
+{
+  public:
+    DeletePendingInfo() :
+        files(0), bytes(0), sleepTime(0), writers(0), writeLatency(-1) {}
+
+    QString   path;         ///< directory of the oldest pending file
+    int       files;
+    long long bytes;
+    int       sleepTime;    ///< ms between truncation steps
+    uint      writers;      ///< open ThreadedFileWriters on the device
+    int       writeLatency; ///< ms, -1 if nothing is recording there
+};
+
+class DeleteManager
+{
+    friend class DeleteManagerThread;
+  public:
+    DeleteManager(void);
+   ~DeleteManager();
+
+    void AddFile(int fd, const QString &filename, off_t size,
+                 const ProgramInfo *pginfo = NULL);
+
+    void GetPending(QList<DeletePendingInfo> &list) const;
+
+  protected:
+    void RunDeletes(void);
+
+  private:
+    class DeleteEntry
+    {
+      public:
+        int          fd;
+        QString      filename;
+        off_t        size;
+        off_t        increment;
+        bool         punchHole;
+        uint         steps;
+        ProgramInfo *pginfo;
+    };
+
+    class DeleteDevice
+    {
+      public:
+        DeleteDevice() : bytes(0), sleepTime(0) {}
+
+        QList<DeleteEntry*> files;
+        long long           bytes;
+        int                 sleepTime;
+        MythTimer           lastStep;
+    };
+
+    bool TruncateStep(DeleteEntry *entry);
+    void FinishEntry(DeleteEntry *entry);
+    void UpdateSleepTime(dev_t device, DeleteDevice &dev);
+    static off_t CalcIncrement(void);
+
+    mutable QMutex              lock;
+    QWaitCondition              wakeup;
+    QMap<dev_t, DeleteDevice>   devices;    // protected by lock
+    bool                        running;    // protected by lock
+    DeleteManagerThread        *thread;
+
+    /// Time between truncation steps with the device to ourselves
+    static const int kMinSleepTime;
+    /// Time between truncation steps while something is recording
+    static const int kBaseSleepTime;
+    /// Longest we back off when recordings are struggling
+    static const int kMaxSleepTime;
+};
+
+#endif
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
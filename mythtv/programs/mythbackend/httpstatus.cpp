@@ -39,6 +39,7 @@
 #include "exitcodes.h"
 #include "jobqueue.h"
 #include "upnp.h"
+#include "backendcontext.h"
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -56,6 +57,7 @@ HttpStatus::HttpStatus( QMap<int, EncoderLink *> *tvList, Scheduler *sched,
     m_nPreRollSeconds = gCoreContext->GetNumSetting("RecordPreRoll", 0);
 
     m_pMainServer = NULL;
+    m_pHttpServer = NULL;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -418,6 +420,41 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
 
     jobqueue.setAttribute( "count", jobs.size() );
 
+    // Add this backend's slot occupancy and queue wait times
+
+    if (::jobqueue)
+    {
+        JobQueueSlotStatus slotStatus;
+        ::jobqueue->GetSlotStatus(slotStatus);
+
+        QDomElement slotsNode = pDoc->createElement("Slots");
+        jobqueue.appendChild(slotsNode);
+
+        slotsNode.setAttribute("hostname"   , gCoreContext->GetHostName());
+        slotsNode.setAttribute("jobsRunning", slotStatus.jobsRunning);
+        slotsNode.setAttribute("maxJobs"    , slotStatus.maxJobs    );
+        slotsNode.setAttribute("cpuUsed"    , slotStatus.cpuUsed    );
+        slotsNode.setAttribute("cpuSlots"   , slotStatus.cpuSlots   );
+        slotsNode.setAttribute("ioUsed"     , slotStatus.ioUsed     );
+        slotsNode.setAttribute("ioSlots"    , slotStatus.ioSlots    );
+
+        QMap<int, JobQueueWaitStats>::const_iterator wit =
+            slotStatus.waitStats.begin();
+        for (; wit != slotStatus.waitStats.end(); ++wit)
+        {
+            QDomElement wait = pDoc->createElement("Wait");
+            slotsNode.appendChild(wait);
+
+            int nStarted = ((*wit).started > 0) ? (*wit).started : 1;
+
+            wait.setAttribute("type"    , wit.key()          );
+            wait.setAttribute("started" , (*wit).started     );
+            wait.setAttribute("avgWait" , (int)((*wit).totalWait / nStarted));
+            wait.setAttribute("maxWait" , (*wit).maxWait     );
+            wait.setAttribute("lastWait", (*wit).lastWait    );
+        }
+    }
+
     // Add Machine information
 
     QDomElement mInfo   = pDoc->createElement("MachineInfo");
@@ -513,6 +550,29 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
             storage.appendChild(fsXML[fs_index]);
     }
 
+    // deletes still being truncated on this backend
+
+    if (m_pMainServer && m_pMainServer->GetDeleteManager())
+    {
+        QList<DeletePendingInfo> pending;
+        m_pMainServer->GetDeleteManager()->GetPending(pending);
+
+        QList<DeletePendingInfo>::const_iterator pit = pending.begin();
+        for (; pit != pending.end(); ++pit)
+        {
+            QDomElement del = pDoc->createElement("PendingDelete");
+
+            del.setAttribute("dir"     , (*pit).path          );
+            del.setAttribute("files"   , (*pit).files         );
+            del.setAttribute("size"    , (int)((*pit).bytes>>20));
+            del.setAttribute("interval", (*pit).sleepTime     );
+            del.setAttribute("writers" , (*pit).writers       );
+            del.setAttribute("latency" , (*pit).writeLatency  );
+
+            storage.appendChild(del);
+        }
+    }
+
     // load average ---------------------
 
     double rgdAverages[3];
@@ -563,6 +623,41 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         pDoc->createTextNode(gCoreContext->GetSetting("DataDirectMessage"));
     guide.appendChild(dataDirectMessage);
 
+    // Add HTTP server connection & latency information
+
+    if (m_pHttpServer)
+    {
+        HttpServerStats stats = m_pHttpServer->GetStatistics();
+
+        QDomElement http = pDoc->createElement("HttpServer");
+        root.appendChild(http);
+
+        http.setAttribute("activeConnections", stats.m_nActiveConnections);
+        http.setAttribute("idleConnections"  , stats.m_nIdleConnections  );
+        http.setAttribute("streamConnections", stats.m_nStreamConnections);
+        http.setAttribute("dispatched"       , stats.m_nDispatched       );
+        http.setAttribute("queueWaitAvg"     , stats.m_nDispatched ?
+            (double)stats.m_nQueueWaitTotalMS / stats.m_nDispatched : 0.0);
+        http.setAttribute("queueWaitMax"     , stats.m_nQueueWaitMaxMS   );
+        http.setAttribute("encoded"          , stats.m_nEncoded          );
+        http.setAttribute("encodeBytesIn"    , stats.m_nEncodeBytesIn    );
+        http.setAttribute("encodeBytesOut"   , stats.m_nEncodeBytesOut   );
+        http.setAttribute("encodeTime"       , stats.m_nEncodeTotalMS    );
+
+        HttpEndpointStatsMap::const_iterator it = stats.m_endpoints.begin();
+        for (; it != stats.m_endpoints.end(); ++it)
+        {
+            QDomElement endpoint = pDoc->createElement("Endpoint");
+            http.appendChild(endpoint);
+
+            endpoint.setAttribute("path"    , it.key()           );
+            endpoint.setAttribute("requests", (*it).m_nRequests  );
+            endpoint.setAttribute("avg"     , (*it).m_nRequests ?
+                (double)(*it).m_nTotalMS / (*it).m_nRequests : 0.0);
+            endpoint.setAttribute("max"     , (*it).m_nMaxMS     );
+        }
+    }
+
     // Add Miscellaneous information
 
     QString info_script = gCoreContext->GetSetting("MiscStatusScript");
@@ -703,6 +798,13 @@ void HttpStatus::PrintStatus( QTextStream &os, QDomDocument *pDoc )
     if (!node.isNull())
         PrintMiscellaneousInfo( os, node.toElement());
 
+    // HTTP server information -----------------
+
+    node = docElem.namedItem( "HttpServer" );
+
+    if (!node.isNull())
+        PrintHttpServer( os, node.toElement());
+
     os << "\r\n</div>\r\n</body>\r\n</html>\r\n";
 
 }
@@ -1073,6 +1175,51 @@ int HttpStatus::PrintJobQueue( QTextStream &os, QDomElement jobs )
     os << "  <div class=\"content\">\r\n"
        << "    <h2 class=\"status\">Job Queue</h2>\r\n";
 
+    QDomElement slotsElem = jobs.namedItem( "Slots" ).toElement();
+
+    if (!slotsElem.isNull())
+    {
+        int nCPUSlots = slotsElem.attribute( "cpuSlots", "0" ).toInt();
+        int nIOSlots  = slotsElem.attribute( "ioSlots" , "0" ).toInt();
+
+        os << "    " << slotsElem.attribute( "hostname" ) << " is running "
+           << slotsElem.attribute( "jobsRunning", "0" ) << " of "
+           << slotsElem.attribute( "maxJobs", "0" ) << " jobs, using "
+           << slotsElem.attribute( "cpuUsed", "0" ) << " CPU slot(s)";
+
+        if (nCPUSlots > 0)
+            os << " of " << nCPUSlots;
+
+        os << " and " << slotsElem.attribute( "ioUsed", "0" ) << " I/O slot(s)";
+
+        if (nIOSlots > 0)
+            os << " of " << nIOSlots;
+
+        os << ".<br />\r\n";
+
+        QDomNode waitNode = slotsElem.firstChild();
+
+        while (!waitNode.isNull())
+        {
+            QDomElement w = waitNode.toElement();
+
+            if (!w.isNull() && w.tagName() == "Wait")
+            {
+                os << "    " << JobQueue::JobText(
+                                    w.attribute( "type", "0" ).toInt())
+                   << ": " << w.attribute( "started", "0" )
+                   << " started, average wait "
+                   << w.attribute( "avgWait", "0" ) << "s, longest "
+                   << w.attribute( "maxWait", "0" ) << "s, last "
+                   << w.attribute( "lastWait", "0" ) << "s.<br />\r\n";
+            }
+
+            waitNode = waitNode.nextSibling();
+        }
+
+        os << "    <br />\r\n";
+    }
+
     if (nNumJobs != 0)
     {
         QString statusColor;
@@ -1180,6 +1327,21 @@ int HttpStatus::PrintJobQueue( QTextStream &os, QDomElement jobs )
 
                     if ( nStatus != JOB_QUEUED)
                         os << "Host: " << sHostname << "<br />";
+                    else
+                    {
+                        QDateTime insertTime = QDateTime::fromString(
+                            e.attribute( "insertTime", "" ), Qt::ISODate );
+
+                        if (schedRunTime > insertTime)
+                            insertTime = schedRunTime;
+
+                        int nWait = insertTime.secsTo(
+                                        QDateTime::currentDateTime());
+
+                        if (nWait > 0)
+                            os << "Waiting: " << (nWait / 60) << " min "
+                               << (nWait % 60) << " sec<br />";
+                    }
 
                     if (!sComment.isEmpty())
                         os << "<br />Comments:<br />" << sComment << "<br />";
@@ -1384,6 +1546,44 @@ int HttpStatus::PrintMachineInfo( QTextStream &os, QDomElement info )
 
     os << "      </ul>\r\n";
 
+    // Pending deletes ---------------------
+
+    node = storage.namedItem( "PendingDelete" );
+
+    if (!node.isNull())
+    {
+        os << "      Pending Deletes:<br />\r\n";
+        os << "      <ul>\r\n";
+
+        QLocale c(QLocale::C);
+
+        while (!node.isNull())
+        {
+            QDomElement d = node.toElement();
+
+            if (!d.isNull() && d.tagName() == "PendingDelete")
+            {
+                int nWriters = d.attribute( "writers", "0" ).toInt();
+
+                os << "        <li>" << d.attribute( "dir", "" ) << ": "
+                   << d.attribute( "files", "0" ) << " file(s), "
+                   << c.toString(d.attribute( "size", "0" ).toInt())
+                   << " MB left, truncating every "
+                   << d.attribute( "interval", "0" ) << " ms";
+
+                if (nWriters > 0)
+                    os << " (" << nWriters << " recording(s), write latency "
+                       << d.attribute( "latency", "0" ) << " ms)";
+
+                os << "</li>\r\n";
+            }
+
+            node = node.nextSibling();
+        }
+
+        os << "      </ul>\r\n";
+    }
+
     // Guide Info ---------------------
 
     node = info.namedItem( "Guide" );
@@ -1503,6 +1703,67 @@ int HttpStatus::PrintMiscellaneousInfo( QTextStream &os, QDomElement info )
     return( 1 );
 }
 
+int HttpStatus::PrintHttpServer( QTextStream &os, QDomElement info )
+{
+    if (info.isNull())
+        return( 0 );
+
+    os << "<div class=\"content\">\r\n"
+       << "    <h2 class=\"status\">HTTP Server</h2>\r\n"
+       << "    Connections: "
+       << info.attribute("activeConnections", "0") << " open, "
+       << info.attribute("idleConnections"  , "0") << " idle, "
+       << info.attribute("streamConnections", "0") << " streaming.<br />\r\n"
+       << "    Worker queue wait: "
+       << QString::number(info.attribute("queueWaitAvg", "0").toDouble(),
+                          'f', 1)
+       << " ms average, "
+       << info.attribute("queueWaitMax", "0") << " ms max over "
+       << info.attribute("dispatched", "0") << " connections.<br />\r\n";
+
+    if (info.attribute("encoded", "0").toULongLong() > 0)
+    {
+        os << "    Compressed responses: "
+           << info.attribute("encoded", "0") << ", "
+           << info.attribute("encodeBytesIn", "0").toULongLong() / 1024
+           << " KB sent as "
+           << info.attribute("encodeBytesOut", "0").toULongLong() / 1024
+           << " KB in " << info.attribute("encodeTime", "0")
+           << " ms.<br />\r\n";
+    }
+
+    QDomNodeList nodes = info.elementsByTagName("Endpoint");
+
+    if (nodes.count() > 0)
+    {
+        os << "    <table summary=\"HTTP Endpoints\">\r\n"
+           << "      <tr><th>Path</th><th>Requests</th>"
+           << "<th>Avg (ms)</th><th>Max (ms)</th></tr>\r\n";
+
+        for (int i = 0; i < nodes.count(); i++)
+        {
+            QDomElement e = nodes.item(i).toElement();
+
+            if (e.isNull())
+                continue;
+
+            os << "      <tr><td>"
+               << HTTPRequest::Encode(e.attribute("path", ""))
+               << "</td><td>" << e.attribute("requests", "0")
+               << "</td><td>"
+               << QString::number(e.attribute("avg", "0").toDouble(), 'f', 1)
+               << "</td><td>" << e.attribute("max", "0")
+               << "</td></tr>\r\n";
+        }
+
+        os << "    </table>\r\n";
+    }
+
+    os << "</div>\r\n";
+
+    return( 1 );
+}
+
 void HttpStatus::FillProgramInfo(QDomDocument *pDoc,
                                  QDomNode     &node,
                                  ProgramInfo  *pInfo,
@@ -47,6 +47,7 @@ class HttpStatus : public HttpServerExtension
         QMap<int, EncoderLink *>    *m_pEncoders;
         AutoExpire                  *m_pExpirer;
         MainServer                  *m_pMainServer;
+        HttpServer                  *m_pHttpServer;
         bool                         m_bIsMaster;
         int                          m_nPreRollSeconds;
         QMutex                       m_settingLock;
@@ -68,6 +69,7 @@ class HttpStatus : public HttpServerExtension
         int     PrintJobQueue     ( QTextStream &os, QDomElement jobs );
         int     PrintMachineInfo  ( QTextStream &os, QDomElement info );
         int     PrintMiscellaneousInfo ( QTextStream &os, QDomElement info );
+        int     PrintHttpServer   ( QTextStream &os, QDomElement info );
 
         void    FillProgramInfo   ( QDomDocument *pDoc,
                                     QDomNode     &node,
@@ -87,6 +89,8 @@ class HttpStatus : public HttpServerExtension
 
         void     SetMainServer(MainServer *mainServer)
                     { m_pMainServer = mainServer; }
+        void     SetHttpServer(HttpServer *httpServer)
+                    { m_pHttpServer = httpServer; }
 
         virtual QStringList GetBasePaths();
         
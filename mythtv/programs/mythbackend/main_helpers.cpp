@@ -565,6 +565,7 @@ int run_backend(MythBackendCommandLineParser &cmdline)
         LOG(VB_GENERAL, LOG_INFO, "Main::Registering HttpStatus Extension");
 
         httpStatus = new HttpStatus( &tvList, sched, expirer, ismaster );
+        httpStatus->SetHttpServer( pHS );
         pHS->RegisterExtension( httpStatus );
     }
 
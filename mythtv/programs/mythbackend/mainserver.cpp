@@ -117,7 +117,6 @@ int delete_file_immediately(const QString &filename,
 
 };
 
-QMutex MainServer::truncate_and_close_lock;
 const uint MainServer::kMasterServerReconnectTimeout = 1000; //ms
 
 class ProcessRequestThread : public QThread
@@ -183,7 +182,8 @@ MainServer::MainServer(bool master, int port,
     encoderList(tvList), mythserver(NULL), masterServerReconnect(NULL),
     masterServer(NULL), ismaster(master), masterBackendOverride(false),
     m_sched(sched), m_expirer(expirer), deferredDeleteTimer(NULL),
-    autoexpireUpdateTimer(NULL), m_exitCode(GENERIC_EXIT_OK)
+    autoexpireUpdateTimer(NULL), deleteManager(new DeleteManager()),
+    m_exitCode(GENERIC_EXIT_OK)
 {
     PreviewGeneratorQueue::CreatePreviewGeneratorQueue(
         PreviewGenerator::kLocalAndRemote, ~0, 0);
@@ -255,6 +255,9 @@ MainServer::~MainServer()
         mythserver->deleteLater();
         mythserver = NULL;
     }
+
+    delete deleteManager;
+    deleteManager = NULL;
 }
 
 void MainServer::autoexpireUpdate(void)
@@ -1939,7 +1942,7 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     deletelock.unlock();
 
     if (slowDeletes && fd >= 0)
-        TruncateAndClose(&pginfo, fd, ds->m_filename, size);
+        deleteManager->AddFile(fd, ds->m_filename, size, &pginfo);
 }
 
 void MainServer::DeleteRecordedFiles(DeleteStruct *ds)
@@ -2077,7 +2080,7 @@ void MainServer::DoDeleteInDB(DeleteStruct *ds)
 /**
  *  \brief Deletes links and unlinks the main file and returns the descriptor.
  *
- *  This is meant to be used with TruncateAndClose() to slowly shrink a
+ *  This is meant to be used with DeleteManager::AddFile() to slowly shrink a
  *  large file and then eventually delete the file by closing the file
  *  descriptor.
  *
@@ -2161,83 +2164,6 @@ int MainServer::OpenAndUnlink(const QString &filename)
     return fd;
 }
 
-/**
- *  \brief Repeatedly truncate an open file in small increments.
- *
- *   When the file is small enough this closes the file and returns.
- *
- *   NOTE: This acquires a lock so that only one instance of TruncateAndClose()
- *         is running at a time.
- */
-bool MainServer::TruncateAndClose(ProgramInfo *pginfo, int fd,
-                                  const QString &filename, off_t fsize)
-{
-    QMutexLocker locker(&truncate_and_close_lock);
-
-    if (pginfo)
-    {
-        pginfo->SetPathname(filename);
-        pginfo->MarkAsInUse(true, kTruncatingDeleteInUseID);
-    }
-
-    int cards = 5;
-
-    MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare("SELECT COUNT(cardid) FROM capturecard;");
-    if (query.exec() && query.isActive() && query.size() && query.next())
-        cards = query.value(0).toInt();
-
-    // Time between truncation steps in milliseconds
-    const size_t sleep_time = 500;
-    const size_t min_tps    = 8 * 1024 * 1024;
-    const size_t calc_tps   = (size_t) (cards * 1.2 * (22200000LL / 8));
-    const size_t tps = max(min_tps, calc_tps);
-    const size_t increment  = (size_t) (tps * (sleep_time * 0.001f));
-
-    LOG(VB_FILE, LOG_INFO,
-        QString("Truncating '%1' by %2 MB every %3 milliseconds")
-            .arg(filename)
-            .arg(increment / (1024.0 * 1024.0), 0, 'f', 2)
-            .arg(sleep_time));
-
-    int count = 0;
-    while (fsize > 0)
-    {
-#if 0
-        LOG(VB_FILE, LOG_DEBUG, QString("Truncating '%1' to %2 MB")
-                .arg(filename).arg(fsize / (1024.0 * 1024.0), 0, 'f', 2));
-#endif
-
-        int err = ftruncate(fd, fsize);
-        if (err)
-        {
-            LOG(VB_GENERAL, LOG_ERR, QString("Error truncating '%1'")
-                    .arg(filename) + ENO);
-            if (pginfo)
-                pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
-            return 0 == close(fd);
-        }
-
-        fsize -= increment;
-
-        if (pginfo && ((count % 100) == 0))
-            pginfo->UpdateInUseMark(true);
-
-        count++;
-
-        usleep(sleep_time * 1000);
-    }
-
-    bool ok = (0 == close(fd));
-
-    if (pginfo)
-        pginfo->MarkAsInUse(false, kTruncatingDeleteInUseID);
-
-    LOG(VB_FILE, LOG_INFO, QString("Finished truncating '%1'").arg(filename));
-
-    return ok;
-}
-
 void MainServer::finishVideoScan(bool changed)
 {
     if (changed)
@@ -4466,31 +4392,6 @@ void MainServer::GetFilesystemInfos(QList<FileSystemInfo> &fsInfos)
     }
 }
 
-void TruncateThread::run(void)
-{
-    if (!m_ms)
-        return;
-
-    threadRegister("Truncate");
-    m_ms->DoTruncateThread(this);
-    threadDeregister();
-}
-
-void MainServer::DoTruncateThread(DeleteStruct *ds)
-{
-    if (gCoreContext->GetNumSetting("TruncateDeletesSlowly", 0)) 
-    {
-        QThreadPool::globalInstance()->releaseThread();
-        TruncateAndClose(NULL, ds->m_fd, ds->m_filename, ds->m_size);
-        QThreadPool::globalInstance()->reserveThread();
-    }
-    else
-    {
-        QMutexLocker dl(&deletelock);
-        close(ds->m_fd);
-    }
-}
-
 bool MainServer::HandleDeleteFile(QStringList &slist, PlaybackSock *pbs)
 {
     return HandleDeleteFile(slist[1], slist[2], pbs);
@@ -4535,7 +4436,7 @@ bool MainServer::HandleDeleteFile(QString filename, QString storagegroup,
     off_t size = 0;
 
     // This will open the file and unlink the dir entry.  The actual file
-    // data will be deleted in the truncate thread spawned below.
+    // data will be deleted by the DeleteManager or when we close it below.
     // Since stat fails after unlinking on some filesystems, get the size first
     const QFileInfo info(fullfile);
     size = info.size();
@@ -4562,10 +4463,15 @@ bool MainServer::HandleDeleteFile(QString filename, QString storagegroup,
     // DeleteFile() opened up a file for us to delete
     if (fd >= 0)
     {
-        // Thread off the actual file truncate
-        TruncateThread *truncateThread = 
-            new TruncateThread(this, fullfile, fd, size);
-        truncateThread->run();
+        if (gCoreContext->GetNumSetting("TruncateDeletesSlowly", 0))
+        {
+            deleteManager->AddFile(fd, fullfile, size);
+        }
+        else
+        {
+            QMutexLocker dl(&deletelock);
+            close(fd);
+        }
     }
 
     return true;
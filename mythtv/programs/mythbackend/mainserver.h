@@ -22,6 +22,7 @@ using namespace std;
 #include "mythsocket.h"
 #include "mythdeque.h"
 #include "mythdownloadmanager.h"
+#include "deletemanager.h"
 
 #ifdef DeleteFile
 #undef DeleteFile
@@ -46,9 +47,6 @@ class DeleteStruct
                  m_recendts(recendts),
                  m_forceMetadataDelete(forceMetadataDelete)  {}
 
-    DeleteStruct(MainServer *ms, QString filename, int fd, off_t size) : 
-             m_ms(ms), m_filename(filename), m_fd(fd), m_size(size)  {}
-
   protected:
     MainServer *m_ms;
     QString     m_filename;
@@ -57,8 +55,6 @@ class DeleteStruct
     QDateTime   m_recstartts;
     QDateTime   m_recendts;
     bool        m_forceMetadataDelete;
-    int         m_fd;
-    off_t       m_size;
 };
 
 class DeleteThread : public QRunnable, public DeleteStruct
@@ -73,21 +69,11 @@ class DeleteThread : public QRunnable, public DeleteStruct
     void run(void);
 };
 
-class TruncateThread : public QRunnable, public DeleteStruct
-{
-  public:
-    TruncateThread(MainServer *ms, QString filename, int fd, off_t size) :
-                DeleteStruct(ms, filename, fd, size)  {}
-    void start(void) { QThreadPool::globalInstance()->start(this); }
-    void run(void);
-};
-
 class MainServer : public QObject, public MythSocketCBs
 {
     Q_OBJECT
 
     friend class DeleteThread;
-    friend class TruncateThread;
   public:
     MainServer(bool master, int port,
                QMap<int, EncoderLink *> *tvList,
@@ -226,7 +212,6 @@ class MainServer : public QObject, public MythSocketCBs
 
     int GetfsID(QList<FileSystemInfo>::iterator fsInfo);
 
-    void DoTruncateThread(DeleteStruct *ds);
     void DoDeleteThread(DeleteStruct *ds);
     void DeleteRecordedFiles(DeleteStruct *ds);
     void DoDeleteInDB(DeleteStruct *ds);
@@ -242,9 +227,8 @@ class MainServer : public QObject, public MythSocketCBs
     static int  DeleteFile(const QString &filename, bool followLinks,
                            bool deleteBrokenSymlinks = false);
     static int  OpenAndUnlink(const QString &filename);
-    static bool TruncateAndClose(ProgramInfo *pginfo,
-                                 int fd, const QString &filename,
-                                 off_t fsize);
+
+    DeleteManager *GetDeleteManager(void) { return deleteManager; }
 
     vector<LiveTVChain*> liveTVChains;
     QMutex liveTVChainsLock;
@@ -284,7 +268,8 @@ class MainServer : public QObject, public MythSocketCBs
     MythDeque<DeferredDeleteStruct> deferredDeleteList;
 
     QTimer *autoexpireUpdateTimer; // audited ref #5318
-    static QMutex truncate_and_close_lock;
+
+    DeleteManager *deleteManager;
 
     QMap<QString, int> fsIDcache;
     QMutex fsIDcacheLock;
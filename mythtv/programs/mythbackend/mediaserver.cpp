@@ -12,6 +12,8 @@
 #include "httpconfig.h"
 #include "internetContent.h"
 #include "mythdirs.h"
+#include "mythcorecontext.h"
+#include "mythevent.h"
 
 #include "upnpcdstv.h"
 #include "upnpcdsmusic.h"
@@ -232,11 +234,9 @@ void MediaServer::Init(bool bIsMaster, bool bDisableUPnp /* = FALSE */)
             RegisterExtension(new UPnpCDSVideo());
         }
 
-#if 0
         LOG(VB_UPNP, LOG_INFO, "MediaServer::Adding Context Listener");
 
         gCoreContext->addListener( this );
-#endif
 
         Start();
 
@@ -253,9 +253,7 @@ MediaServer::~MediaServer()
 {
     // -=>TODO: Need to check to see if calling this more than once is ok.
 
-#if 0
     gCoreContext->removeListener(this);
-#endif
 
     delete m_pHttpServer;
 }
@@ -263,7 +261,6 @@ MediaServer::~MediaServer()
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
-#if 0
 void MediaServer::customEvent( QEvent *e )
 {
     if (MythEvent::Type(e->type()) == MythEvent::MythEventMessage)
@@ -271,10 +268,18 @@ void MediaServer::customEvent( QEvent *e )
         MythEvent *me = (MythEvent *)e;
         QString message = me->Message();
 
-        //-=>TODO: Need to handle events to notify clients of changes
+        // Anything that changes what our CDS extensions would return
+        // bumps the SystemUpdateID, which also flushes the CDS caches.
+
+        if (m_pUPnpCDS &&
+            (message.startsWith("RECORDING_LIST_CHANGE") ||
+             message == "VIDEO_LIST_CHANGE"))
+        {
+            m_pUPnpCDS->IncrementSystemUpdateID();
+        }
     }
 }
-#endif
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
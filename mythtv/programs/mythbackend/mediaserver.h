@@ -11,6 +11,7 @@
 #ifndef __MEDIASERVER_H__
 #define __MEDIASERVER_H__
 
+#include <QObject>
 #include <QString>
 
 #include "upnp.h"
@@ -26,8 +27,9 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-class MediaServer : public UPnp
+class MediaServer : public QObject, public UPnp
 {
+    Q_OBJECT
 
     protected:
 
@@ -45,6 +47,10 @@ class MediaServer : public UPnp
         void     RegisterExtension  ( UPnpCDSExtension    *pExtension );
         void     UnregisterExtension( UPnpCDSExtension    *pExtension );
 
+    protected:
+
+        virtual void customEvent( QEvent *e );
+
 };
 
 #endif
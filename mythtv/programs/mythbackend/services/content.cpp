@@ -23,6 +23,9 @@
 
 #include <QDir>
 #include <QImage>
+#include <QMutex>
+#include <QSet>
+#include <QWaitCondition>
 #include <math.h>
 
 #include <compat.h>
@@ -425,18 +428,42 @@ QFileInfo Content::GetPreviewImage(        int        nChanId,
         if (!pginfo.IsLocal())
             return QFileInfo();
 
-        PreviewGenerator *previewgen = new PreviewGenerator( &pginfo, 
-                                                             QString(), 
-                                                             PreviewGenerator::kLocal);
-        previewgen->SetPreviewTimeAsSeconds( nSecsIn          );
-        previewgen->SetOutputFilename      ( sPreviewFileName );
+        // ------------------------------------------------------------------
+        // Only one request generates a given image, any others asking for
+        // it at the same time wait for that one to finish.
+        // ------------------------------------------------------------------
 
-        bool ok = previewgen->Run();
+        static QMutex         s_previewLock;
+        static QWaitCondition s_previewDone;
+        static QSet<QString>  s_previewsRunning;
 
-        previewgen->deleteLater();
+        QMutexLocker locker( &s_previewLock );
 
-        if (!ok)
-            return QFileInfo();
+        while (s_previewsRunning.contains( sPreviewFileName ))
+            s_previewDone.wait( &s_previewLock );
+
+        if (!QFile::exists( sPreviewFileName ))
+        {
+            s_previewsRunning.insert( sPreviewFileName );
+            locker.unlock();
+
+            PreviewGenerator *previewgen = new PreviewGenerator( &pginfo, 
+                                                                 QString(), 
+                                                                 PreviewGenerator::kLocal);
+            previewgen->SetPreviewTimeAsSeconds( nSecsIn          );
+            previewgen->SetOutputFilename      ( sPreviewFileName );
+
+            bool ok = previewgen->Run();
+
+            previewgen->deleteLater();
+
+            locker.relock();
+            s_previewsRunning.remove( sPreviewFileName );
+            s_previewDone.wakeAll();
+
+            if (!ok)
+                return QFileInfo();
+        }
     }
 
     float fAspect = 0.0;
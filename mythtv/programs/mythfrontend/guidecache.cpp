@@ -0,0 +1,267 @@
+// -*- Mode: c++ -*-
+// vim:set sw=4 ts=4 expandtab:
+
+#include <QThreadPool>
+#include <QRunnable>
+
+#include "guidecache.h"
+#include "mythdbcon.h"
+#include "mythlogging.h"
+
+#define LOC QString("GuideCache: ")
+
+const uint GuideCache::kBlockSecs = 6 * 60 * 60;
+const int  GuideCache::kMaxBlocks = 4096;
+
+class GuideCacheLoader : public QRunnable
+{
+  public:
+    GuideCacheLoader(GuideCache &c) : m_cache(c) {}
+
+    void run(void)
+    {
+        threadRegister("GuideCacheLoader");
+        m_cache.RunPrefetch();
+        threadDeregister();
+    }
+
+    GuideCache &m_cache;
+};
+
+/// Drops the seconds, like the program queries always did.
+static QDateTime to_minute(const QDateTime &t)
+{
+    return QDateTime(t.date(), QTime(t.time().hour(), t.time().minute()));
+}
+
+GuideCache::GuideCache(void) :
+    m_generation(0), m_loaderRunning(false),
+    m_hits(0), m_misses(0), m_prefetched(0)
+{
+}
+
+GuideCache::~GuideCache()
+{
+    QMutexLocker locker(&m_lock);
+
+    m_pending.clear();
+    while (m_loaderRunning)
+        m_loaderWait.wait(&m_lock);
+
+    LOG(VB_GUI, LOG_INFO, LOC +
+        QString("%1 blocks served from cache, %2 loaded on demand, "
+                "%3 prefetched").arg(m_hits).arg(m_misses).arg(m_prefetched));
+
+    locker.unlock();
+    Clear();
+}
+
+/** \fn GuideCache::SetScheduleList(const ProgramList&)
+ *  \brief Takes a copy of the schedule used to set the recording status
+ *         of loaded programs, and drops everything loaded with the old one.
+ */
+void GuideCache::SetScheduleList(const ProgramList &schedList)
+{
+    QWriteLocker schedLocker(&m_schedLock);
+    m_schedList.clear();
+    ProgramList::const_iterator it = schedList.begin();
+    for (; it != schedList.end(); ++it)
+        m_schedList.push_back(new ProgramInfo(**it));
+    schedLocker.unlock();
+
+    Clear();
+}
+
+/// \brief Drops all cached listings and any prefetch not yet started.
+void GuideCache::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+
+    m_generation++;
+    m_pending.clear();
+
+    QMap<BlockKey,ProgramList*>::iterator it = m_blocks.begin();
+    for (; it != m_blocks.end(); ++it)
+        delete *it;
+    m_blocks.clear();
+    m_blockOrder.clear();
+}
+
+/** \fn GuideCache::GetPrograms(uint, const QDateTime&, const QDateTime&)
+ *  \brief Returns the programs on chanid overlapping start to end.
+ *
+ *   The list is the same as a program table query for the window, and
+ *   is owned by the caller. Blocks not in the cache are loaded first.
+ */
+ProgramList *GuideCache::GetPrograms(uint chanid, const QDateTime &start,
+                                     const QDateTime &end)
+{
+    QDateTime startts = to_minute(start);
+    QDateTime endts   = to_minute(end);
+
+    QList<BlockKey> keys;
+    AddBlocks(keys, chanid, startts, endts);
+
+    ProgramList *proglist = new ProgramList();
+    QDateTime lastStart;
+
+    QMutexLocker locker(&m_lock);
+
+    QList<BlockKey>::const_iterator kit = keys.begin();
+    for (; kit != keys.end(); ++kit)
+    {
+        ProgramList *list = m_blocks.value(*kit);
+        ProgramList *uncached = NULL;
+        if (list)
+        {
+            m_hits++;
+        }
+        else
+        {
+            m_misses++;
+            uint generation = m_generation;
+            locker.unlock();
+            list = new ProgramList();
+            LoadBlock(*kit, *list);
+            locker.relock();
+
+            // Blocks loaded with a schedule that changed meanwhile
+            // are used for this window only, never cached.
+            if (generation != m_generation || m_blocks.contains(*kit))
+                uncached = list;
+            else
+                InsertBlock(*kit, list);
+        }
+
+        // A program crossing a block boundary is in both blocks, the
+        // lists are sorted by start time so later copies are skipped.
+        ProgramList::const_iterator it = list->begin();
+        for (; it != list->end(); ++it)
+        {
+            const ProgramInfo *pginfo = *it;
+            if (lastStart.isValid() &&
+                pginfo->GetScheduledStartTime() <= lastStart)
+                continue;
+            if (pginfo->GetScheduledEndTime() < startts ||
+                pginfo->GetScheduledStartTime() > endts)
+                continue;
+
+            proglist->push_back(new ProgramInfo(*pginfo));
+            lastStart = pginfo->GetScheduledStartTime();
+        }
+
+        delete uncached;
+    }
+
+    return proglist;
+}
+
+/** \fn GuideCache::Prefetch(const vector<uint>&, const QDateTime&, const QDateTime&)
+ *  \brief Loads the listings of chanids from start to end in the
+ *         background, after any earlier prefetch still pending.
+ */
+void GuideCache::Prefetch(const vector<uint> &chanids, const QDateTime &start,
+                          const QDateTime &end)
+{
+    QList<BlockKey> keys;
+    vector<uint>::const_iterator it = chanids.begin();
+    for (; it != chanids.end(); ++it)
+        AddBlocks(keys, *it, to_minute(start), to_minute(end));
+
+    QMutexLocker locker(&m_lock);
+
+    QList<BlockKey>::const_iterator kit = keys.begin();
+    for (; kit != keys.end(); ++kit)
+    {
+        if (!m_blocks.contains(*kit) && !m_pending.contains(*kit))
+            m_pending.push_back(*kit);
+    }
+
+    if (!m_pending.empty() && !m_loaderRunning)
+    {
+        m_loaderRunning = true;
+        QThreadPool::globalInstance()->start(new GuideCacheLoader(*this));
+    }
+}
+
+/// \brief Drops the prefetches not yet started, e.g. after paging on.
+void GuideCache::ClearPrefetch(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_pending.clear();
+}
+
+void GuideCache::GetStats(uint &hits, uint &misses) const
+{
+    QMutexLocker locker(&m_lock);
+    hits   = m_hits;
+    misses = m_misses;
+}
+
+void GuideCache::AddBlocks(QList<BlockKey> &keys, uint chanid,
+                           const QDateTime &start, const QDateTime &end) const
+{
+    uint first = start.toTime_t() / kBlockSecs * kBlockSecs;
+    uint last  = end.toTime_t()   / kBlockSecs * kBlockSecs;
+    for (uint block = first; block <= last; block += kBlockSecs)
+        keys.push_back(BlockKey(chanid, block));
+}
+
+void GuideCache::LoadBlock(const BlockKey &key, ProgramList &list)
+{
+    QDateTime startts = QDateTime::fromTime_t(key.second);
+    QDateTime endts   = QDateTime::fromTime_t(key.second + kBlockSecs);
+
+    MSqlBindings bindings;
+    QString querystr = "WHERE program.chanid = :CHANID "
+                       "  AND program.endtime >= :STARTTS "
+                       "  AND program.starttime <= :ENDTS "
+                       "  AND program.manualid = 0 ";
+    bindings[":CHANID"]  = key.first;
+    bindings[":STARTTS"] = startts.toString("yyyy-MM-ddThh:mm:00");
+    bindings[":ENDTS"]   = endts.toString("yyyy-MM-ddThh:mm:00");
+
+    QReadLocker schedLocker(&m_schedLock);
+    LoadFromProgram(list, querystr, bindings, m_schedList, false);
+}
+
+/// \note Must be called with m_lock held.
+void GuideCache::InsertBlock(const BlockKey &key, ProgramList *list)
+{
+    m_blocks[key] = list;
+    m_blockOrder.push_back(key);
+
+    while (m_blockOrder.size() > kMaxBlocks)
+        delete m_blocks.take(m_blockOrder.takeFirst());
+}
+
+void GuideCache::RunPrefetch(void)
+{
+    QMutexLocker locker(&m_lock);
+
+    while (!m_pending.empty())
+    {
+        BlockKey key = m_pending.takeFirst();
+        if (m_blocks.contains(key))
+            continue;
+
+        uint generation = m_generation;
+        locker.unlock();
+        ProgramList *list = new ProgramList();
+        LoadBlock(key, *list);
+        locker.relock();
+
+        if (generation == m_generation && !m_blocks.contains(key))
+        {
+            InsertBlock(key, list);
+            m_prefetched++;
+        }
+        else
+        {
+            delete list;
+        }
+    }
+
+    m_loaderRunning = false;
+    m_loaderWait.wakeAll();
+}
@@ -0,0 +1,85 @@
+// -*- Mode: c++ -*-
+// vim:set sw=4 ts=4 expandtab:
+#ifndef _GUIDE_CACHE_H_
+#define _GUIDE_CACHE_H_
+
+// C++ headers
+#include <vector>
+using namespace std;
+
+// Qt headers
+#include <QReadWriteLock>
+#include <QWaitCondition>
+#include <QDateTime>
+#include <QMutex>
+#include <QList>
+#include <QPair>
+#include <QMap>
+
+// MythTV headers
+#include "programinfo.h"
+
+class GuideCacheLoader;
+
+/** \class GuideCache
+ *  \brief Client side cache of the program guide for GuideGrid.
+ *
+ *   Listings are kept per channel in fixed blocks of kBlockSecs, so
+ *   scrolling the grid by half an hour or paging through the channels
+ *   is served from memory instead of a program table query per row.
+ *   Blocks next to the visible page can be loaded ahead of time on a
+ *   worker thread with Prefetch().
+ *
+ *   Recording status of the cached programs comes from the schedule
+ *   list passed to SetScheduleList(), which drops the whole cache.
+ */
+class GuideCache
+{
+    friend class GuideCacheLoader;
+  public:
+    GuideCache(void);
+    ~GuideCache();
+
+    void SetScheduleList(const ProgramList &schedList);
+    void Clear(void);
+
+    ProgramList *GetPrograms(uint chanid, const QDateTime &start,
+                             const QDateTime &end);
+    void Prefetch(const vector<uint> &chanids, const QDateTime &start,
+                  const QDateTime &end);
+    void ClearPrefetch(void);
+
+    void GetStats(uint &hits, uint &misses) const;
+
+  private:
+    typedef QPair<uint,uint> BlockKey; ///< chanid, block start (time_t)
+
+    void AddBlocks(QList<BlockKey> &keys, uint chanid,
+                   const QDateTime &start, const QDateTime &end) const;
+    void LoadBlock(const BlockKey &key, ProgramList &list);
+    void InsertBlock(const BlockKey &key, ProgramList *list);
+    void RunPrefetch(void);
+
+  private:
+    mutable QMutex              m_lock;
+    QMap<BlockKey,ProgramList*> m_blocks;      // protected by m_lock
+    QList<BlockKey>             m_blockOrder;  // protected by m_lock
+    QList<BlockKey>             m_pending;     // protected by m_lock
+    uint                        m_generation;  // protected by m_lock
+    bool                        m_loaderRunning; // protected by m_lock
+    QWaitCondition              m_loaderWait;
+
+    uint                        m_hits;        // protected by m_lock
+    uint                        m_misses;      // protected by m_lock
+    uint                        m_prefetched;  // protected by m_lock
+
+    QReadWriteLock              m_schedLock;
+    ProgramList                 m_schedList;   // protected by m_schedLock
+
+    /// Length of the listings of one channel kept as a unit
+    static const uint kBlockSecs;
+    /// Most channel blocks kept before the oldest are dropped
+    static const int  kMaxBlocks;
+};
+
+#endif // _GUIDE_CACHE_H_
@@ -17,6 +17,7 @@ using namespace std;
 #include "mythcorecontext.h"
 #include "mythdbcon.h"
 #include "mythlogging.h"
+#include "mythtimer.h"
 #include "dbchannelinfo.h"
 #include "programinfo.h"
 #include "recordingrule.h"
@@ -31,6 +32,7 @@ using namespace std;
 #include "mythuiguidegrid.h"
 #include "mythdialogbox.h"
 #include "progfind.h"
+#include "guidecache.h"
 
 QWaitCondition epgIsVisibleCond;
 
@@ -223,6 +225,8 @@ GuideGrid::GuideGrid(MythScreenStack *parent,
                      bool allowFinder, int changrpid)
          : ScheduleCommon(parent, "guidegrid"),
     m_allowFinder(allowFinder),
+    m_guideCache(new GuideCache()),
+    m_pageFills(0), m_pageFillTime(0),
     m_player(player),
     m_usingNullVideo(false), m_embedVideo(embedVideo),
     m_previewVideoRefreshTimer(new QTimer(this)),
@@ -313,7 +317,7 @@ bool GuideGrid::Create()
 
 void GuideGrid::Load(void)
 {
-    LoadFromScheduler(m_recList);
+    updateRecList();
     fillChannelInfos();
 
     int maxchannel = max((int)GetChannelCount() - 1, 0);
@@ -374,6 +378,15 @@ GuideGrid::~GuideGrid()
         m_programs.pop_back();
     }
 
+    if (m_pageFills)
+    {
+        LOG(VB_GUI, LOG_INFO, LOC +
+            QString("Filled %1 guide pages, %2 ms per page on average")
+                .arg(m_pageFills).arg(m_pageFillTime / m_pageFills));
+    }
+    delete m_guideCache;
+    m_guideCache = NULL;
+
     m_channelInfos.clear();
 
     if (m_updateTimer)
@@ -1022,33 +1035,90 @@ void GuideGrid::fillTimeInfos()
 
 void GuideGrid::fillProgramInfos(bool useExistingData)
 {
+    MythTimer timer;
+    timer.start();
+
     m_guideGrid->ResetData();
 
     for (int y = 0; y < m_channelCount; ++y)
     {
         fillProgramRowInfos(y, useExistingData);
     }
+
+    int elapsed = timer.elapsed();
+    m_pageFills++;
+    m_pageFillTime += elapsed;
+
+    if (VERBOSE_LEVEL_CHECK(VB_GUI) && logLevel <= LOG_DEBUG)
+    {
+        uint hits, misses;
+        m_guideCache->GetStats(hits, misses);
+        LOG(VB_GUI, LOG_DEBUG, LOC +
+            QString("Filled guide page in %1 ms (%2 cache hits, %3 misses "
+                    "so far)").arg(elapsed).arg(hits).arg(misses));
+    }
+
+    prefetchProgramInfos();
 }
 
-ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
+/** \fn GuideGrid::prefetchProgramInfos(void)
+ *  \brief Has the guide cache load the pages around the one shown, so
+ *         that scrolling or paging to them does not wait on the database.
+ *
+ *   The channel pages above and below come first, then the visible
+ *   channels a page earlier and later, then the next and previous day.
+ */
+void GuideGrid::prefetchProgramInfos(void)
 {
-    ProgramList *proglist = new ProgramList();
+    int chancnt = GetChannelCount();
+    if (!chancnt || !m_channelCount)
+        return;
 
-    if (proglist)
+    vector<uint> visible, adjacent;
+    for (int y = -m_channelCount; y < 2 * m_channelCount; ++y)
     {
-        MSqlBindings bindings;
-        QString querystr = "WHERE program.chanid = :CHANID "
-                           "  AND program.endtime >= :STARTTS "
-                           "  AND program.starttime <= :ENDTS "
-                           "  AND program.manualid = 0 ";
-        bindings[":CHANID"]  = GetChannelInfo(chanNum)->chanid;
-        bindings[":STARTTS"] = m_currentStartTime.toString("yyyy-MM-ddThh:mm:00");
-        bindings[":ENDTS"] = m_currentEndTime.toString("yyyy-MM-ddThh:mm:00");
+        int chanNum = (y + (int)m_currentStartChannel) % chancnt;
+        if (chanNum < 0)
+            chanNum += chancnt;
+
+        PixmapChannel *chinfo = GetChannelInfo(chanNum);
+        if (!chinfo)
+            continue;
 
-        LoadFromProgram(*proglist, querystr, bindings, m_recList, false);
+        if (y >= 0 && y < m_channelCount)
+            visible.push_back(chinfo->chanid);
+        else
+            adjacent.push_back(chinfo->chanid);
     }
 
-    return proglist;
+    int pageSecs = m_currentStartTime.secsTo(m_currentEndTime);
+
+    vector<uint> chanids = adjacent;
+    chanids.insert(chanids.end(), visible.begin(), visible.end());
+
+    m_guideCache->ClearPrefetch();
+    m_guideCache->Prefetch(chanids, m_currentStartTime.addSecs(-pageSecs),
+                           m_currentEndTime.addSecs(pageSecs));
+    m_guideCache->Prefetch(visible, m_currentStartTime.addDays(1),
+                           m_currentEndTime.addDays(1));
+    m_guideCache->Prefetch(visible, m_currentStartTime.addDays(-1),
+                           m_currentEndTime.addDays(-1));
+}
+
+/** \fn GuideGrid::updateRecList(void)
+ *  \brief Reloads the schedule and drops guide data that has the
+ *         recording status of the old one.
+ */
+void GuideGrid::updateRecList(void)
+{
+    LoadFromScheduler(m_recList);
+    m_guideCache->SetScheduleList(m_recList);
+}
+
+ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
+{
+    return m_guideCache->GetPrograms(GetChannelInfo(chanNum)->chanid,
+                                     m_currentStartTime, m_currentEndTime);
 }
 
 void GuideGrid::fillProgramRowInfos(unsigned int row, bool useExistingData)
@@ -1319,7 +1389,7 @@ void GuideGrid::customEvent(QEvent *event)
 
         if (message == "SCHEDULE_CHANGE")
         {
-            LoadFromScheduler(m_recList);
+            updateRecList();
             fillProgramInfos();
             updateInfo();
         }
@@ -1615,7 +1685,7 @@ void GuideGrid::generateListings()
     maxchannel = max((int)GetChannelCount() - 1, 0);
     m_channelCount = min(m_guideGrid->getChannelCount(), maxchannel + 1);
 
-    LoadFromScheduler(m_recList);
+    updateRecList();
     fillProgramInfos();
 }
 
@@ -1997,7 +2067,7 @@ void GuideGrid::quickRecord()
     ri.ToggleRecord();
     *pginfo = ri;
 
-    LoadFromScheduler(m_recList);
+    updateRecList();
     fillProgramInfos();
     updateInfo();
 }
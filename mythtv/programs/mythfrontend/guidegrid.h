@@ -23,6 +23,7 @@ using namespace std;
 using namespace std;
 
 class ProgramInfo;
+class GuideCache;
 class TV;
 class QTimer;
 class MythUIButtonList;
@@ -169,6 +170,8 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
     void fillProgramInfos(bool useExistingData = false);
     void fillProgramRowInfos(unsigned int row, bool useExistingData = false);
     ProgramList *getProgramListFromProgram(int chanNum);
+    void prefetchProgramInfos(void);
+    void updateRecList(void);
 
     void setStartChannel(int newStartChannel);
 
@@ -191,6 +194,9 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
     vector<ProgramList*> m_programs;
     ProgramInfo *m_programInfos[MAX_DISPLAY_CHANS][MAX_DISPLAY_TIMES];
     ProgramList  m_recList;
+    GuideCache  *m_guideCache;
+    uint         m_pageFills;
+    uint         m_pageFillTime; ///< ms spent in fillProgramInfos
 
     QDateTime m_originalStartTime;
     QDateTime m_currentStartTime;
@@ -127,6 +127,9 @@ ProgLister::ProgLister(
 
 ProgLister::~ProgLister()
 {
+    // the list must not ask us for items once we are gone
+    if (m_progList)
+        m_progList->Reset();
     m_itemList.clear();
     gCoreContext->removeListener(this);
 }
@@ -1522,35 +1525,8 @@ void ProgLister::UpdateDisplay(const ProgramInfo *selected, int selectedOffset)
 
 void ProgLister::UpdateButtonList(void)
 {
-    ProgramList::const_iterator it = m_itemList.begin();
-    for (; it != m_itemList.end(); ++it)
-    {
-        MythUIButtonListItem *item =
-            new MythUIButtonListItem(
-                m_progList, "", qVariantFromValue(*it));
-
-        InfoMap infoMap;
-        (**it).ToMap(infoMap);
-
-        QString state = toUIState((**it).GetRecordingStatus());
-        if ((state == "warning") && (plPreviouslyRecorded == m_type))
-            state = "disabled";
-
-        item->SetTextFromMap(infoMap, state);
-
-        if (m_type == plTitle)
-        {
-            QString tempSubTitle = (**it).GetSubtitle();
-            if (tempSubTitle.trimmed().isEmpty())
-                tempSubTitle = (**it).GetTitle();
-            item->SetText(tempSubTitle, "titlesubtitle", state);
-        }
-
-        item->DisplayState(
-            QString::number((**it).GetStars(10)), "ratingstate");
-
-        item->DisplayState(state, "status");
-    }
+    // Items are only filled in as they are shown, see FillItem()
+    m_progList->SetProvider(this, m_itemList.size());
 
     if (m_positionText)
     {
@@ -1562,6 +1538,36 @@ void ProgLister::UpdateButtonList(void)
     }
 }
 
+void ProgLister::FillItem(MythUIButtonListItem *item, int pos)
+{
+    ProgramInfo *pginfo = m_itemList[pos];
+    if (!pginfo)
+        return;
+
+    item->SetData(qVariantFromValue(pginfo));
+
+    InfoMap infoMap;
+    pginfo->ToMap(infoMap);
+
+    QString state = toUIState(pginfo->GetRecordingStatus());
+    if ((state == "warning") && (plPreviouslyRecorded == m_type))
+        state = "disabled";
+
+    item->SetTextFromMap(infoMap, state);
+
+    if (m_type == plTitle)
+    {
+        QString tempSubTitle = pginfo->GetSubtitle();
+        if (tempSubTitle.trimmed().isEmpty())
+            tempSubTitle = pginfo->GetTitle();
+        item->SetText(tempSubTitle, "titlesubtitle", state);
+    }
+
+    item->DisplayState(QString::number(pginfo->GetStars(10)), "ratingstate");
+
+    item->DisplayState(state, "status");
+}
+
 void ProgLister::HandleSelected(MythUIButtonListItem *item)
 {
     if (!item)
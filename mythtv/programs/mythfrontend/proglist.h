@@ -8,6 +8,7 @@
 // MythTV headers
 #include "programinfo.h" // for ProgramList
 #include "schedulecommon.h"
+#include "mythuibuttonlist.h"
 #include "proglist_helpers.h"
 
 enum ProgListType {
@@ -28,7 +29,7 @@ enum ProgListType {
     plPreviouslyRecorded
 };
 
-class ProgLister : public ScheduleCommon
+class ProgLister : public ScheduleCommon, public MythUIButtonListProvider
 {
     friend class PhrasePopup;
     friend class TimePopup;
@@ -79,6 +80,7 @@ class ProgLister : public ScheduleCommon
     void UpdateDisplay(void);
     void UpdateDisplay(const ProgramInfo *selected, int selectedOffset);
     void UpdateButtonList(void);
+    virtual void FillItem(MythUIButtonListItem *item, int pos);
     void UpdateKeywordInDB(const QString &text, const QString &oldValue);
 
     virtual void ShowMenu(void); // MythScreenType
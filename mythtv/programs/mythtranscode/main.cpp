@@ -21,6 +21,7 @@ using namespace std;
 #include "util.h"
 #include "transcode.h"
 #include "mpeg2fix.h"
+#include "streamcopy.h"
 #include "remotefile.h"
 #include "mythtranslation.h"
 #include "mythlogging.h"
@@ -501,6 +502,39 @@ int main(int argc, char *argv[])
     }
 
     int exitcode = GENERIC_EXIT_OK;
+    if (result == REENCODE_STREAMCOPY)
+    {
+        void (*update_func)(float) = NULL;
+        int (*check_func)() = NULL;
+        if (useCutlist && !found_infile)
+            pginfo->QueryCutList(deleteMap);
+        if (jobID >= 0)
+        {
+           glbl_jobID = jobID;
+           update_func = &UpdateJobQueue;
+           check_func = &CheckJobQueue;
+        }
+
+        // cuts are placed using the keyframe index of the input
+        frm_pos_map_t keyMap;
+        pginfo->QueryPositionMap(keyMap, MARK_GOP_BYFRAME);
+
+        StreamCopy *copier = new StreamCopy(
+            infile, outfile, &deleteMap, showprogress,
+            update_func, check_func);
+
+        // the keyframe index of the output is built while copying
+        result = copier->Start(keyMap, posMap);
+        if (result == REENCODE_OK)
+        {
+            if (update_index)
+                UpdatePositionMap(posMap, NULL, pginfo);
+            else
+                UpdatePositionMap(posMap, outfile + QString(".map"), pginfo);
+        }
+        delete copier;
+    }
+
     if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
     {
         void (*update_func)(float) = NULL;
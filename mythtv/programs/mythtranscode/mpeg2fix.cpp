@@ -423,10 +423,11 @@ int MPEG2fixup::FindMPEG2Header(uint8_t *buf, int size, uint8_t code)
     return 0;
 }
 
-//fill_buffers will signal the main thread to start decoding again as soon
-//as it runs out of buffers.  It will then wait for the buffer to completely
-//fill before returning.  In this way, the 2 threads are never running
-// concurrently
+//fill_buffers is called by the multiplexer with rx.mutex held.  If any of
+//the streams has run dry it will wake the main thread and wait for it to
+//add more frames.  The main thread adds frames while the multiplexer is
+//writing out packs, so demuxing and fixing up the next frames overlaps
+//with multiplexing the previous ones.
 static int fill_buffers(void *r, int finish)
 {
     MPEG2replex *rx = (MPEG2replex *)r;
@@ -439,7 +440,8 @@ static int fill_buffers(void *r, int finish)
 
 MPEG2replex::MPEG2replex() :
     done(0),      otype(0),
-    ext_count(0), mplex(0)
+    ext_count(0), lock_taken(0),
+    mplex(0)
 {
     memset(&vrbuf, 0, sizeof(vrbuf));
     memset(extrbuf, 0, sizeof(extrbuf));
@@ -469,7 +471,6 @@ MPEG2replex::~MPEG2replex()
 
 int MPEG2replex::WaitBuffers()
 {
-    pthread_mutex_lock( &mutex );
     while (1)
     {
         int i, ok = 1;
@@ -487,17 +488,28 @@ int MPEG2replex::WaitBuffers()
         pthread_cond_signal(&cond);
         pthread_cond_wait(&cond, &mutex);
     }
-    pthread_mutex_unlock(&mutex);
 
     if (done)
     {
         finish_mpg(mplex);
+        pthread_mutex_unlock(&mutex);
         pthread_exit(NULL);
     }
 
     return 0;
 }
 
+//Locks rx.mutex from the main thread.  The multiplexer holds the mutex
+//while it works and only gives it up between packs when someone is
+//waiting for it.  The main thread signals cond before it unlocks again.
+void MPEG2replex::Lock()
+{
+    lock_wanted.ref();
+    pthread_mutex_lock(&mutex);
+    lock_taken++;
+    lock_wanted.deref();
+}
+
 void *MPEG2fixup::ReplexStart(void *data)
 {
     threadRegister("MPEG2Replex");
@@ -532,11 +544,10 @@ void MPEG2replex::Start()
 
     fd_out = open(outfile, O_WRONLY | O_CREAT | O_TRUNC | O_LARGEFILE, 0644);
 
-    //await buffer fill
+    //await buffer fill, the rings are only touched with the mutex held
     pthread_mutex_lock(&mutex);
     pthread_cond_signal(&cond);
     pthread_cond_wait(&cond, &mutex);
-    pthread_mutex_unlock(&mutex);
 
     mplex = &mx;
 
@@ -549,6 +560,13 @@ void MPEG2replex::Start()
     {
         check_times( &mx, &video_ok, ext_ok, &start);
         write_out_packs( &mx, video_ok, ext_ok);
+
+        //wake the main thread if it is waiting for room in the rings,
+        //and sleep until it is done if it is waiting to add a frame
+        pthread_cond_signal(&cond);
+        int taken = lock_taken;
+        while (lock_wanted && (lock_taken == taken))
+            pthread_cond_wait(&cond, &mutex);
     }
 }
 
@@ -659,7 +677,7 @@ int MPEG2fixup::AddFrame(MPEG2frame *f)
     iu.active = 1;
     iu.length = f->pkt.size;
     iu.pts = f->pkt.pts * 300;
-    pthread_mutex_lock( &rx.mutex );
+    rx.Lock();
 
     FrameInfo(f);
     while (ring_free(rb) < (unsigned int)f->pkt.size ||
@@ -688,6 +706,7 @@ int MPEG2fixup::AddFrame(MPEG2frame *f)
         }
         if (! ok)
         {
+            pthread_cond_signal(&rx.cond);
             pthread_mutex_unlock( &rx.mutex );
             //deadlock
             VERBOSE(MPF_IMPORTANT,
@@ -696,24 +715,32 @@ int MPEG2fixup::AddFrame(MPEG2frame *f)
             return 1;
         }
 
+        //the multiplexer hands the mutex back after each pack it writes
+        rx.lock_wanted.ref();
         pthread_cond_signal(&rx.cond);
         pthread_cond_wait(&rx.cond, &rx.mutex);
+        rx.lock_taken++;
+        rx.lock_wanted.deref();
 
         FrameInfo(f);
     }
 
     if (ring_write(rb, f->pkt.data, f->pkt.size)<0){
+        pthread_cond_signal(&rx.cond);
         pthread_mutex_unlock( &rx.mutex );
         VERBOSE(MPF_IMPORTANT,
                 QString("Ring buffer overflow %1\n").arg(rb->size));
         return 1;
     }
     if (ring_write(rbi, (uint8_t *)&iu, sizeof(index_unit))<0){
+        pthread_cond_signal(&rx.cond);
         pthread_mutex_unlock( &rx.mutex );
         VERBOSE(MPF_IMPORTANT,
                 QString("Ring buffer overflow %1\n").arg(rbi->size));
         return 1;
     }
+    //the multiplexer may be waiting for this stream
+    pthread_cond_signal(&rx.cond);
     pthread_mutex_unlock(&rx.mutex);
     last_written_pos = f->pkt.pos;
     return 0;
@@ -2433,8 +2460,8 @@ int MPEG2fixup::Start()
             break;
     }
 
+    rx.Lock();
     rx.done = 1;
-    pthread_mutex_lock( &rx.mutex );
     pthread_cond_signal(&rx.cond);
     pthread_mutex_unlock( &rx.mutex );
     pthread_join(thread, NULL);
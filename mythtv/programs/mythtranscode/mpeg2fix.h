@@ -24,6 +24,7 @@ extern "C"
 }
 
 //Qt
+#include <QAtomicInt>
 #include <QMap>
 #include <QStringList>
 #include <QDateTime>
@@ -120,6 +121,7 @@ class MPEG2replex
     ~MPEG2replex();
     void Start();
     int WaitBuffers();
+    void Lock();
     int done;
     QString outfile;
     int otype;
@@ -133,6 +135,8 @@ class MPEG2replex
 
     pthread_mutex_t mutex;
     pthread_cond_t cond;
+    QAtomicInt lock_wanted; ///< main thread is waiting for mutex
+    int lock_taken;         ///< times the main thread got mutex, under mutex
     audio_frame_t extframe[N_AUDIO];
     sequence_t seq_head;
 
@@ -0,0 +1,471 @@
+// C
+#include <cstdlib>
+#include <cstdio>
+
+// Qt
+#include <QFileInfo>
+
+// MythTV
+#include "streamcopy.h"
+#include "exitcodes.h"
+#include "mythlogging.h"
+
+#define LOC QString("StreamCopy: ")
+
+/// How far a keyframe's packet may be from the position in the recorder's
+/// keyframe index, which may point at the PAT/PMT sent just before it.
+static const int64_t kKeyframeSlack = 188 * 32;
+
+StreamCopy::StreamCopy(const QString &inf, const QString &outf,
+                       frm_dir_map_t *deleteMap, bool showprog,
+                       void (*update_func)(float), int (*check_func)()) :
+    infile(inf),                outfile(outf),
+    showprogress(showprog),     update_status(update_func),
+    check_abort(check_func),    status_update_time(5),
+    inputFC(NULL),              outputFC(NULL),
+    vid_id(-1)
+{
+    if (deleteMap)
+        delMap = *deleteMap;
+
+    if (update_status)
+        status_update_time = 20;
+    statustime = QDateTime::currentDateTime().addSecs(status_update_time);
+
+    av_register_all();
+}
+
+StreamCopy::~StreamCopy()
+{
+    Close();
+}
+
+/** \fn StreamCopy::Start(const frm_pos_map_t&,frm_pos_map_t&)
+ *  \brief Copies the parts of the input that are not cut to the output.
+ *
+ *  The cutlist counts frames in display order, like the keyframe index.
+ *  Keyframe packets are matched to their frame numbers through the index
+ *  by file position, since packets are read in decode order.
+ *
+ *  \param keyMap keyframe index of the input (MARK_GOP_BYFRAME), built
+ *                with an extra pass over the input if it is empty
+ *  \param posMap filled with the keyframe index of the output
+ *  \return REENCODE_OK, REENCODE_STOPPED or REENCODE_ERROR
+ */
+int StreamCopy::Start(const frm_pos_map_t &keyMap, frm_pos_map_t &posMap)
+{
+    keyFrames = keyMap;
+
+    if (!OpenInput() ||
+        (keyFrames.empty() && !delMap.empty() && !BuildKeyframeIndex()) ||
+        !OpenOutput())
+    {
+        Close();
+        return REENCODE_ERROR;
+    }
+
+    frm_pos_map_t::const_iterator kit = keyFrames.begin();
+    for (; kit != keyFrames.end(); ++kit)
+        keyPositions[*kit] = kit.key();
+
+    AVStream *vst      = inputFC->streams[vid_id];
+    int64_t   filesize = QFileInfo(infile).size();
+    int64_t   lastpos  = 0;
+    int64_t   inFrame  = 0;
+    int64_t   outFrame = 0;
+    int64_t   cutStart = 0;
+    int64_t   offset   = 0;
+    bool      cutting  = false;
+    int       result   = REENCODE_OK;
+
+    AVPacket pkt;
+    av_init_packet(&pkt);
+
+    while (av_read_frame(inputFC, &pkt) >= 0)
+    {
+        int out = (pkt.stream_index < streamMap.size()) ?
+            streamMap[pkt.stream_index] : -1;
+        AVStream *ist = inputFC->streams[pkt.stream_index];
+
+        // all cut decisions are made in the video time base
+        int64_t pts = (pkt.pts != (int64_t)AV_NOPTS_VALUE) ? pkt.pts : pkt.dts;
+        if (pts != (int64_t)AV_NOPTS_VALUE)
+            pts = av_rescale_q(pts, ist->time_base, vst->time_base);
+
+        bool drop;
+        if (pkt.stream_index == vid_id)
+        {
+            // Cuts start and end on keyframes, so every GOP that is
+            // written out starts with its keyframe.  A keyframe that
+            // isn't in the index doesn't start or end a cut.
+            int64_t keyframe = -1;
+            if ((pkt.flags & PKT_FLAG_KEY) &&
+                (pts != (int64_t)AV_NOPTS_VALUE))
+            {
+                keyframe = KeyframeNumber(pkt.pos);
+            }
+
+            if (keyframe >= 0)
+            {
+                bool cut = CutGOP(keyframe);
+                if (cut && !cutting)
+                {
+                    cutting  = true;
+                    cutStart = pts;
+                }
+                else if (!cut && cutting)
+                {
+                    cutting = false;
+                    cutPTS.push_back(qMakePair(cutStart, pts));
+
+                    VERBOSE(VB_GENERAL, LOC +
+                        QString("Removed frames up to %1").arg(keyframe));
+                }
+            }
+            inFrame++;
+
+            // Drops the leading B frames of the first GOP after a cut,
+            // those refer to the GOP before it which is gone.
+            drop = (out < 0) || cutting ||
+                   ((pts != (int64_t)AV_NOPTS_VALUE) && InCutPTS(pts));
+        }
+        else if (pts == (int64_t)AV_NOPTS_VALUE)
+        {
+            drop = (out < 0) || cutting;
+        }
+        else
+        {
+            drop = (out < 0) || (cutting && (pts >= cutStart)) ||
+                   InCutPTS(pts);
+        }
+
+        if (drop)
+        {
+            av_free_packet(&pkt);
+            continue;
+        }
+
+        // close the gaps left by the cuts
+        if (pts != (int64_t)AV_NOPTS_VALUE)
+            offset = CutOffset(pts);
+
+        AVStream *ost = outputFC->streams[out];
+        int64_t delta = av_rescale_q(offset, vst->time_base, ist->time_base);
+        if (pkt.pts != (int64_t)AV_NOPTS_VALUE)
+            pkt.pts = av_rescale_q(pkt.pts - delta,
+                                   ist->time_base, ost->time_base);
+        if (pkt.dts != (int64_t)AV_NOPTS_VALUE)
+            pkt.dts = av_rescale_q(pkt.dts - delta,
+                                   ist->time_base, ost->time_base);
+        pkt.duration = av_rescale_q(pkt.duration,
+                                    ist->time_base, ost->time_base);
+
+        if (pkt.stream_index == vid_id)
+        {
+            if (pkt.flags & PKT_FLAG_KEY)
+                posMap[outFrame] = url_ftell(outputFC->pb);
+            outFrame++;
+        }
+
+        if (pkt.pos >= 0)
+            lastpos = pkt.pos;
+        pkt.stream_index = out;
+        if (av_write_frame(outputFC, &pkt) < 0)
+        {
+            VERBOSE(VB_IMPORTANT, LOC + QString("Error writing to '%1'")
+                    .arg(outfile));
+            av_free_packet(&pkt);
+            result = REENCODE_ERROR;
+            break;
+        }
+        av_free_packet(&pkt);
+
+        if ((showprogress || update_status) &&
+            QDateTime::currentDateTime() > statustime)
+        {
+            float percent_done = (filesize > 0) ?
+                100.0 * lastpos / filesize : 0.0;
+            if (update_status)
+                update_status(percent_done);
+            if (showprogress)
+                VERBOSE(VB_IMPORTANT, QString("%1% complete")
+                        .arg(percent_done, 0, 'f', 1));
+            if (check_abort && check_abort())
+            {
+                result = REENCODE_STOPPED;
+                break;
+            }
+            statustime = QDateTime::currentDateTime();
+            statustime = statustime.addSecs(status_update_time);
+        }
+    }
+
+    if (result == REENCODE_OK)
+    {
+        av_write_trailer(outputFC);
+        VERBOSE(VB_GENERAL, LOC + QString("Copied %1 of %2 video frames")
+                .arg(outFrame).arg(inFrame));
+    }
+
+    Close();
+
+    return result;
+}
+
+bool StreamCopy::OpenInput(void)
+{
+    QByteArray fname = infile.toLocal8Bit();
+
+    int ret = av_open_input_file(&inputFC, fname.constData(), NULL, 0, NULL);
+    if (ret != 0)
+    {
+        VERBOSE(VB_IMPORTANT, LOC +
+                QString("Couldn't open input file, error #%1").arg(ret));
+        inputFC = NULL;
+        return false;
+    }
+
+    ret = av_find_stream_info(inputFC);
+    if (ret < 0)
+    {
+        VERBOSE(VB_IMPORTANT, LOC +
+                QString("Couldn't get stream info, error #%1").arg(ret));
+        return false;
+    }
+
+    for (unsigned int i = 0; i < inputFC->nb_streams; i++)
+    {
+        if ((inputFC->streams[i]->codec->codec_type == CODEC_TYPE_VIDEO) &&
+            (vid_id == -1))
+        {
+            vid_id = i;
+        }
+    }
+
+    if (vid_id == -1)
+    {
+        VERBOSE(VB_IMPORTANT, LOC + "Couldn't find a video stream");
+        return false;
+    }
+
+    return true;
+}
+
+/// \brief Sets up an MPEG-TS output with a copy of each video and audio
+///        stream of the input.
+bool StreamCopy::OpenOutput(void)
+{
+    QByteArray fname = outfile.toLocal8Bit();
+
+    AVOutputFormat *fmt = av_guess_format("mpegts", NULL, NULL);
+    if (!fmt)
+    {
+        VERBOSE(VB_IMPORTANT, LOC + "MPEG-TS muxer is not available");
+        return false;
+    }
+
+    outputFC = avformat_alloc_context();
+    if (!outputFC)
+        return false;
+
+    outputFC->oformat = fmt;
+    snprintf(outputFC->filename, sizeof(outputFC->filename), "%s",
+             fname.constData());
+
+    for (unsigned int i = 0; i < inputFC->nb_streams; i++)
+    {
+        AVStream *ist = inputFC->streams[i];
+
+        if ((ist->codec->codec_type != CODEC_TYPE_VIDEO &&
+             ist->codec->codec_type != CODEC_TYPE_AUDIO) ||
+            (ist->codec->codec_type == CODEC_TYPE_VIDEO &&
+             (int)i != vid_id) ||
+            (ist->codec->codec_type == CODEC_TYPE_AUDIO &&
+             ist->codec->channels == 0))
+        {
+            streamMap.push_back(-1);
+            continue;
+        }
+
+        AVStream *ost = av_new_stream(outputFC, ist->id);
+        if (!ost || avcodec_copy_context(ost->codec, ist->codec) < 0)
+        {
+            VERBOSE(VB_IMPORTANT, LOC +
+                    QString("Couldn't copy stream #%1").arg(i));
+            return false;
+        }
+
+        ost->stream_copy      = 1;
+        ost->time_base        = ist->time_base;
+        ost->codec->time_base = ist->codec->time_base;
+        ost->codec->codec_tag = 0;
+        ost->sample_aspect_ratio = ist->sample_aspect_ratio;
+        av_metadata_copy(&ost->metadata, ist->metadata, 0);
+
+        streamMap.push_back(outputFC->nb_streams - 1);
+    }
+
+    if (av_set_parameters(outputFC, NULL) < 0)
+    {
+        VERBOSE(VB_IMPORTANT, LOC + "Invalid output format parameters");
+        return false;
+    }
+
+    if (url_fopen(&outputFC->pb, fname.constData(), URL_WRONLY) < 0)
+    {
+        VERBOSE(VB_IMPORTANT, LOC + QString("Couldn't open output file '%1'")
+                .arg(outfile));
+        return false;
+    }
+
+    if (av_write_header(outputFC) < 0)
+    {
+        VERBOSE(VB_IMPORTANT, LOC + "Couldn't write the output header");
+        return false;
+    }
+
+    return true;
+}
+
+void StreamCopy::Close(void)
+{
+    if (outputFC)
+    {
+        if (outputFC->pb)
+            url_fclose(outputFC->pb);
+        for (unsigned int i = 0; i < outputFC->nb_streams; i++)
+        {
+            av_metadata_free(&outputFC->streams[i]->metadata);
+            av_freep(&outputFC->streams[i]->codec->extradata);
+            av_freep(&outputFC->streams[i]->codec);
+            av_freep(&outputFC->streams[i]);
+        }
+        av_free(outputFC);
+        outputFC = NULL;
+    }
+
+    if (inputFC)
+    {
+        av_close_input_file(inputFC);
+        inputFC = NULL;
+    }
+}
+
+/** \fn StreamCopy::BuildKeyframeIndex(void)
+ *  \brief Builds the keyframe index of the input when the recording has
+ *         none, numbering the video frames like the recorders do.
+ *
+ *  Reopens the input afterwards, so copying starts from the beginning.
+ */
+bool StreamCopy::BuildKeyframeIndex(void)
+{
+    VERBOSE(VB_GENERAL, LOC + "No keyframe index, scanning the input");
+
+    AVPacket pkt;
+    av_init_packet(&pkt);
+
+    int64_t frame = 0;
+    while (av_read_frame(inputFC, &pkt) >= 0)
+    {
+        if (pkt.stream_index == vid_id)
+        {
+            if ((pkt.flags & PKT_FLAG_KEY) && (pkt.pos >= 0))
+                keyFrames[frame] = pkt.pos;
+            frame++;
+        }
+        av_free_packet(&pkt);
+    }
+
+    av_close_input_file(inputFC);
+    inputFC = NULL;
+    vid_id  = -1;
+
+    return OpenInput();
+}
+
+/// \brief Returns the frame number of the keyframe whose packet starts at
+///        pos, or -1 if it isn't in the keyframe index.
+int64_t StreamCopy::KeyframeNumber(int64_t pos) const
+{
+    if (pos < 0 || keyPositions.empty())
+        return -1;
+
+    int64_t frame = -1;
+    int64_t slack = kKeyframeSlack + 1;
+
+    frm_pos_map_t::const_iterator it = keyPositions.lowerBound(pos);
+    if (it != keyPositions.end() && (int64_t)it.key() - pos < slack)
+    {
+        frame = *it;
+        slack = it.key() - pos;
+    }
+    if (it != keyPositions.begin())
+    {
+        --it;
+        if (pos - (int64_t)it.key() < slack)
+            frame = *it;
+    }
+
+    return frame;
+}
+
+/// \brief Returns true if frame is inside a cut of the delete map.
+bool StreamCopy::InCut(int64_t frame) const
+{
+    if (delMap.empty())
+        return false;
+
+    frm_dir_map_t::const_iterator it = delMap.upperBound(frame);
+    if (it == delMap.begin())
+        return *it == MARK_CUT_END;
+
+    --it;
+    return *it == MARK_CUT_START;
+}
+
+/// \brief Returns true if every frame of the GOP starting at keyframe is
+///        inside a cut.  The GOP holding the CUT_END frame is kept.
+bool StreamCopy::CutGOP(int64_t keyframe) const
+{
+    if (!InCut(keyframe))
+        return false;
+
+    // the first frame kept after this cut, if any
+    frm_dir_map_t::const_iterator mit = delMap.upperBound(keyframe);
+    if (mit == delMap.end())
+        return true;
+
+    // the last GOP of the input runs to the end of the file
+    frm_pos_map_t::const_iterator kit = keyFrames.upperBound(keyframe);
+    if (kit == keyFrames.end())
+        return false;
+
+    return kit.key() <= mit.key();
+}
+
+/// \brief Returns true if pts falls in a part of the video already cut.
+bool StreamCopy::InCutPTS(int64_t pts) const
+{
+    QList<QPair<int64_t, int64_t> >::const_iterator it = cutPTS.begin();
+    for (; it != cutPTS.end(); ++it)
+    {
+        if ((pts >= (*it).first) && (pts < (*it).second))
+            return true;
+    }
+    return false;
+}
+
+/// \brief Returns how much earlier pts is played in the output.
+int64_t StreamCopy::CutOffset(int64_t pts) const
+{
+    int64_t offset = 0;
+    QList<QPair<int64_t, int64_t> >::const_iterator it = cutPTS.begin();
+    for (; it != cutPTS.end(); ++it)
+    {
+        if ((*it).second <= pts)
+            offset += (*it).second - (*it).first;
+    }
+    return offset;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
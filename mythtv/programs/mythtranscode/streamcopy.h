@@ -0,0 +1,77 @@
+#ifndef STREAMCOPY_H_
+#define STREAMCOPY_H_
+
+// C
+#include <stdint.h>
+
+extern "C"
+{
+//AVFormat/AVCodec
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+}
+
+//Qt
+#include <QDateTime>
+#include <QString>
+#include <QList>
+#include <QPair>
+
+// MythTV
+#include "transcodedefs.h"
+#include "programtypes.h"
+
+/** \class StreamCopy
+ *  \brief Cuts a recording without decoding it, by copying the packets
+ *         of the parts that are kept into a new MPEG-TS file.
+ *
+ *   Only whole GOPs are removed, so the output never starts a GOP without
+ *   its keyframe. A GOP is kept if any of its frames is outside the cuts,
+ *   so nothing the cutlist keeps is lost. The keyframe index of the output
+ *   is built while it is written.
+ */
+class StreamCopy
+{
+  public:
+    StreamCopy(const QString &inf, const QString &outf,
+               frm_dir_map_t *deleteMap, bool showprog,
+               void (*update_func)(float) = NULL, int (*check_func)() = NULL);
+   ~StreamCopy();
+
+    int Start(const frm_pos_map_t &keyMap, frm_pos_map_t &posMap);
+
+  private:
+    bool OpenInput(void);
+    bool OpenOutput(void);
+    void Close(void);
+    bool BuildKeyframeIndex(void);
+    int64_t KeyframeNumber(int64_t pos) const;
+    bool InCut(int64_t frame) const;
+    bool CutGOP(int64_t keyframe) const;
+    bool InCutPTS(int64_t pts) const;
+    int64_t CutOffset(int64_t pts) const;
+
+    QString          infile;
+    QString          outfile;
+    frm_dir_map_t    delMap;
+    bool             showprogress;
+    void           (*update_status)(float);
+    int            (*check_abort)();
+    int              status_update_time;
+    QDateTime        statustime;
+
+    AVFormatContext *inputFC;
+    AVFormatContext *outputFC;
+    int              vid_id;
+    QList<int>       streamMap;      ///< input stream -> output stream or -1
+
+    frm_pos_map_t    keyFrames;      ///< input keyframe number -> position
+    frm_pos_map_t    keyPositions;   ///< input keyframe position -> number
+
+    /// Removed video PTS ranges, [start, end) in the input time base
+    QList<QPair<int64_t, int64_t> > cutPTS;
+};
+
+#endif
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
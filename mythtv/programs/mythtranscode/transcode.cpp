@@ -548,6 +548,15 @@ int Transcode::TranscodeFile(
             return REENCODE_MPEG2TRANS;
         }
 
+        if (encodingType.startsWith("H.264") &&
+            get_int_option(profile, "transcodelossless"))
+        {
+            VERBOSE(VB_IMPORTANT, "Switching to stream copy cutter.");
+            if (player_ctx)
+                delete player_ctx;
+            return REENCODE_STREAMCOPY;
+        }
+
         // Recorder setup
         if (get_int_option(profile, "transcodelossless"))
         {
@@ -529,12 +529,37 @@ static HostSpinBox *JobQueueCheckFrequency()
 {
     HostSpinBox *gc = new HostSpinBox("JobQueueCheckFrequency", 5, 300, 5);
     gc->setLabel(QObject::tr("Job Queue check frequency (secs)"));
-    gc->setHelpText(QObject::tr("When looking for new jobs to process, the "
-                    "Job Queue will wait this many seconds between checks."));
+    gc->setHelpText(QObject::tr("New and finished jobs are noticed right "
+                    "away. Changes made directly to the database are picked "
+                    "up by checking the Job Queue every this many seconds."));
     gc->setValue(60);
     return gc;
 };
 
+static HostSpinBox *JobQueueCPUSlots()
+{
+    HostSpinBox *gc = new HostSpinBox("JobQueueCPUSlots", 0, 32, 1);
+    gc->setLabel(QObject::tr("CPU slots on this backend"));
+    gc->setHelpText(QObject::tr("Limits how many CPU heavy jobs run at once. "
+                    "A transcode uses two slots, commercial detection and "
+                    "user jobs use one, metadata lookups use none. "
+                    "0 means no limit besides the maximum number of jobs."));
+    gc->setValue(0);
+    return gc;
+};
+
+static HostSpinBox *JobQueueIOSlots()
+{
+    HostSpinBox *gc = new HostSpinBox("JobQueueIOSlots", 0, 32, 1);
+    gc->setLabel(QObject::tr("Disk I/O slots on this backend"));
+    gc->setHelpText(QObject::tr("Limits how many jobs reading or writing "
+                    "recordings run at once. Transcodes, commercial "
+                    "detection and user jobs use one slot each. "
+                    "0 means no limit besides the maximum number of jobs."));
+    gc->setValue(0);
+    return gc;
+};
+
 static HostComboBox *JobQueueCPU()
 {
     HostComboBox *gc = new HostComboBox("JobQueueCPU");
@@ -947,6 +972,8 @@ BackendSettings::BackendSettings() {
     group5->setLabel(QObject::tr("Job Queue (Backend-Specific)"));
     group5->addChild(JobQueueMaxSimultaneousJobs());
     group5->addChild(JobQueueCheckFrequency());
+    group5->addChild(JobQueueCPUSlots());
+    group5->addChild(JobQueueIOSlots());
 
     HorizontalConfigurationGroup* group5a =
               new HorizontalConfigurationGroup(false, false);